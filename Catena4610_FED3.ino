@@ -36,6 +36,9 @@ static_assert(
 
 static const char sVersion[] = "1.3.0";
 
+// the FED3 serial link
+static constexpr std::uint32_t kFed3Baud = 115200;
+
 /****************************************************************************\
 |
 |   Variables.
@@ -67,7 +70,13 @@ Catena_Mx25v8035f gFlash;
 // the individual commmands are put in this table
 static const cCommandStream::cEntry sMyExtraCommmands[] =
         {
+        { "backlog", cmdBacklog },
+        { "bench", cmdBench },
+        { "fed3gen", cmdFed3Gen },
         { "log", cmdLog },
+        { "meas", cmdMeas },
+        { "perf", cmdPerf },
+        { "sleep", cmdSleep },
         // other commands go here....
         };
 
@@ -102,8 +111,13 @@ void setup()
 
 void setup_hardSerial(void)
     {
-    Serial1.begin(115200);
+    Serial1.begin(kFed3Baud);
     gCatena.SafePrintf("Hardware Serial begin done!\n");
+
+    if (gMeasurementLoop.enableSerialWakeup(kFed3Baud))
+        gCatena.SafePrintf("FED3 will wake us from deep sleep\n");
+    else
+        gCatena.SafePrintf("FED3 can't wake us: deep sleep disabled\n");
     }
 
 void setup_platform()
@@ -173,6 +187,7 @@ void setup_flash(void)
     if (gFlash.begin(&gSPI2, Catena::PIN_SPI2_FLASH_SS))
         {
         gMeasurementLoop.registerSecondSpi(&gSPI2);
+        gMeasurementLoop.registerFlash(&gFlash);
         gFlash.powerDown();
         gCatena.SafePrintf("FLASH found, put power down\n");
         }
@@ -184,11 +199,29 @@ void setup_flash(void)
         }
     }
 
+// settings can be changed by downlink on the control port.
+static void receiveDownlink(
+    void *pContext,
+    uint8_t uPort,
+    const uint8_t *pBuffer,
+    size_t nBuffer
+    )
+    {
+    if (uPort != cMeasurementLoop::kControlPort)
+        return;
+
+    if (gMeasurementLoop.processControlDownlink(pBuffer, nBuffer))
+        gCatena.SafePrintf("control downlink: settings changed\n");
+    else
+        gCatena.SafePrintf("control downlink: rejected (%u bytes)\n", unsigned(nBuffer));
+    }
+
 void setup_radio()
     {
     gLoRaWAN.begin(&gCatena);
     gCatena.registerObject(&gLoRaWAN);
     LMIC_setClockError(5 * MAX_CLOCK_ERROR / 100);
+    gLoRaWAN.SetReceiveBufferBufferCb(receiveDownlink);
     }
 
 void setup_measurement()
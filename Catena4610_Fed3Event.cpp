@@ -0,0 +1,297 @@
+/*
+
+Module: Catena4610_Fed3Event.cpp
+
+Function:
+    Decode and encode FED3 event records.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_Fed3Event.h"
+
+#include <cstring>
+
+using namespace McciCatena4610;
+
+constexpr std::size_t Fed3Event::kWireSize;
+constexpr std::size_t Fed3Event::kDeltaSize;
+constexpr std::size_t Fed3Event::kMaxVarintSize;
+
+static const char * const sSessionType[] =
+        {
+        "Custom_Application",
+        "ClassicFED3",
+        "ClosedEconomy_PR1",
+        "Dispenser",
+        "Extinction",
+        "FixedRatio1",
+        "FR_Customizable",
+        "FreeFeeding",
+        "MenuExample",
+        "Optogenetic_Self_Stim",
+        "Pavlovian",
+        "ProbReversalTask",
+        "ProgressiveRatio",
+        "RandomRatio"
+        };
+
+static const char * const sEventActive[] =
+        {
+        "Unknown",
+        "Left",
+        "LeftShort",
+        "LeftWithPellet",
+        "LeftinTimeout",
+        "LeftDuringDispense",
+        "Right",
+        "RightShort",
+        "RightWithPellet",
+        "RightinTimeout",
+        "RightDuringDispense",
+        "Pellet"
+        };
+
+const char *Fed3Event::getSessionTypeName(unsigned i)
+    {
+    // FED3 treats anything it doesn't know as a custom application.
+    if (i >= sizeof(sSessionType) / sizeof(sSessionType[0]))
+        i = 0;
+    return sSessionType[i];
+    }
+
+const char *Fed3Event::getEventName(unsigned i)
+    {
+    if (i >= sizeof(sEventActive) / sizeof(sEventActive[0]))
+        i = 0;
+    return sEventActive[i];
+    }
+
+std::uint32_t Fed3Event::getField(Fed3Event::Field f) const
+    {
+    switch (f)
+        {
+    case Field::TimeStamp:          return this->TimeStamp;
+    case Field::VersionMajor:       return this->VersionMajor;
+    case Field::VersionMinor:       return this->VersionMinor;
+    case Field::VersionLocal:       return this->VersionLocal;
+    case Field::DeviceNumber:       return this->DeviceNumber;
+    case Field::SessionType:        return this->SessionType;
+    case Field::Vbat:               return std::uint16_t(this->Vbat);
+    case Field::NumMotorTurns:      return this->NumMotorTurns;
+    case Field::FixedRatio:         return std::uint16_t(this->FixedRatio);
+    case Field::EventActive:        return this->EventActive;
+    case Field::EventTime:          return this->EventTime;
+    case Field::LeftCount:          return this->LeftCount;
+    case Field::RightCount:         return this->RightCount;
+    case Field::PelletCount:        return this->PelletCount;
+    case Field::BlockPelletCount:   return std::uint16_t(this->BlockPelletCount);
+    default:                        return 0;
+        }
+    }
+
+void Fed3Event::setField(Fed3Event::Field f, std::uint32_t v)
+    {
+    switch (f)
+        {
+    case Field::TimeStamp:          this->TimeStamp = v; break;
+    case Field::VersionMajor:       this->VersionMajor = std::uint8_t(v); break;
+    case Field::VersionMinor:       this->VersionMinor = std::uint8_t(v); break;
+    case Field::VersionLocal:       this->VersionLocal = std::uint8_t(v); break;
+    case Field::DeviceNumber:       this->DeviceNumber = std::uint16_t(v); break;
+    case Field::SessionType:        this->SessionType = std::uint8_t(v); break;
+    case Field::Vbat:               this->Vbat = std::int16_t(v); break;
+    case Field::NumMotorTurns:      this->NumMotorTurns = v; break;
+    case Field::FixedRatio:         this->FixedRatio = std::int16_t(v); break;
+    case Field::EventActive:        this->EventActive = std::uint8_t(v); break;
+    case Field::EventTime:          this->EventTime = std::uint16_t(v); break;
+    case Field::LeftCount:          this->LeftCount = v; break;
+    case Field::RightCount:         this->RightCount = v; break;
+    case Field::PelletCount:        this->PelletCount = v; break;
+    case Field::BlockPelletCount:   this->BlockPelletCount = std::int16_t(v); break;
+    default:                        break;
+        }
+    }
+
+bool Fed3Event::decode(const std::uint8_t *pBuffer, std::size_t nBuffer)
+    {
+    if (nBuffer < kWireSize)
+        return false;
+
+    for (auto const &l : Fed3Layout::kLayout)
+        {
+        std::uint32_t v = 0;
+
+        for (unsigned i = 0; i < l.size; ++i)
+            v = (v << 8) | pBuffer[l.offset + i];
+
+        this->setField(l.field, v);
+        }
+
+    return true;
+    }
+
+void Fed3Event::encode(std::uint8_t *pBuffer) const
+    {
+    for (auto const &l : Fed3Layout::kLayout)
+        {
+        std::uint32_t v = this->getField(l.field);
+
+        for (unsigned i = l.size; i > 0; --i)
+            {
+            pBuffer[l.offset + i - 1] = std::uint8_t(v);
+            v >>= 8;
+            }
+        }
+    }
+
+/*
+
+Name:   McciCatena4610::Fed3Event::encodeDelta()
+
+Function:
+    Encode a FED3 event as a compact delta against the previous one.
+
+Definition:
+    bool McciCatena4610::Fed3Event::encodeDelta(
+            const Fed3Event &prev,
+            std::uint8_t *pBuffer
+            ) const;
+
+Description:
+    Within a batch, consecutive events from one FED3 normally differ
+    only in time, event type and a few counts. The delta record is:
+
+        uint16  seconds since prev.TimeStamp
+        uint8   EventActive
+        uint16  EventTime
+        uint8   LeftCount - prev.LeftCount
+        uint8   RightCount - prev.RightCount
+        uint8   PelletCount - prev.PelletCount
+        uint8   NumMotorTurns - prev.NumMotorTurns
+        int8    Vbat - prev.Vbat
+        int8    BlockPelletCount - prev.BlockPelletCount
+
+    Version, device number, session type and fixed ratio must be
+    unchanged.
+
+Returns:
+    true if pBuffer was filled in, false if the full record is needed.
+
+*/
+
+bool Fed3Event::encodeDelta(const Fed3Event &prev, std::uint8_t *pBuffer) const
+    {
+    if (this->VersionMajor != prev.VersionMajor ||
+        this->VersionMinor != prev.VersionMinor ||
+        this->VersionLocal != prev.VersionLocal ||
+        this->DeviceNumber != prev.DeviceNumber ||
+        this->SessionType != prev.SessionType ||
+        this->FixedRatio != prev.FixedRatio)
+        return false;
+
+    // unsigned wraparound turns a backwards step into a huge delta.
+    std::uint32_t const dTime = this->TimeStamp - prev.TimeStamp;
+    std::uint32_t const dLeft = this->LeftCount - prev.LeftCount;
+    std::uint32_t const dRight = this->RightCount - prev.RightCount;
+    std::uint32_t const dPellet = this->PelletCount - prev.PelletCount;
+    std::uint32_t const dMotor = this->NumMotorTurns - prev.NumMotorTurns;
+    std::int32_t const dVbat = std::int32_t(this->Vbat) - prev.Vbat;
+    std::int32_t const dBlock = std::int32_t(this->BlockPelletCount) - prev.BlockPelletCount;
+
+    if (dTime > 0xFFFF || dLeft > 0xFF || dRight > 0xFF ||
+        dPellet > 0xFF || dMotor > 0xFF ||
+        dVbat < -128 || dVbat > 127 ||
+        dBlock < -128 || dBlock > 127)
+        return false;
+
+    pBuffer[0] = std::uint8_t(dTime >> 8);
+    pBuffer[1] = std::uint8_t(dTime);
+    pBuffer[2] = this->EventActive;
+    pBuffer[3] = std::uint8_t(this->EventTime >> 8);
+    pBuffer[4] = std::uint8_t(this->EventTime);
+    pBuffer[5] = std::uint8_t(dLeft);
+    pBuffer[6] = std::uint8_t(dRight);
+    pBuffer[7] = std::uint8_t(dPellet);
+    pBuffer[8] = std::uint8_t(dMotor);
+    pBuffer[9] = std::uint8_t(dVbat);
+    pBuffer[10] = std::uint8_t(dBlock);
+    return true;
+    }
+
+static std::size_t putVarint(std::uint8_t *pBuffer, std::uint32_t v)
+    {
+    std::size_t n = 0;
+
+    while (v >= 0x80)
+        {
+        pBuffer[n++] = std::uint8_t(v | 0x80);
+        v >>= 7;
+        }
+    pBuffer[n++] = std::uint8_t(v);
+    return n;
+    }
+
+/*
+
+Name:   McciCatena4610::Fed3Event::encodeVarintDelta()
+
+Function:
+    Encode a FED3 event as zig-zag varint deltas against the previous one.
+
+Definition:
+    std::size_t McciCatena4610::Fed3Event::encodeVarintDelta(
+            const Fed3Event &prev,
+            std::uint8_t *pBuffer
+            ) const;
+
+Description:
+    The record starts with a varint bit map; bit i is set if field i
+    (in Fed3Layout::kLayout[] order) differs from prev. Each field that
+    differs follows, in order, as a varint of the zig-zag encoded
+    difference. The difference is taken modulo the field's wire size,
+    so counters that wrap still encode in a byte or two.
+
+    Varints are little-endian groups of 7 bits, with the top bit set on
+    every byte but the last.
+
+    Unlike encodeDelta(), this can represent any change; a typical poke
+    takes 7 to 10 bytes.
+
+Returns:
+    Number of bytes written.
+
+*/
+
+std::size_t Fed3Event::encodeVarintDelta(const Fed3Event &prev, std::uint8_t *pBuffer) const
+    {
+    std::uint8_t deltas[kMaxVarintSize];
+    std::size_t nDeltas = 0;
+    std::uint32_t map = 0;
+
+    for (auto const &l : Fed3Layout::kLayout)
+        {
+        std::uint32_t const v = this->getField(l.field);
+        std::uint32_t const pv = prev.getField(l.field);
+
+        if (v == pv)
+            continue;
+
+        // sign-extend the difference from the field width.
+        unsigned const shift = 32 - 8 * l.size;
+        std::int32_t const d = std::int32_t((v - pv) << shift) >> shift;
+        std::uint32_t const zz = (std::uint32_t(d) << 1) ^ std::uint32_t(d >> 31);
+
+        map |= std::uint32_t(1) << unsigned(l.field);
+        nDeltas += putVarint(deltas + nDeltas, zz);
+        }
+
+    std::size_t const nMap = putVarint(pBuffer, map);
+    std::memcpy(pBuffer + nMap, deltas, nDeltas);
+    return nMap + nDeltas;
+    }
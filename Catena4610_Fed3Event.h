@@ -0,0 +1,220 @@
+/*
+
+Module: Catena4610_Fed3Event.h
+
+Function:
+    Fed3Event: a decoded FED3 event record, and its wire layout.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_Fed3Event_h_
+# define _Catena4610_Fed3Event_h_
+
+#pragma once
+
+#include "Catena4610_MessageSchema.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/****************************************************************************\
+|
+|   The FED3 wire layout
+|
+\****************************************************************************/
+
+// the fields of a FED3 event, in wire order.
+enum class Fed3Field : std::uint8_t
+    {
+    TimeStamp,          // uint32: FED3 RTC, seconds since 1970
+    VersionMajor,       // uint8
+    VersionMinor,       // uint8
+    VersionLocal,       // uint8
+    DeviceNumber,       // uint16
+    SessionType,        // uint8: index into session type names
+    Vbat,               // int16: volts * 4096
+    NumMotorTurns,      // uint32
+    FixedRatio,         // int16
+    EventActive,        // uint8: index into event names
+    EventTime,          // uint16: poke or retrieval time, 4 ms units
+    LeftCount,          // uint32
+    RightCount,         // uint32
+    PelletCount,        // uint32
+    BlockPelletCount,   // int16
+    nFields             // this must be last
+    };
+
+struct Fed3FieldLayout
+    {
+    Fed3Field       field;
+    std::uint8_t    offset;
+    std::uint8_t    size;
+    };
+
+namespace Fed3Layout {
+
+static_assert(
+    MessageSchema::kFed3FieldCount == unsigned(Fed3Field::nFields),
+    "MessageSchema::kFed3Fields doesn't match Fed3Field"
+    );
+
+// size of a field on the wire, from the message schema.
+constexpr std::uint8_t sizeOf(Fed3Field f)
+    {
+    return MessageSchema::sizeOf(MessageSchema::kFed3Fields[unsigned(f)].type);
+    }
+
+constexpr std::uint8_t offsetOf(Fed3Field f)
+    {
+    return unsigned(f) == 0
+        ? 0
+        : std::uint8_t(offsetOf(Fed3Field(unsigned(f) - 1)) + sizeOf(Fed3Field(unsigned(f) - 1)));
+    }
+
+constexpr Fed3FieldLayout layoutOf(Fed3Field f)
+    {
+    return Fed3FieldLayout { f, offsetOf(f), sizeOf(f) };
+    }
+
+constexpr Fed3FieldLayout kLayout[unsigned(Fed3Field::nFields)] =
+    {
+    layoutOf(Fed3Field::TimeStamp),
+    layoutOf(Fed3Field::VersionMajor),
+    layoutOf(Fed3Field::VersionMinor),
+    layoutOf(Fed3Field::VersionLocal),
+    layoutOf(Fed3Field::DeviceNumber),
+    layoutOf(Fed3Field::SessionType),
+    layoutOf(Fed3Field::Vbat),
+    layoutOf(Fed3Field::NumMotorTurns),
+    layoutOf(Fed3Field::FixedRatio),
+    layoutOf(Fed3Field::EventActive),
+    layoutOf(Fed3Field::EventTime),
+    layoutOf(Fed3Field::LeftCount),
+    layoutOf(Fed3Field::RightCount),
+    layoutOf(Fed3Field::PelletCount),
+    layoutOf(Fed3Field::BlockPelletCount),
+    };
+
+// number of bytes on the wire.
+constexpr std::size_t kWireSize =
+    offsetOf(Fed3Field::BlockPelletCount) + sizeOf(Fed3Field::BlockPelletCount);
+
+static_assert(kWireSize == 35, "FED3 record layout changed");
+static_assert(kWireSize == MessageSchema::kFed3RecordSize, "FED3 record size doesn't match the schema");
+
+} // namespace Fed3Layout
+
+/****************************************************************************\
+|
+|   The FED3 event record
+|
+\****************************************************************************/
+
+/*
+
+Type:   Fed3Event
+
+Description:
+    A FED3 frame carries one event as a fixed sequence of big-endian
+    fields. Fed3Layout::kLayout[], built from MessageSchema::kFed3Fields,
+    is the single description of that sequence; decode(), encode() and
+    the field accessors are all driven from it, so the offsets never
+    have to be written out by hand.
+
+    Frames are decoded once, when they arrive. Everything after that
+    (queueing, printing, uplink) works from the decoded record.
+
+    The record is POD, so it can be copied and cleared with memcpy()
+    and memset().
+
+*/
+
+struct Fed3Event
+    {
+    using Field = Fed3Field;
+
+    // number of bytes on the wire.
+    static constexpr std::size_t kWireSize = Fed3Layout::kWireSize;
+
+    // number of bytes in a delta record (see encodeDelta()).
+    static constexpr std::size_t kDeltaSize = 11;
+
+    // largest possible varint delta record (see encodeVarintDelta()):
+    // a 3-byte field map, then each field's zig-zag delta, which needs
+    // at most 2, 3 or 5 bytes for 1-, 2- or 4-byte fields.
+    static constexpr std::size_t kMaxVarintSize = 3 + 5 * 2 + 5 * 3 + 5 * 5;
+
+    // EventActive value for a pellet retrieval.
+    static constexpr std::uint8_t kEventPellet = 11;
+
+    //---------------------------
+    // the actual members as POD
+    //---------------------------
+    std::uint32_t   TimeStamp;
+    std::uint32_t   NumMotorTurns;
+    std::uint32_t   LeftCount;
+    std::uint32_t   RightCount;
+    std::uint32_t   PelletCount;
+    std::uint16_t   DeviceNumber;
+    std::uint16_t   EventTime;
+    std::int16_t    Vbat;
+    std::int16_t    FixedRatio;
+    std::int16_t    BlockPelletCount;
+    std::uint8_t    VersionMajor;
+    std::uint8_t    VersionMinor;
+    std::uint8_t    VersionLocal;
+    std::uint8_t    SessionType;
+    std::uint8_t    EventActive;
+
+    // get/set a field as it appears on the wire (not sign-extended).
+    std::uint32_t getField(Field f) const;
+    void setField(Field f, std::uint32_t v);
+
+    // fill in from nBuffer bytes of wire data. Returns false if the
+    // buffer is too short.
+    bool decode(const std::uint8_t *pBuffer, std::size_t nBuffer);
+
+    // write kWireSize bytes of wire data.
+    void encode(std::uint8_t *pBuffer) const;
+
+    // write kDeltaSize bytes describing this record relative to prev.
+    // Returns false (and writes nothing) if the difference can't be
+    // represented, in which case the full record must be sent.
+    bool encodeDelta(const Fed3Event &prev, std::uint8_t *pBuffer) const;
+
+    // write a varint delta record describing this record relative to
+    // prev, and return its length (at most kMaxVarintSize).
+    std::size_t encodeVarintDelta(const Fed3Event &prev, std::uint8_t *pBuffer) const;
+
+    // print the fields to the console.
+    void print() const;
+
+    bool isPellet() const
+        {
+        return this->EventActive == kEventPellet;
+        }
+
+    static const char *getSessionTypeName(unsigned i);
+    static const char *getEventName(unsigned i);
+    };
+
+// The members are ordered largest first, so the only padding is the
+// byte that rounds 35 up to a multiple of 4. Packing that away would
+// save a byte per queued event at the cost of unaligned word loads,
+// which the Cortex-M0+ can only do a byte at a time.
+static_assert(
+    sizeof(Fed3Event) <= (Fed3Event::kWireSize + 3) / 4 * 4,
+    "Fed3Event has grown padding; keep the members ordered largest first"
+    );
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_Fed3Event_h_ */
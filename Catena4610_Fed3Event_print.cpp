@@ -0,0 +1,42 @@
+/*
+
+Module: Catena4610_Fed3Event_print.cpp
+
+Function:
+    Print FED3 event records to the console.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_Fed3Event.h"
+
+#include <Catena.h>
+
+using namespace McciCatena4610;
+
+extern McciCatena::Catena gCatena;
+
+void Fed3Event::print() const
+    {
+    gCatena.SafePrintf("fed3TimeStamp: %u\n", unsigned(this->TimeStamp));
+    gCatena.SafePrintf("fed3Version: %u.%u.%u\n", this->VersionMajor, this->VersionMinor, this->VersionLocal);
+    gCatena.SafePrintf("fed3DeviceNumber: %u\n", this->DeviceNumber);
+    gCatena.SafePrintf("fed3SessionType Index: [%u] %s\n", this->SessionType, getSessionTypeName(this->SessionType));
+    gCatena.SafePrintf("fed3Vbat: %d mV\n", (int) ((this->Vbat / 4096.00) * 1000.f));
+    gCatena.SafePrintf("fed3NumMotorTurns: %u\n", unsigned(this->NumMotorTurns));
+    gCatena.SafePrintf("fed3FixedRatio: %d\n", this->FixedRatio);
+    gCatena.SafePrintf("fed3EventActive Index: [%u] %s\n", this->EventActive, getEventName(this->EventActive));
+    if (this->isPellet())
+        gCatena.SafePrintf("fed3RetrievalTime: %u ms\n", this->EventTime * 4u);
+    else
+        gCatena.SafePrintf("fed3PokeTime: %u ms\n", this->EventTime * 4u);
+    gCatena.SafePrintf("fed3LeftCount: %u\n", unsigned(this->LeftCount));
+    gCatena.SafePrintf("fed3RightCount: %u\n", unsigned(this->RightCount));
+    gCatena.SafePrintf("fed3PelletCount: %u\n", unsigned(this->PelletCount));
+    gCatena.SafePrintf("fed3BlockPelletCount: %d\n", this->BlockPelletCount);
+    }
@@ -0,0 +1,200 @@
+/*
+
+Module: Catena4610_Fed3Summary.cpp
+
+Function:
+    Accumulate and encode FED3 summary records.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_Fed3Summary.h"
+
+using namespace McciCatena4610;
+
+constexpr std::size_t Fed3Summary::kWireSize;
+
+// EventActive values: 1 through 5 are left pokes, 6 through 10 right.
+static constexpr std::uint8_t kEventLeftFirst = 1;
+static constexpr std::uint8_t kEventRightFirst = 6;
+
+// a running count that moves further than this between two events
+// is taken as a reset, not as frames lost.
+static constexpr std::uint32_t kMaxCountStep = 0xFF;
+
+static void addSaturating(std::uint16_t &total, std::uint32_t n)
+    {
+    std::uint32_t const v = total + n;
+
+    total = std::uint16_t(v > 0xFFFF ? 0xFFFF : v);
+    }
+
+// how far a running count moved, or the fallback if it can't be trusted.
+static std::uint32_t countStep(std::uint32_t now, std::uint32_t last, bool fHaveLast, bool fFallback)
+    {
+    std::uint32_t const d = now - last;
+
+    if (fHaveLast && d <= kMaxCountStep)
+        return d;
+
+    return fFallback ? 1 : 0;
+    }
+
+void Fed3Summary::begin(std::uint32_t tNow)
+    {
+    // the last event carries over, so the next window counts on from it.
+    this->tStart = tNow;
+    this->PokeTimeSum = 0;
+    this->RetrievalTimeSum = 0;
+    this->nEvents = 0;
+    this->nLeftPokes = 0;
+    this->nRightPokes = 0;
+    this->nPellets = 0;
+    this->nPokeTimes = 0;
+    this->nRetrievalTimes = 0;
+    this->PokeTimeMax = 0;
+    this->RetrievalTimeMax = 0;
+    this->VbatMin = 0x7FFF;
+    this->nSessionChanges = 0;
+    }
+
+void Fed3Summary::add(const Fed3Event &event)
+    {
+    // a different FED3 on this address starts the counts over.
+    bool const fHaveLast = this->fHaveLast && event.DeviceNumber == this->DeviceNumber;
+    std::uint8_t const type = event.EventActive;
+
+    addSaturating(
+        this->nLeftPokes,
+        countStep(
+            event.LeftCount, this->LastLeftCount, fHaveLast,
+            type >= kEventLeftFirst && type < kEventRightFirst
+            )
+        );
+    addSaturating(
+        this->nRightPokes,
+        countStep(
+            event.RightCount, this->LastRightCount, fHaveLast,
+            type >= kEventRightFirst && type < Fed3Event::kEventPellet
+            )
+        );
+    addSaturating(
+        this->nPellets,
+        countStep(event.PelletCount, this->LastPelletCount, fHaveLast, event.isPellet())
+        );
+
+    if (event.isPellet())
+        {
+        this->RetrievalTimeSum += event.EventTime;
+        addSaturating(this->nRetrievalTimes, 1);
+        if (event.EventTime > this->RetrievalTimeMax)
+            this->RetrievalTimeMax = event.EventTime;
+        }
+    else if (type >= kEventLeftFirst && type < Fed3Event::kEventPellet)
+        {
+        this->PokeTimeSum += event.EventTime;
+        addSaturating(this->nPokeTimes, 1);
+        if (event.EventTime > this->PokeTimeMax)
+            this->PokeTimeMax = event.EventTime;
+        }
+
+    if (fHaveLast && event.SessionType != this->SessionType && this->nSessionChanges != 0xFF)
+        ++this->nSessionChanges;
+
+    if (this->nEvents == 0 || event.Vbat < this->VbatMin)
+        this->VbatMin = event.Vbat;
+
+    addSaturating(this->nEvents, 1);
+
+    this->TimeStamp = event.TimeStamp;
+    this->DeviceNumber = event.DeviceNumber;
+    this->SessionType = event.SessionType;
+    this->LastLeftCount = event.LeftCount;
+    this->LastRightCount = event.RightCount;
+    this->LastPelletCount = event.PelletCount;
+    this->fHaveLast = true;
+    }
+
+void Fed3Summary::merge(const Fed3Summary &earlier)
+    {
+    if (earlier.empty())
+        return;
+
+    // the last event is this window's, if it has one.
+    if (this->empty())
+        {
+        this->TimeStamp = earlier.TimeStamp;
+        this->DeviceNumber = earlier.DeviceNumber;
+        this->SessionType = earlier.SessionType;
+        this->VbatMin = earlier.VbatMin;
+        }
+    else if (earlier.VbatMin < this->VbatMin)
+        this->VbatMin = earlier.VbatMin;
+
+    this->tStart = earlier.tStart;
+    this->PokeTimeSum += earlier.PokeTimeSum;
+    this->RetrievalTimeSum += earlier.RetrievalTimeSum;
+    addSaturating(this->nEvents, earlier.nEvents);
+    addSaturating(this->nLeftPokes, earlier.nLeftPokes);
+    addSaturating(this->nRightPokes, earlier.nRightPokes);
+    addSaturating(this->nPellets, earlier.nPellets);
+    addSaturating(this->nPokeTimes, earlier.nPokeTimes);
+    addSaturating(this->nRetrievalTimes, earlier.nRetrievalTimes);
+
+    if (earlier.PokeTimeMax > this->PokeTimeMax)
+        this->PokeTimeMax = earlier.PokeTimeMax;
+    if (earlier.RetrievalTimeMax > this->RetrievalTimeMax)
+        this->RetrievalTimeMax = earlier.RetrievalTimeMax;
+
+    std::uint32_t const nChanges = std::uint32_t(this->nSessionChanges) + earlier.nSessionChanges;
+    this->nSessionChanges = std::uint8_t(nChanges > 0xFF ? 0xFF : nChanges);
+    }
+
+std::uint32_t Fed3Summary::getField(Fed3Summary::Field f, std::uint32_t tNow) const
+    {
+    switch (f)
+        {
+    case Field::TimeStamp:          return this->TimeStamp;
+    case Field::DeviceNumber:       return this->DeviceNumber;
+    case Field::SessionType:        return this->SessionType;
+    case Field::SessionChanges:     return this->nSessionChanges;
+    case Field::WindowSec:          return (tNow - this->tStart + 500) / 1000;
+    case Field::Events:             return this->nEvents;
+    case Field::LeftPokes:          return this->nLeftPokes;
+    case Field::RightPokes:         return this->nRightPokes;
+    case Field::Pellets:            return this->nPellets;
+    case Field::PokeTimeMean:
+        return this->nPokeTimes == 0 ? 0
+                : (this->PokeTimeSum + this->nPokeTimes / 2) / this->nPokeTimes;
+    case Field::PokeTimeMax:        return this->PokeTimeMax;
+    case Field::RetrievalTimeMean:
+        return this->nRetrievalTimes == 0 ? 0
+                : (this->RetrievalTimeSum + this->nRetrievalTimes / 2) / this->nRetrievalTimes;
+    case Field::RetrievalTimeMax:   return this->RetrievalTimeMax;
+    case Field::VbatMin:            return std::uint16_t(this->VbatMin);
+    default:                        return 0;
+        }
+    }
+
+void Fed3Summary::encode(std::uint8_t *pBuffer, std::uint32_t tNow) const
+    {
+    std::size_t n = 0;
+
+    for (unsigned i = 0; i < unsigned(Field::nFields); ++i)
+        {
+        unsigned const size = MessageSchema::sizeOf(MessageSchema::kFed3SummaryFields[i].type);
+        std::uint32_t v = this->getField(Field(i), tNow);
+
+        for (unsigned j = size; j > 0; --j)
+            {
+            pBuffer[n + j - 1] = std::uint8_t(v);
+            v >>= 8;
+            }
+        n += size;
+        }
+    }
@@ -0,0 +1,136 @@
+/*
+
+Module: Catena4610_Fed3Summary.h
+
+Function:
+    Fed3Summary: running totals of one FED3's events over a window.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_Fed3Summary_h_
+# define _Catena4610_Fed3Summary_h_
+
+#pragma once
+
+#include "Catena4610_Fed3Event.h"
+#include "Catena4610_MessageSchema.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+// the fields of a summary record, in wire order.
+enum class Fed3SummaryField : std::uint8_t
+    {
+    TimeStamp,          // uint32: FED3 RTC at the last event
+    DeviceNumber,       // uint16
+    SessionType,        // uint8: at the last event
+    SessionChanges,     // uint8
+    WindowSec,          // uint32: length of the window
+    Events,             // uint16: frames received
+    LeftPokes,          // uint16
+    RightPokes,         // uint16
+    Pellets,            // uint16
+    PokeTimeMean,       // uint16: 4 ms units
+    PokeTimeMax,        // uint16: 4 ms units
+    RetrievalTimeMean,  // uint16: 4 ms units
+    RetrievalTimeMax,   // uint16: 4 ms units
+    VbatMin,            // int16: volts * 4096
+    nFields             // this must be last
+    };
+
+static_assert(
+    MessageSchema::kFed3SummaryFieldCount == unsigned(Fed3SummaryField::nFields),
+    "MessageSchema::kFed3SummaryFields doesn't match Fed3SummaryField"
+    );
+
+/*
+
+Type:   Fed3Summary
+
+Description:
+    In summary mode, each FED3's events are folded into one of these
+    as they arrive, and only the totals are sent, once per window
+    (uplink format 0x26).
+
+    Pokes and pellets are counted from the FED3's own running counts,
+    so frames lost on the bus don't go missing from the totals. When
+    there's no earlier event to count from, or the FED3's counts go
+    backwards (it was reset), the event itself is counted by type.
+    Poke and retrieval times can only come from the events received.
+
+    begin() starts a new window, but keeps the counts of the last
+    event, so the next window carries on from them. If a summary
+    isn't sent, merge() folds it into the window after.
+
+    The record is POD, so it can be copied and cleared with memcpy()
+    and memset().
+
+*/
+
+struct Fed3Summary
+    {
+    using Field = Fed3SummaryField;
+
+    // number of bytes on the wire.
+    static constexpr std::size_t kWireSize = MessageSchema::kFed3SummaryRecordSize;
+
+    //---------------------------
+    // the actual members as POD
+    //---------------------------
+    std::uint32_t   tStart;             // millis() when the window began
+    std::uint32_t   TimeStamp;
+    std::uint32_t   PokeTimeSum;
+    std::uint32_t   RetrievalTimeSum;
+    // the running counts of the last event, if fHaveLast.
+    std::uint32_t   LastLeftCount;
+    std::uint32_t   LastRightCount;
+    std::uint32_t   LastPelletCount;
+    std::uint16_t   DeviceNumber;
+    std::uint16_t   nEvents;
+    std::uint16_t   nLeftPokes;
+    std::uint16_t   nRightPokes;
+    std::uint16_t   nPellets;
+    std::uint16_t   nPokeTimes;
+    std::uint16_t   nRetrievalTimes;
+    std::uint16_t   PokeTimeMax;
+    std::uint16_t   RetrievalTimeMax;
+    std::int16_t    VbatMin;
+    std::uint8_t    SessionType;
+    std::uint8_t    nSessionChanges;
+    bool            fHaveLast;
+
+    // start a new window at tNow (millis()).
+    void begin(std::uint32_t tNow);
+
+    // count an event in this window.
+    void add(const Fed3Event &event);
+
+    // fold in an earlier window that wasn't sent.
+    void merge(const Fed3Summary &earlier);
+
+    bool empty() const
+        {
+        return this->nEvents == 0;
+        }
+
+    // get a field as it appears on the wire (not sign-extended),
+    // for a window ending at tNow (millis()).
+    std::uint32_t getField(Field f, std::uint32_t tNow) const;
+
+    // write kWireSize bytes of wire data, for a window ending at tNow.
+    void encode(std::uint8_t *pBuffer, std::uint32_t tNow) const;
+    };
+
+static_assert(Fed3Summary::kWireSize == 30, "FED3 summary record layout changed");
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_Fed3Summary_h_ */
@@ -0,0 +1,240 @@
+/*
+
+Module: Catena4610_MessageSchema.h
+
+Function:
+    The layout of uplink formats 0x24, 0x25 and 0x26, as data.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_MessageSchema_h_
+# define _Catena4610_MessageSchema_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Name:   MessageSchema
+
+Description:
+    This is the one description of what goes over the air. The firmware
+    encoder (fillTxBuffer()) and the FED3 record layout (Fed3Layout) are
+    driven from these tables, and the JavaScript decoders in extra/ are
+    generated from them by extra/catena-message-gen-decoders.cpp. Change
+    the tables, then regenerate the decoders; don't edit either by hand.
+
+    The header is plain C++, with no Arduino dependencies, so that the
+    generator can be built on a host.
+
+*/
+
+namespace MessageSchema {
+
+// how a value is represented on the wire. All are big-endian.
+enum class Type : std::uint8_t
+    {
+    Uint8,
+    Int16,          // two's complement
+    Uint16,
+    Uint32,
+    Uflt16,         // LMIC uflt16, for values in [0, 1)
+    Fed3,           // a FED3 record: kFed3Fields, in order
+    };
+
+constexpr std::uint8_t sizeOf(Type t)
+    {
+    return t == Type::Uint8  ? 1 :
+           t == Type::Int16  ? 2 :
+           t == Type::Uint16 ? 2 :
+           t == Type::Uint32 ? 4 :
+           t == Type::Uflt16 ? 2 :
+                               0;
+    }
+
+/****************************************************************************\
+|
+|   The FED3 record
+|
+\****************************************************************************/
+
+struct RecordField
+    {
+    Type            type;
+    const char      *pName;         // name in the decoders
+    };
+
+// the fields of a FED3 record, in wire order; indexed by Fed3Field.
+constexpr RecordField kFed3Fields[] =
+    {
+    { Type::Uint32, "time" },
+    { Type::Uint8,  "vMajor" },
+    { Type::Uint8,  "vMinor" },
+    { Type::Uint8,  "vPatch" },
+    { Type::Uint16, "deviceNumber" },
+    { Type::Uint8,  "sessionType" },
+    { Type::Int16,  "vbat" },
+    { Type::Uint32, "numMotorTurns" },
+    { Type::Int16,  "fixedRatio" },
+    { Type::Uint8,  "eventActive" },
+    { Type::Uint16, "eventTime" },
+    { Type::Uint32, "leftCount" },
+    { Type::Uint32, "rightCount" },
+    { Type::Uint32, "pelletCount" },
+    { Type::Int16,  "blockPelletCount" },
+    };
+
+constexpr std::size_t kFed3FieldCount = sizeof(kFed3Fields) / sizeof(kFed3Fields[0]);
+
+constexpr std::size_t fed3SizeBefore(std::size_t i)
+    {
+    return i == 0 ? 0 : fed3SizeBefore(i - 1) + sizeOf(kFed3Fields[i - 1].type);
+    }
+
+constexpr std::size_t kFed3RecordSize = fed3SizeBefore(kFed3FieldCount);
+
+/****************************************************************************\
+|
+|   The FED3 summary record
+|
+\****************************************************************************/
+
+// the fields of a FED3 summary record (format 0x26), in wire order;
+// indexed by Fed3SummaryField. Times are in 4 ms units, as in the FED3
+// record; vbatMin is volts * 4096.
+constexpr RecordField kFed3SummaryFields[] =
+    {
+    { Type::Uint32, "time" },
+    { Type::Uint16, "deviceNumber" },
+    { Type::Uint8,  "sessionType" },
+    { Type::Uint8,  "sessionChanges" },
+    { Type::Uint32, "windowSec" },
+    { Type::Uint16, "events" },
+    { Type::Uint16, "leftPokes" },
+    { Type::Uint16, "rightPokes" },
+    { Type::Uint16, "pellets" },
+    { Type::Uint16, "pokeTimeMean" },
+    { Type::Uint16, "pokeTimeMax" },
+    { Type::Uint16, "retrievalTimeMean" },
+    { Type::Uint16, "retrievalTimeMax" },
+    { Type::Int16,  "vbatMin" },
+    };
+
+constexpr std::size_t kFed3SummaryFieldCount = sizeof(kFed3SummaryFields) / sizeof(kFed3SummaryFields[0]);
+
+constexpr std::size_t fed3SummarySizeBefore(std::size_t i)
+    {
+    return i == 0 ? 0 : fed3SummarySizeBefore(i - 1) + sizeOf(kFed3SummaryFields[i - 1].type);
+    }
+
+constexpr std::size_t kFed3SummaryRecordSize = fed3SummarySizeBefore(kFed3SummaryFieldCount);
+
+/****************************************************************************\
+|
+|   The message fields
+|
+\****************************************************************************/
+
+// the fields that may follow the flags byte, in wire order.
+enum class Field : std::uint8_t
+    {
+    Vbat,
+    Vsys,
+    Vbus,
+    BootCount,
+    Temperature,
+    Pressure,
+    Humidity,
+    Light,
+    Fed3,
+    nFields         // this must be last
+    };
+
+/*
+
+Type:   MessageField
+
+Description:
+    A field is sent if its flag bit is set in the flags byte; several
+    fields may share a bit. The value v, in the units given, is sent
+    as v * scaleNum / scaleDen, rounded and clamped to the type.
+
+*/
+
+struct MessageField
+    {
+    Field           field;
+    std::uint8_t    flag;
+    Type            type;
+    std::uint32_t   scaleNum;
+    std::uint32_t   scaleDen;
+    const char      *pName;         // name in the decoders; '.' nests
+    };
+
+constexpr MessageField kMessageFields[] =
+    {
+    // volts
+    { Field::Vbat,          1 << 0, Type::Int16,  4096, 1,          "Vbat" },
+    { Field::Vsys,          1 << 1, Type::Int16,  4096, 1,          "Vsys" },
+    { Field::Vbus,          1 << 2, Type::Int16,  4096, 1,          "Vbus" },
+    // modulo 256
+    { Field::BootCount,     1 << 3, Type::Uint8,  1,    1,          "boot" },
+    // degrees C, hPa, %RH
+    { Field::Temperature,   1 << 4, Type::Int16,  256,  1,          "tempC" },
+    { Field::Pressure,      1 << 4, Type::Uint16, 25,   1,          "p" },
+    { Field::Humidity,      1 << 4, Type::Uint16, 65535, 100,       "rh" },
+    // W/m^2
+    { Field::Light,         1 << 5, Type::Uflt16, 1,    1ul << 24,  "irradiance.White" },
+    { Field::Fed3,          1 << 6, Type::Fed3,   1,    1,          "fed3" },
+    };
+
+constexpr std::size_t kFieldCount = sizeof(kMessageFields) / sizeof(kMessageFields[0]);
+
+static_assert(kFieldCount == std::size_t(Field::nFields), "kMessageFields doesn't match Field");
+
+constexpr std::size_t sizeOf(Field f)
+    {
+    return kMessageFields[unsigned(f)].type == Type::Fed3
+        ? kFed3RecordSize
+        : sizeOf(kMessageFields[unsigned(f)].type);
+    }
+
+constexpr bool isPresent(std::uint8_t flags, Field f)
+    {
+    return (flags & kMessageFields[unsigned(f)].flag) != 0;
+    }
+
+// bytes taken by the fields before f, given the flags.
+constexpr std::size_t sizeBefore(std::uint8_t flags, std::size_t i)
+    {
+    return i == 0 ? 0 : sizeBefore(flags, i - 1) +
+        (isPresent(flags, Field(i - 1)) ? sizeOf(Field(i - 1)) : 0);
+    }
+
+// offset of f in a message: after the format and flags bytes.
+constexpr std::size_t offsetOf(std::uint8_t flags, Field f)
+    {
+    return 2 + sizeBefore(flags, unsigned(f));
+    }
+
+// size of a format 0x24 message with the given flags.
+constexpr std::size_t messageSize(std::uint8_t flags)
+    {
+    return 2 + sizeBefore(flags, kFieldCount);
+    }
+
+} // namespace MessageSchema
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_MessageSchema_h_ */
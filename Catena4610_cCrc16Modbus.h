@@ -0,0 +1,147 @@
+/*
+
+Module: Catena4610_cCrc16Modbus.h
+
+Function:
+    cCrc16Modbus: incremental CRC-16/MODBUS.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cCrc16Modbus_h_
+# define _Catena4610_cCrc16Modbus_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/****************************************************************************\
+|
+|   CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF)
+|
+\****************************************************************************/
+
+/*
+
+Class:  cCrc16Modbus
+
+Description:
+    The CRC can be computed three ways, which all give the same result:
+
+    Method::Bitwise     8 shift/xor steps per byte, no table.
+    Method::Nibble      2 lookups per byte, 32 bytes of table.
+    Method::Table       1 lookup per byte, 512 bytes of table.
+
+    kMethod selects the one used by update(); the others remain
+    available as static functions for comparison.
+
+    The CRC is transmitted low byte first, so running the CRC over a
+    whole frame including its CRC leaves zero if the frame is intact.
+    That lets the receiver check a frame without knowing where it
+    ends until it ends.
+
+*/
+
+class cCrc16Modbus
+    {
+public:
+    enum class Method : std::uint8_t
+        {
+        Bitwise,
+        Nibble,
+        Table,
+        };
+
+    static constexpr Method kMethod = Method::Table;
+    static constexpr std::uint16_t kInitial = 0xFFFF;
+
+    cCrc16Modbus()
+        : m_crc(kInitial)
+        {}
+
+    void begin()
+        {
+        this->m_crc = kInitial;
+        }
+
+    void update(std::uint8_t b)
+        {
+        this->m_crc = updateByte(this->m_crc, b);
+        }
+
+    void update(const std::uint8_t *pBuffer, std::size_t nBuffer)
+        {
+        this->m_crc = compute(pBuffer, nBuffer, this->m_crc);
+        }
+
+    std::uint16_t get() const
+        {
+        return this->m_crc;
+        }
+
+    // true if the bytes so far were a frame followed by its CRC.
+    bool isResidueGood() const
+        {
+        return this->m_crc == 0;
+        }
+
+    static std::uint16_t updateByte(std::uint16_t crc, std::uint8_t b)
+        {
+        switch (kMethod)
+            {
+        case Method::Bitwise:   return updateBitwise(crc, b);
+        case Method::Nibble:    return updateNibble(crc, b);
+        default:                return updateTable(crc, b);
+            }
+        }
+
+    static std::uint16_t compute(
+        const std::uint8_t *pBuffer,
+        std::size_t nBuffer,
+        std::uint16_t crc = kInitial
+        )
+        {
+        for (std::size_t i = 0; i < nBuffer; ++i)
+            crc = updateByte(crc, pBuffer[i]);
+        return crc;
+        }
+
+    static std::uint16_t updateBitwise(std::uint16_t crc, std::uint8_t b)
+        {
+        crc ^= b;
+        for (unsigned j = 0; j < 8; ++j)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+        return crc;
+        }
+
+    static std::uint16_t updateNibble(std::uint16_t crc, std::uint8_t b)
+        {
+        crc ^= b;
+        crc = (crc >> 4) ^ s_nibbleTable[crc & 0xF];
+        crc = (crc >> 4) ^ s_nibbleTable[crc & 0xF];
+        return crc;
+        }
+
+    static std::uint16_t updateTable(std::uint16_t crc, std::uint8_t b)
+        {
+        return (crc >> 8) ^ s_byteTable[(crc ^ b) & 0xFF];
+        }
+
+private:
+    static const std::uint16_t s_nibbleTable[16];
+    static const std::uint16_t s_byteTable[256];
+
+    std::uint16_t   m_crc;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cCrc16Modbus_h_ */
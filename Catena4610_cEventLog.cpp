@@ -0,0 +1,497 @@
+/*
+
+Module: Catena4610_cEventLog.cpp
+
+Function:
+    cEventLog: persistent log of FED3 events in SPI NOR flash.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cEventLog.h"
+
+#include "Catena4610_cCrc16Modbus.h"
+
+using namespace McciCatena4610;
+
+constexpr std::uint32_t cEventLogFlash::kPageSize;
+constexpr std::uint32_t cEventLogFlash::kSectorSize;
+constexpr std::uint8_t cEventLog::kRecordMagic;
+constexpr std::uint8_t cEventLog::kConsumedMagic;
+constexpr std::size_t cEventLog::kRecordSize;
+constexpr std::uint32_t cEventLog::kRecordsPerPage;
+constexpr std::uint32_t cEventLog::kRecordsPerSector;
+
+static_assert(cEventLog::kRecordsPerPage > 0, "a record must fit in a page");
+
+static void putLe32(std::uint8_t *p, std::uint32_t v)
+    {
+    p[0] = std::uint8_t(v);
+    p[1] = std::uint8_t(v >> 8);
+    p[2] = std::uint8_t(v >> 16);
+    p[3] = std::uint8_t(v >> 24);
+    }
+
+static std::uint32_t getLe32(const std::uint8_t *p)
+    {
+    return p[0] | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::begin()
+
+Function:
+    Attach the log to its storage and recover its state.
+
+Definition:
+    bool McciCatena4610::cEventLog::begin(
+            cEventLogFlash *pFlash,
+            cEventLogIndex *pIndex
+            );
+
+Description:
+    The whole of pFlash is used for the log. If the index can't be
+    loaded, the log starts out empty; otherwise the head is advanced
+    over any records that were programmed after the index was last
+    saved.
+
+Returns:
+    true if the log is usable. If not, isEnabled() is false and the
+    caller should keep events in RAM.
+
+*/
+
+bool cEventLog::begin(cEventLogFlash *pFlash, cEventLogIndex *pIndex)
+    {
+    this->m_pFlash = nullptr;
+    this->m_nDropped = 0;
+    this->m_nCorrupt = 0;
+
+    if (pFlash == nullptr || pIndex == nullptr)
+        return false;
+
+    // one sector is always being erased or refilled, so the log
+    // needs at least two.
+    std::uint32_t const nSectors = pFlash->getSize() / cEventLogFlash::kSectorSize;
+    if (nSectors < 2)
+        return false;
+
+    this->m_pFlash = pFlash;
+    this->m_pIndex = pIndex;
+    this->m_nSlots = nSectors * kRecordsPerSector;
+
+    if (! this->loadIndex())
+        {
+        this->m_headFlash = this->m_tail = 0;
+        this->m_head = 0;
+        this->m_nConsumed = 0;
+        this->m_nConsumedPending = 0;
+        return this->saveIndex();
+        }
+
+    std::uint32_t const headSaved = this->m_headFlash;
+
+    for (; this->m_headFlash - this->m_tail < this->m_nSlots; ++this->m_headFlash)
+        {
+        std::uint8_t record[kRecordSize];
+        Fed3Event event;
+
+        if (! this->m_pFlash->read(this->getAddress(this->m_headFlash), record, sizeof(record)))
+            break;
+
+        auto const status = this->parseRecord(this->m_headFlash, record, event);
+
+        if (status == ReadStatus::Consumed)
+            ++this->m_nConsumed;
+        else if (status != ReadStatus::Ok)
+            break;
+        }
+
+    // parseRecord() counted the record that stopped the scan.
+    this->m_nCorrupt = 0;
+    this->m_head = this->m_headFlash;
+    this->m_nConsumedPending = 0;
+
+    if (this->m_headFlash != headSaved)
+        return this->saveIndex();
+
+    return true;
+    }
+
+void cEventLog::end()
+    {
+    if (this->isEnabled())
+        this->flush();
+    this->m_pFlash = nullptr;
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::append()
+
+Function:
+    Add an event at the head.
+
+Definition:
+    bool McciCatena4610::cEventLog::append(
+            const Fed3Event &event
+            );
+
+Description:
+    The event is formatted into the page buffer. If it completes the
+    page, the page is programmed. If that fails, the event is taken
+    back out, so the page buffer never holds more than a page: the
+    caller must keep the event elsewhere, and the page is programmed
+    by the next append that completes it, or the next flush().
+
+Returns:
+    true if the event is in the log.
+
+*/
+
+bool cEventLog::append(const Fed3Event &event)
+    {
+    if (! this->isEnabled())
+        return false;
+
+    std::uint32_t const iRecord = this->getAddress(this->m_head) % cEventLogFlash::kPageSize / kRecordSize;
+
+    this->formatRecord(this->m_head, event, this->getPageRecord(this->m_head));
+    ++this->m_head;
+
+    // program as soon as the page is complete.
+    if (iRecord == kRecordsPerPage - 1 && ! this->flush())
+        {
+        --this->m_head;
+        return false;
+        }
+
+    return true;
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::flush()
+
+Function:
+    Program any buffered events into the flash.
+
+Definition:
+    bool McciCatena4610::cEventLog::flush(
+            void
+            );
+
+Description:
+    The buffered events all belong to one page. If the first of them
+    starts a sector, the sector is erased first, dropping the oldest
+    events if the log is full. Then they are programmed in one
+    operation, and the index is saved.
+
+Returns:
+    true for success.
+
+*/
+
+bool cEventLog::flush()
+    {
+    if (! this->isEnabled())
+        return false;
+
+    std::uint32_t const nPending = this->getPending();
+
+    if (nPending == 0)
+        return true;
+
+    if (! this->makeRoom(this->m_headFlash))
+        return false;
+
+    if (! this->m_pFlash->program(
+                this->getAddress(this->m_headFlash),
+                this->getPageRecord(this->m_headFlash),
+                nPending * kRecordSize
+                ))
+        return false;
+
+    this->m_headFlash = this->m_head;
+    this->m_nConsumedPending = 0;
+    return this->saveIndex();
+    }
+
+cEventLog::ReadStatus cEventLog::read(std::uint32_t seq, Fed3Event &event)
+    {
+    if (! this->isEnabled() || ! this->contains(seq))
+        return ReadStatus::Empty;
+
+    // not programmed yet: it's in the page buffer.
+    if (seq - this->m_headFlash < this->getPending())
+        return this->parseRecord(seq, this->getPageRecord(seq), event);
+
+    std::uint8_t record[kRecordSize];
+
+    if (! this->m_pFlash->read(this->getAddress(seq), record, sizeof(record)))
+        return ReadStatus::Corrupt;
+
+    return this->parseRecord(seq, record, event);
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::consume()
+
+Function:
+    Mark an event as consumed.
+
+Definition:
+    bool McciCatena4610::cEventLog::consume(
+            std::uint32_t seq
+            );
+
+Description:
+    The record's magic byte is cleared, in the page buffer or in the
+    flash. If the record is the oldest, the tail is advanced past it
+    and any consumed records that follow. Corrupt records can be
+    consumed like any other, to get them out of the way.
+
+Returns:
+    true for success; false if seq isn't in the log or the flash
+    couldn't be written.
+
+*/
+
+bool cEventLog::consume(std::uint32_t seq)
+    {
+    if (! this->isEnabled() || ! this->contains(seq))
+        return false;
+
+    if (seq - this->m_headFlash < this->getPending())
+        {
+        std::uint8_t * const pRecord = this->getPageRecord(seq);
+
+        if (pRecord[0] == kConsumedMagic)
+            return true;
+        pRecord[0] = kConsumedMagic;
+        ++this->m_nConsumedPending;
+        }
+    else
+        {
+        if (this->isConsumed(seq))
+            return true;
+
+        if (! this->m_pFlash->program(this->getAddress(seq), &kConsumedMagic, 1))
+            return false;
+        }
+
+    ++this->m_nConsumed;
+
+    // reclaim consumed records at the tail.
+    while (this->m_tail != this->m_head && this->isConsumed(this->m_tail))
+        {
+        if (this->m_tail - this->m_headFlash < this->getPending())
+            --this->m_nConsumedPending;
+        ++this->m_tail;
+        --this->m_nConsumed;
+        }
+
+    // the saved tail must never pass the saved head.
+    if (this->m_tail - this->m_headFlash <= this->getPending() &&
+        this->m_tail != this->m_headFlash)
+        return this->flush();
+
+    return this->saveIndex();
+    }
+
+bool cEventLog::clear()
+    {
+    if (! this->isEnabled())
+        return false;
+
+    this->flush();
+    this->m_tail = this->m_headFlash;
+    this->m_nConsumed = 0;
+    this->m_nConsumedPending = 0;
+    return this->saveIndex();
+    }
+
+bool cEventLog::isConsumed(std::uint32_t seq)
+    {
+    std::uint8_t magic;
+
+    if (seq - this->m_headFlash < this->getPending())
+        magic = this->getPageRecord(seq)[0];
+    else if (! this->m_pFlash->read(this->getAddress(seq), &magic, 1))
+        return false;
+
+    return magic == kConsumedMagic;
+    }
+
+std::uint32_t cEventLog::getAddress(std::uint32_t seq) const
+    {
+    std::uint32_t const slot = seq % this->m_nSlots;
+
+    return (slot / kRecordsPerPage) * cEventLogFlash::kPageSize + (slot % kRecordsPerPage) * kRecordSize;
+    }
+
+void cEventLog::formatRecord(std::uint32_t seq, const Fed3Event &event, std::uint8_t *pRecord) const
+    {
+    pRecord[0] = kRecordMagic;
+    putLe32(pRecord + 1, seq);
+    event.encode(pRecord + 5);
+
+    std::uint16_t const crc = cCrc16Modbus::compute(pRecord, kRecordSize - 2);
+    pRecord[kRecordSize - 2] = std::uint8_t(crc);
+    pRecord[kRecordSize - 1] = std::uint8_t(crc >> 8);
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::parseRecord()
+
+Function:
+    Check a record, and decode its event.
+
+Definition:
+    cEventLog::ReadStatus McciCatena4610::cEventLog::parseRecord(
+            std::uint32_t seq,
+            const std::uint8_t *pRecord,
+            Fed3Event &event
+            );
+
+Description:
+    A record only belongs to seq if it has that sequence number and a
+    good CRC. This matters for consumed records too: once the log has
+    wrapped, the slots past the head hold the records of the last lap,
+    many of them consumed, and begin() must stop at the first of them.
+    Consuming a record only clears its magic byte, so its CRC is
+    checked as it was written, with kRecordMagic.
+
+Returns:
+    ReadStatus::Ok or ReadStatus::Consumed if the record is seq's;
+    otherwise ReadStatus::Corrupt, and the record is counted as
+    corrupt.
+
+*/
+
+cEventLog::ReadStatus cEventLog::parseRecord(std::uint32_t seq, const std::uint8_t *pRecord, Fed3Event &event)
+    {
+    bool const fConsumed = pRecord[0] == kConsumedMagic;
+    cCrc16Modbus crc;
+
+    // with the CRC appended low byte first, a good record has zero residue.
+    crc.update(kRecordMagic);
+    crc.update(pRecord + 1, kRecordSize - 1);
+
+    if ((pRecord[0] != kRecordMagic && ! fConsumed) ||
+        getLe32(pRecord + 1) != seq ||
+        ! crc.isResidueGood())
+        {
+        ++this->m_nCorrupt;
+        return ReadStatus::Corrupt;
+        }
+
+    if (fConsumed)
+        return ReadStatus::Consumed;
+
+    event.decode(pRecord + 5, Fed3Event::kWireSize);
+    return ReadStatus::Ok;
+    }
+
+/*
+
+Name:   McciCatena4610::cEventLog::makeRoom()
+
+Function:
+    Erase the sector for a record, if it is the first in its sector.
+
+Definition:
+    bool McciCatena4610::cEventLog::makeRoom(
+            std::uint32_t seq
+            );
+
+Description:
+    The sector about to be reused holds the oldest records. If any of
+    them are still in the log, the tail is moved past them (and the
+    index saved) before the erase; those not yet consumed are counted
+    as dropped. This is done so a reset part way through never
+    leaves the index pointing at erased records.
+
+Returns:
+    true for success.
+
+*/
+
+bool cEventLog::makeRoom(std::uint32_t seq)
+    {
+    if (seq % this->m_nSlots % kRecordsPerSector != 0)
+        return true;
+
+    std::uint32_t const nKeep = this->m_nSlots - kRecordsPerSector;
+
+    // the tail is past seq if the records still in the page buffer
+    // have all been consumed; then there's nothing to drop.
+    if (std::int32_t(seq - this->m_tail) > std::int32_t(nKeep))
+        {
+        std::uint32_t const newTail = seq - nKeep;
+
+        for (; this->m_tail != newTail; ++this->m_tail)
+            {
+            if (this->isConsumed(this->m_tail))
+                --this->m_nConsumed;
+            else
+                ++this->m_nDropped;
+            }
+
+        if (! this->saveIndex())
+            return false;
+        }
+
+    return this->m_pFlash->eraseSector(this->getAddress(seq));
+    }
+
+bool cEventLog::loadIndex()
+    {
+    std::uint8_t buf[kIndexSize];
+
+    if (! this->m_pIndex->load(buf, sizeof(buf)))
+        return false;
+
+    if ((buf[0] | (buf[1] << 8)) != kIndexMagic ||
+        cCrc16Modbus::compute(buf, sizeof(buf)) != 0)
+        return false;
+
+    std::uint32_t const head = getLe32(buf + 2);
+    std::uint32_t const tail = getLe32(buf + 6);
+    std::uint32_t const nConsumed = getLe32(buf + 10);
+
+    if (head - tail > this->m_nSlots || nConsumed > head - tail)
+        return false;
+
+    this->m_headFlash = this->m_head = head;
+    this->m_tail = tail;
+    this->m_nConsumed = nConsumed;
+    return true;
+    }
+
+bool cEventLog::saveIndex()
+    {
+    std::uint8_t buf[kIndexSize];
+
+    buf[0] = std::uint8_t(kIndexMagic);
+    buf[1] = std::uint8_t(kIndexMagic >> 8);
+    putLe32(buf + 2, this->m_headFlash);
+    putLe32(buf + 6, this->m_tail);
+    // records consumed in the page buffer are only counted once
+    // they're programmed.
+    putLe32(buf + 10, this->m_nConsumed - this->m_nConsumedPending);
+
+    std::uint16_t const crc = cCrc16Modbus::compute(buf, kIndexSize - 2);
+    buf[kIndexSize - 2] = std::uint8_t(crc);
+    buf[kIndexSize - 1] = std::uint8_t(crc >> 8);
+
+    return this->m_pIndex->save(buf, sizeof(buf));
+    }
@@ -0,0 +1,341 @@
+/*
+
+Module: Catena4610_cEventLog.h
+
+Function:
+    cEventLog: persistent log of FED3 events in SPI NOR flash.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cEventLog_h_
+# define _Catena4610_cEventLog_h_
+
+#pragma once
+
+#include "Catena4610_Fed3Event.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena4610 {
+
+/****************************************************************************\
+|
+|   Storage used by the log
+|
+\****************************************************************************/
+
+/*
+
+Class:  cEventLogFlash
+
+Description:
+    The NOR flash operations the log needs. Addresses are relative to
+    the start of the region given to the log. program() never crosses a
+    page, and only ever turns 1 bits into 0 bits; eraseSector() sets a
+    whole sector to 0xFF.
+
+*/
+
+class cEventLogFlash
+    {
+public:
+    static constexpr std::uint32_t kPageSize = 256;
+    static constexpr std::uint32_t kSectorSize = 4096;
+
+    virtual std::uint32_t getSize() const = 0;
+    virtual bool read(std::uint32_t addr, std::uint8_t *pBuffer, std::size_t nBuffer) = 0;
+    virtual bool program(std::uint32_t addr, const std::uint8_t *pBuffer, std::size_t nBuffer) = 0;
+    virtual bool eraseSector(std::uint32_t addr) = 0;
+    };
+
+/*
+
+Class:  cEventLogIndex
+
+Description:
+    Somewhere small and byte-writable (normally FRAM) to keep the log's
+    head and tail, so that the flash itself is only ever appended to.
+
+*/
+
+class cEventLogIndex
+    {
+public:
+    virtual bool load(std::uint8_t *pBuffer, std::size_t nBuffer) = 0;
+    virtual bool save(const std::uint8_t *pBuffer, std::size_t nBuffer) = 0;
+    };
+
+/*
+
+Class:  cEventLogFlashRam<kSize>, cEventLogIndexRam
+
+Description:
+    RAM-backed stand-ins for the flash and FRAM. They enforce the NOR
+    rules (program can only clear bits), so the log behaves the same
+    against them as against the real parts; this is what lets the log
+    be exercised off-target. The flash can be told to fail programs
+    or erases, to exercise the log's error paths.
+
+*/
+
+template <std::uint32_t kSize>
+class cEventLogFlashRam : public cEventLogFlash
+    {
+public:
+    static_assert(kSize % kSectorSize == 0, "size must be whole sectors");
+
+    cEventLogFlashRam()
+        {
+        std::memset(this->m_data, 0xFF, sizeof(this->m_data));
+        }
+
+    virtual std::uint32_t getSize() const override
+        {
+        return kSize;
+        }
+    virtual bool read(std::uint32_t addr, std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        if (addr > kSize || nBuffer > kSize - addr)
+            return false;
+        std::memcpy(pBuffer, this->m_data + addr, nBuffer);
+        return true;
+        }
+    virtual bool program(std::uint32_t addr, const std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        if (this->m_fProgramFails || addr > kSize || nBuffer > kSize - addr)
+            return false;
+        for (std::size_t i = 0; i < nBuffer; ++i)
+            this->m_data[addr + i] &= pBuffer[i];
+        return true;
+        }
+    virtual bool eraseSector(std::uint32_t addr) override
+        {
+        if (this->m_fEraseFails || addr >= kSize)
+            return false;
+        addr -= addr % kSectorSize;
+        std::memset(this->m_data + addr, 0xFF, kSectorSize);
+        return true;
+        }
+
+    // make program() or eraseSector() fail, without touching the data.
+    void setProgramFails(bool fFail)
+        {
+        this->m_fProgramFails = fFail;
+        }
+    void setEraseFails(bool fFail)
+        {
+        this->m_fEraseFails = fFail;
+        }
+
+private:
+    std::uint8_t    m_data[kSize];
+    bool            m_fProgramFails = false;
+    bool            m_fEraseFails = false;
+    };
+
+class cEventLogIndexRam : public cEventLogIndex
+    {
+public:
+    virtual bool load(std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        if (nBuffer > sizeof(this->m_data))
+            return false;
+        std::memcpy(pBuffer, this->m_data, nBuffer);
+        return true;
+        }
+    virtual bool save(const std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        if (nBuffer > sizeof(this->m_data))
+            return false;
+        std::memcpy(this->m_data, pBuffer, nBuffer);
+        return true;
+        }
+
+private:
+    std::uint8_t    m_data[32] = {};
+    };
+
+/****************************************************************************\
+|
+|   The log
+|
+\****************************************************************************/
+
+/*
+
+Class:  cEventLog
+
+Description:
+    FED3 events are appended at the head. Events are identified by a
+    sequence number, which counts up from the tail (getFirst()) to the
+    head (getEnd()). Each event is stored in a fixed-size record:
+
+        uint8   kRecordMagic
+        uint32  sequence number (little-endian)
+        35      the event, as Fed3Event::encode()
+        uint16  CRC-16/MODBUS of the above
+
+    Records never straddle a page, so a page holds kRecordsPerPage of
+    them. Record n lives in slot n modulo the number of slots, so the
+    log walks the whole region and every sector is erased equally
+    often. A sector is erased just before its first record is written;
+    if the log is full, the oldest sector's worth of records is
+    dropped to make room.
+
+    Events can be consumed in any order. Consuming an event programs
+    its magic byte to kConsumedMagic; NOR flash can always clear bits,
+    so this needs no erase. The tail advances over consumed records.
+
+    Appends are collected in a page buffer and programmed a page at a
+    time; flush() programs a partial page. Only records that have been
+    programmed survive a reset.
+
+    The head, the tail and the number of consumed records are kept in
+    the index store (FRAM), which is written after each program and
+    each consume. At begin(), the head is moved past any valid records
+    beyond the saved one, in case power was lost between programming a
+    page and saving the index.
+
+*/
+
+class cEventLog
+    {
+public:
+    static constexpr std::uint8_t kRecordMagic = 0xE5;
+    static constexpr std::uint8_t kConsumedMagic = 0x00;
+    static constexpr std::size_t kRecordSize = 1 + 4 + Fed3Event::kWireSize + 2;
+    static constexpr std::uint32_t kRecordsPerPage = cEventLogFlash::kPageSize / kRecordSize;
+    static constexpr std::uint32_t kPagesPerSector = cEventLogFlash::kSectorSize / cEventLogFlash::kPageSize;
+    static constexpr std::uint32_t kRecordsPerSector = kRecordsPerPage * kPagesPerSector;
+
+    enum class ReadStatus : std::uint8_t
+        {
+        Ok,             // the event was read
+        Empty,          // no event at that position
+        Corrupt,        // the record failed its CRC or sequence check
+        Consumed,       // the event has been consumed
+        };
+
+    cEventLog() {}
+
+    // neither copyable nor movable
+    cEventLog(const cEventLog&) = delete;
+    cEventLog& operator=(const cEventLog&) = delete;
+    cEventLog(const cEventLog&&) = delete;
+    cEventLog& operator=(const cEventLog&&) = delete;
+
+    // attach to storage and recover the head and tail.
+    bool begin(cEventLogFlash *pFlash, cEventLogIndex *pIndex);
+    // flush and detach.
+    void end();
+
+    bool isEnabled() const
+        {
+        return this->m_pFlash != nullptr;
+        }
+
+    // number of events not yet consumed, including any not yet
+    // programmed.
+    std::uint32_t size() const
+        {
+        return this->m_head - this->m_tail - this->m_nConsumed;
+        }
+    bool empty() const
+        {
+        return this->size() == 0;
+        }
+    std::uint32_t capacity() const
+        {
+        return this->m_nSlots;
+        }
+    // number of events not yet programmed.
+    std::uint32_t getPending() const
+        {
+        return this->m_head - this->m_headFlash;
+        }
+    // sequence number of the oldest record, and one past the newest.
+    std::uint32_t getFirst() const
+        {
+        return this->m_tail;
+        }
+    std::uint32_t getEnd() const
+        {
+        return this->m_head;
+        }
+    // true if seq is in [getFirst(), getEnd()).
+    bool contains(std::uint32_t seq) const
+        {
+        return seq - this->m_tail < this->m_head - this->m_tail;
+        }
+
+    // add an event at the head; false if it isn't in the log.
+    bool append(const Fed3Event &event);
+    // program any buffered events.
+    bool flush();
+    // read the event with sequence number seq.
+    ReadStatus read(std::uint32_t seq, Fed3Event &event);
+    // mark the event with sequence number seq as consumed.
+    bool consume(std::uint32_t seq);
+    // consume everything.
+    bool clear();
+
+    // events lost to a full log, and records found corrupt.
+    std::uint32_t getDropCount() const
+        {
+        return this->m_nDropped;
+        }
+    std::uint32_t getCorruptCount() const
+        {
+        return this->m_nCorrupt;
+        }
+
+private:
+    static constexpr std::uint16_t kIndexMagic = 0x4C45;    // 'EL'
+    static constexpr std::size_t kIndexSize = 2 + 4 + 4 + 4 + 2;
+
+    std::uint32_t getAddress(std::uint32_t seq) const;
+    std::uint8_t *getPageRecord(std::uint32_t seq)
+        {
+        return &this->m_page[this->getAddress(seq) % cEventLogFlash::kPageSize];
+        }
+    bool isConsumed(std::uint32_t seq);
+    void formatRecord(std::uint32_t seq, const Fed3Event &event, std::uint8_t *pRecord) const;
+    ReadStatus parseRecord(std::uint32_t seq, const std::uint8_t *pRecord, Fed3Event &event);
+    bool loadIndex();
+    bool saveIndex();
+    bool makeRoom(std::uint32_t seq);
+
+    cEventLogFlash                  *m_pFlash = nullptr;
+    cEventLogIndex                  *m_pIndex = nullptr;
+    std::uint32_t                   m_nSlots = 0;
+
+    // sequence number of the next event to append
+    std::uint32_t                   m_head = 0;
+    // sequence number of the first event not yet programmed
+    std::uint32_t                   m_headFlash = 0;
+    // sequence number of the oldest event
+    std::uint32_t                   m_tail = 0;
+    // number of consumed records from m_tail to m_head, and how many
+    // of those are still in the page buffer
+    std::uint32_t                   m_nConsumed = 0;
+    std::uint32_t                   m_nConsumedPending = 0;
+
+    std::uint32_t                   m_nDropped = 0;
+    std::uint32_t                   m_nCorrupt = 0;
+
+    // events from m_headFlash to m_head, formatted, at their offsets
+    // within the page.
+    std::uint8_t                    m_page[cEventLogFlash::kPageSize];
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cEventLog_h_ */
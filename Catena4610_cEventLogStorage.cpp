@@ -0,0 +1,86 @@
+/*
+
+Module: Catena4610_cEventLogStorage.cpp
+
+Function:
+    Catena 4610 flash and FRAM storage for cEventLog.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cEventLogStorage.h"
+
+#include <cstring>
+
+using namespace McciCatena4610;
+
+constexpr std::uint32_t cEventLogFlashMx25::kBaseDefault;
+constexpr std::uint32_t cEventLogFlashMx25::kSizeDefault;
+constexpr std::uint32_t cEventLogIndexFram::kOffsetDefault;
+
+void cEventLogFlashMx25::powerUp()
+    {
+    if (this->m_pSpi)
+        this->m_pSpi->begin();
+    this->m_pFlash->powerUp();
+    }
+
+void cEventLogFlashMx25::powerDown()
+    {
+    this->m_pFlash->powerDown();
+    if (this->m_pSpi)
+        this->m_pSpi->end();
+    }
+
+bool cEventLogFlashMx25::read(std::uint32_t addr, std::uint8_t *pBuffer, std::size_t nBuffer)
+    {
+    if (! this->isValid(addr, nBuffer))
+        return false;
+
+    this->powerUp();
+    this->m_pFlash->read(this->m_base + addr, pBuffer, nBuffer);
+    this->powerDown();
+    return true;
+    }
+
+bool cEventLogFlashMx25::program(std::uint32_t addr, const std::uint8_t *pBuffer, std::size_t nBuffer)
+    {
+    if (! this->isValid(addr, nBuffer) ||
+        addr % kPageSize + nBuffer > kPageSize)
+        return false;
+
+    this->powerUp();
+    this->m_pFlash->programPage(this->m_base + addr, pBuffer, nBuffer);
+
+    // the log only programs erased bytes, or clears a whole byte, so
+    // what's read back must be what was written.
+    bool fResult = true;
+    std::uint8_t check[16];
+
+    for (std::size_t i = 0; fResult && i < nBuffer; i += sizeof(check))
+        {
+        std::size_t const n = nBuffer - i < sizeof(check) ? nBuffer - i : sizeof(check);
+
+        this->m_pFlash->read(this->m_base + addr + i, check, n);
+        fResult = std::memcmp(check, pBuffer + i, n) == 0;
+        }
+
+    this->powerDown();
+    return fResult;
+    }
+
+bool cEventLogFlashMx25::eraseSector(std::uint32_t addr)
+    {
+    if (! this->isValid(addr, kSectorSize))
+        return false;
+
+    this->powerUp();
+    bool const fResult = this->m_pFlash->eraseSector(this->m_base + addr - addr % kSectorSize);
+    this->powerDown();
+    return fResult;
+    }
@@ -0,0 +1,123 @@
+/*
+
+Module: Catena4610_cEventLogStorage.h
+
+Function:
+    Catena 4610 flash and FRAM storage for cEventLog.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cEventLogStorage_h_
+# define _Catena4610_cEventLogStorage_h_
+
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Catena_Fram.h>
+#include <Catena_Mx25v8035f.h>
+#include "Catena4610_cEventLog.h"
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cEventLogFlashMx25
+
+Description:
+    A region of the on-board MX25V8035F. The sketch keeps the flash
+    (and SPI2) powered down between uses, so each operation wakes it
+    and puts it back to sleep. The part doesn't report failed
+    programs, so program() reads the data back to check it.
+
+*/
+
+class cEventLogFlashMx25 : public cEventLogFlash
+    {
+public:
+    // the upper half of the flash; the lower half is left for
+    // firmware download images.
+    static constexpr std::uint32_t kBaseDefault = 0x80000;
+    static constexpr std::uint32_t kSizeDefault = 0x80000;
+
+    void begin(
+            McciCatena::Catena_Mx25v8035f *pFlash,
+            SPIClass *pSpi,
+            std::uint32_t base = kBaseDefault,
+            std::uint32_t size = kSizeDefault
+            )
+        {
+        this->m_pFlash = pFlash;
+        this->m_pSpi = pSpi;
+        this->m_base = base;
+        this->m_size = size - size % kSectorSize;
+        }
+
+    virtual std::uint32_t getSize() const override
+        {
+        return this->m_size;
+        }
+    virtual bool read(std::uint32_t addr, std::uint8_t *pBuffer, std::size_t nBuffer) override;
+    virtual bool program(std::uint32_t addr, const std::uint8_t *pBuffer, std::size_t nBuffer) override;
+    virtual bool eraseSector(std::uint32_t addr) override;
+
+private:
+    bool isValid(std::uint32_t addr, std::size_t nBuffer) const
+        {
+        return this->m_pFlash != nullptr &&
+               addr <= this->m_size && nBuffer <= this->m_size - addr;
+        }
+    void powerUp();
+    void powerDown();
+
+    McciCatena::Catena_Mx25v8035f   *m_pFlash = nullptr;
+    SPIClass                        *m_pSpi = nullptr;
+    std::uint32_t                   m_base = 0;
+    std::uint32_t                   m_size = 0;
+    };
+
+/*
+
+Class:  cEventLogIndexFram
+
+Description:
+    A few bytes at a fixed offset in the FRAM. The platform allocates
+    its own objects from the bottom of the FRAM, so the application's
+    data goes at the top.
+
+*/
+
+class cEventLogIndexFram : public cEventLogIndex
+    {
+public:
+    static constexpr std::uint32_t kOffsetDefault = 0x7F00;
+
+    void begin(McciCatena::cFram *pFram, std::uint32_t offset = kOffsetDefault)
+        {
+        this->m_pFram = pFram;
+        this->m_offset = offset;
+        }
+
+    virtual bool load(std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        return this->m_pFram != nullptr && this->m_pFram->read(this->m_offset, pBuffer, nBuffer);
+        }
+    virtual bool save(const std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        return this->m_pFram != nullptr && this->m_pFram->write(this->m_offset, pBuffer, nBuffer);
+        }
+
+private:
+    McciCatena::cFram               *m_pFram = nullptr;
+    std::uint32_t                   m_offset = 0;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cEventLogStorage_h_ */
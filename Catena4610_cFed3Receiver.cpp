@@ -0,0 +1,161 @@
+/*
+
+Module: Catena4610_cFed3Receiver.cpp
+
+Function:
+    Byte-level receiver for the FED3 serial link.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cFed3Receiver.h"
+
+using namespace McciCatena4610;
+
+/****************************************************************************\
+|
+|   Producer side
+|
+\****************************************************************************/
+
+void cFed3Receiver::begin()
+    {
+    this->m_head = 0;
+    this->m_tail = 0;
+    this->m_nOverrun = 0;
+    this->m_nFrame = 0;
+    this->m_nSeen = 0;
+    this->m_nExpected = 0;
+    this->m_fOverflow = false;
+    this->m_fFrameReady = false;
+    this->m_fLastCrcGood = false;
+    this->m_crc.begin();
+    }
+
+bool cFed3Receiver::receiveByte(std::uint8_t b, cFed3Receiver::Tick_t tRx)
+    {
+    std::uint8_t const head = this->m_head;
+    std::uint8_t const next = (head + 1) & (kRingSize - 1);
+
+    if (next == this->m_tail)
+        {
+        this->m_nOverrun = this->m_nOverrun + 1;
+        return false;
+        }
+
+    this->m_data[head] = b;
+    this->m_tick[head] = tRx;
+
+    // make sure the slot is written before the consumer can see it.
+    std::atomic_signal_fence(std::memory_order_release);
+    this->m_head = next;
+    return true;
+    }
+
+/****************************************************************************\
+|
+|   Consumer side
+|
+\****************************************************************************/
+
+void cFed3Receiver::acceptByte(std::uint8_t b, cFed3Receiver::Tick_t tRx)
+    {
+    if (this->m_nFrame < sizeof(this->m_frame))
+        {
+        this->m_frame[this->m_nFrame++] = b;
+        this->m_crc.update(b);
+        }
+    else
+        this->m_fOverflow = true;
+
+    ++this->m_nSeen;
+    this->m_tLast = tRx;
+
+    // once we have the header, we know how long the frame should be.
+    if (this->m_nSeen == kHeaderSize)
+        {
+        unsigned const nExpected = kHeaderSize + this->m_frame[kHeaderSize - 1] + kCrcSize;
+
+        // only trust the byte count if it's plausible; otherwise
+        // fall back to the silent-line rule.
+        this->m_nExpected = nExpected <= kMaxFrame ? nExpected : 0;
+        }
+
+    if (this->m_nExpected != 0 && this->m_nSeen >= this->m_nExpected)
+        this->endFrame();
+    }
+
+bool cFed3Receiver::isFrameReady(std::uint32_t tNow)
+    {
+    if (this->m_fFrameReady)
+        return true;
+
+    while (this->m_tail != this->m_head)
+        {
+        std::atomic_signal_fence(std::memory_order_acquire);
+
+        std::uint8_t const tail = this->m_tail;
+        Tick_t const tRx = this->m_tick[tail];
+
+        // a gap before this byte ends the previous frame; leave this
+        // byte in the ring as the start of the next one.
+        if (this->m_nSeen != 0 && Tick_t(tRx - this->m_tLast) >= kT35)
+            {
+            this->endFrame();
+            return true;
+            }
+
+        this->acceptByte(this->m_data[tail], tRx);
+        this->m_tail = (tail + 1) & (kRingSize - 1);
+
+        if (this->m_fFrameReady)
+            return true;
+        }
+
+    // nothing more in the ring: has the line been quiet long enough?
+    if (this->m_nSeen != 0 && Tick_t(Tick_t(tNow) - this->m_tLast) >= kT35)
+        {
+        this->endFrame();
+        return true;
+        }
+
+    return false;
+    }
+
+bool cFed3Receiver::readFrame(
+    std::uint8_t *pBuffer,
+    std::size_t nBuffer,
+    std::uint8_t &nActual,
+    bool &fOverflow
+    )
+    {
+    if (! this->m_fFrameReady)
+        return false;
+
+    std::size_t n = this->m_nFrame;
+
+    fOverflow = this->m_fOverflow;
+    if (n > nBuffer)
+        {
+        n = nBuffer;
+        fOverflow = true;
+        }
+
+    std::memcpy(pBuffer, this->m_frame, n);
+    nActual = std::uint8_t(n);
+    this->m_fLastCrcGood = this->m_crc.isResidueGood();
+
+    // start the next frame.
+    this->m_nFrame = 0;
+    this->m_nSeen = 0;
+    this->m_nExpected = 0;
+    this->m_fOverflow = false;
+    this->m_fFrameReady = false;
+    this->m_crc.begin();
+    return true;
+    }
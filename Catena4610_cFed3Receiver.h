@@ -0,0 +1,214 @@
+/*
+
+Module: Catena4610_cFed3Receiver.h
+
+Function:
+    cFed3Receiver: byte-level receiver for the FED3 serial link.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cFed3Receiver_h_
+# define _Catena4610_cFed3Receiver_h_
+
+#pragma once
+
+#include "Catena4610_cCrc16Modbus.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena4610 {
+
+/****************************************************************************\
+|
+|   The FED3 receiver
+|
+\****************************************************************************/
+
+/*
+
+Class:  cFed3Receiver
+
+Description:
+    Received bytes are placed, together with the time they were received,
+    into a single-producer / single-consumer ring. The producer side
+    is receiveByte(), normally called by pump(); the consumer side
+    (isFrameReady() / readFrame()) runs from the measurement loop.
+    Neither side takes a lock: the producer only writes m_head, the
+    consumer only writes m_tail, so receiveByte() could also be called
+    from a UART interrupt.
+
+    The Arduino core gives us no hook into its UART interrupt, so on
+    the node the bytes come from pump(), which drains Serial1 and
+    stamps each byte with the clock as it is read. That is the time
+    the byte left the core's receive buffer, not the time it arrived:
+    bytes that were already waiting when pump() ran get nearly the
+    same stamp. The loop calls pump() every time round, so the stamps
+    are good to within one pass of the loop.
+
+    Frames are delimited on the consumer side from the per-byte
+    timestamps rather than from the time the consumer happens to look,
+    so a late call to isFrameReady() doesn't merge frames. A frame
+    ends when:
+
+    - the byte count in the header says it's complete, or
+    - there's a gap of at least kT35 ms between two bytes, or
+    - the line has been silent for kT35 ms after the last byte.
+
+    The byte count doesn't depend on the stamps, so frames sent back
+    to back are always split correctly. The two silence rules only
+    matter for frames cut short; they can see a gap only if pump() ran
+    during it, so a short frame and the frame after it, both drained
+    in one late pass, are taken as one frame, and fail the CRC.
+
+    The CRC is accumulated as each byte is accepted, so checking it
+    at the end of the frame costs nothing more.
+
+    The receiver never reads the clock itself: the time is passed in
+    with each byte and each poll, and pump() takes the clock as an
+    argument. It doesn't depend on Arduino either, so it can be driven
+    from recorded traffic and a simulated clock off-target.
+
+*/
+
+class cFed3Receiver
+    {
+public:
+    // inter-frame silence, in milliseconds.
+    static constexpr unsigned kT35 = 5;
+    // number of bytes the ring can hold; must be a power of two.
+    static constexpr unsigned kRingSize = 128;
+    // largest frame we'll accept.
+    static constexpr unsigned kMaxFrame = 44;
+    // ID, ADDR_HI, ADDR_LO, BYTE_CNT
+    static constexpr unsigned kHeaderSize = 4;
+    // CRC-16 at end of frame.
+    static constexpr unsigned kCrcSize = 2;
+
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "kRingSize must be a power of two");
+    static_assert(kRingSize <= 256, "ring indices are 8 bits");
+
+    // the timestamp type: low 16 bits of millis().
+    using Tick_t = std::uint16_t;
+
+    cFed3Receiver() {};
+
+    // neither copyable nor movable
+    cFed3Receiver(const cFed3Receiver&) = delete;
+    cFed3Receiver& operator=(const cFed3Receiver&) = delete;
+    cFed3Receiver(const cFed3Receiver&&) = delete;
+    cFed3Receiver& operator=(const cFed3Receiver&&) = delete;
+
+    // discard all state.
+    void begin();
+
+    // producer: record one byte received at time tRx. Interrupt-safe.
+    // Returns false (and counts an overrun) if the ring is full.
+    bool receiveByte(std::uint8_t b, Tick_t tRx);
+
+    // producer: move everything the stream has into the ring, stamping
+    // each byte with clock() as it is read. TStream is anything with
+    // Arduino Stream's available() and read(); TClock is anything that
+    // can be called to get millis(). Returns the number of bytes read.
+    template <typename TStream, typename TClock>
+    std::size_t pump(TStream &s, TClock &&clock)
+        {
+        std::size_t n = 0;
+
+        while (s.available() > 0)
+            {
+            int const c = s.read();
+
+            if (c < 0)
+                break;
+
+            this->receiveByte(std::uint8_t(c), Tick_t(clock()));
+            ++n;
+            }
+
+        return n;
+        }
+
+    // consumer: assemble frames; return true if a complete frame is
+    // waiting to be read.
+    bool isFrameReady(std::uint32_t tNow);
+
+    // consumer: copy out the completed frame and start the next one.
+    // nActual is set to the number of bytes copied; fOverflow is set
+    // if the frame was longer than either kMaxFrame or nBuffer.
+    bool readFrame(std::uint8_t *pBuffer, std::size_t nBuffer, std::uint8_t &nActual, bool &fOverflow);
+
+    // true if the frame most recently returned by readFrame() was
+    // followed by a matching CRC.
+    bool isLastFrameCrcGood() const
+        {
+        return this->m_fLastCrcGood;
+        }
+
+    // number of bytes lost because the ring was full.
+    std::uint32_t getOverrunCount() const
+        {
+        return this->m_nOverrun;
+        }
+
+    // number of bytes waiting in the ring.
+    unsigned getRingCount() const
+        {
+        return std::uint8_t(this->m_head - this->m_tail) & (kRingSize - 1);
+        }
+
+    // true if no frame is part-way through being received or waiting
+    // to be read.
+    bool isIdle() const
+        {
+        return this->m_nSeen == 0 && ! this->m_fFrameReady && this->getRingCount() == 0;
+        }
+
+private:
+    // consume one byte from the ring into the frame.
+    void acceptByte(std::uint8_t b, Tick_t tRx);
+    // mark the current frame as complete.
+    void endFrame()
+        {
+        this->m_fFrameReady = true;
+        }
+
+    // the ring. m_head is written only by the producer, m_tail only
+    // by the consumer. One slot is left empty to tell full from empty.
+    std::uint8_t                    m_data[kRingSize];
+    Tick_t                          m_tick[kRingSize];
+    volatile std::uint8_t           m_head = 0;
+    volatile std::uint8_t           m_tail = 0;
+    volatile std::uint32_t          m_nOverrun = 0;
+
+    // the frame being assembled.
+    std::uint8_t                    m_frame[kMaxFrame];
+    // number of bytes in m_frame.
+    std::uint8_t                    m_nFrame = 0;
+    // number of bytes seen for this frame, including any dropped.
+    std::uint16_t                   m_nSeen = 0;
+    // number of bytes expected per the header; zero if not known.
+    std::uint8_t                    m_nExpected = 0;
+    // timestamp of the last byte accepted into the frame.
+    Tick_t                          m_tLast = 0;
+    // set true if bytes were dropped from the frame.
+    bool                            m_fOverflow = false;
+    // set true when m_frame is complete and waiting to be read.
+    bool                            m_fFrameReady = false;
+    // CRC state of the last frame read.
+    bool                            m_fLastCrcGood = false;
+    // running CRC over the bytes in m_frame.
+    cCrc16Modbus                    m_crc;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cFed3Receiver_h_ */
@@ -0,0 +1,293 @@
+/*
+
+Module: Catena4610_cFed3TrafficGen.cpp
+
+Function:
+    cFed3TrafficGen: synthetic and recorded FED3 traffic for load tests.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cFed3TrafficGen.h"
+
+#include "Catena4610_cCrc16Modbus.h"
+
+#include <cstring>
+
+using namespace McciCatena4610;
+
+constexpr std::uint32_t cFed3TrafficGen::kByteTimeUs;
+constexpr std::size_t cFed3TrafficGen::kRxBufferSize;
+constexpr std::uint8_t cFed3TrafficGen::kFrameId;
+constexpr std::size_t cFed3TrafficGen::kFrameSize;
+
+static_assert(cFed3TrafficGen::kFrameSize <= cFed3Receiver::kMaxFrame, "frame won't fit the receiver");
+
+void cFed3TrafficGen::start(Mode mode, Clock_t clock)
+    {
+    this->m_clock = clock;
+    this->m_tNext = this->m_tBurst = clock != nullptr ? clock() : 0;
+    this->m_iBurst = 0;
+    this->m_nFrame = this->m_iFrame = 0;
+    this->m_fHaveByte = false;
+    this->m_rxHead = this->m_rxTail = 0;
+    this->m_nFrames = this->m_nCorrupt = this->m_nTruncated = 0;
+    this->m_nBackToBack = this->m_nBytes = this->m_nOverrun = 0;
+    this->m_mode = clock != nullptr ? mode : Mode::Idle;
+    }
+
+void cFed3TrafficGen::begin(const Config &config, Clock_t clock)
+    {
+    this->m_config = config;
+    if (this->m_config.nBurst == 0)
+        this->m_config.nBurst = 1;
+    if (this->m_config.corruptPercent > 100)
+        this->m_config.corruptPercent = 100;
+    if (this->m_config.nDevices == 0)
+        this->m_config.nDevices = 1;
+
+    this->m_random = config.seed != 0 ? config.seed : 1;
+    this->start(config.nFrames != 0 ? Mode::Synthetic : Mode::Idle, clock);
+    }
+
+void cFed3TrafficGen::beginReplay(
+    const std::uint8_t *pData,
+    const std::uint16_t *pDelayMs,
+    std::size_t n,
+    Clock_t clock
+    )
+    {
+    this->m_pReplayData = pData;
+    this->m_pReplayDelayMs = pDelayMs;
+    this->m_nReplay = n;
+    this->m_iReplay = 0;
+    this->start(
+        (pData != nullptr && pDelayMs != nullptr && n != 0) ? Mode::Replay : Mode::Idle,
+        clock
+        );
+    }
+
+void cFed3TrafficGen::end()
+    {
+    this->m_mode = Mode::Idle;
+    this->m_fHaveByte = false;
+    this->m_rxHead = this->m_rxTail = 0;
+    }
+
+int cFed3TrafficGen::available()
+    {
+    this->receive();
+    return std::uint8_t(this->m_rxHead - this->m_rxTail);
+    }
+
+int cFed3TrafficGen::peek()
+    {
+    if (this->available() == 0)
+        return -1;
+
+    return this->m_rx[this->m_rxTail % kRxBufferSize];
+    }
+
+int cFed3TrafficGen::read()
+    {
+    int const c = this->peek();
+
+    if (c >= 0)
+        ++this->m_rxTail;
+
+    return c;
+    }
+
+// move everything that's arrived off the line, into the buffer.
+void cFed3TrafficGen::receive()
+    {
+    if (this->m_mode == Mode::Idle)
+        return;
+
+    std::uint32_t const tNow = this->m_clock();
+
+    for (;;)
+        {
+        if (! this->m_fHaveByte)
+            {
+            this->m_fHaveByte = this->m_mode == Mode::Synthetic ? this->loadSynthetic()
+                                                                 : this->loadReplay();
+            if (! this->m_fHaveByte)
+                {
+                this->m_mode = Mode::Idle;
+                return;
+                }
+            }
+
+        if (std::int32_t(tNow - this->m_tByte) < 0)
+            return;
+
+        if (std::uint8_t(this->m_rxHead - this->m_rxTail) < kRxBufferSize)
+            this->m_rx[this->m_rxHead++ % kRxBufferSize] = this->m_byte;
+        else
+            ++this->m_nOverrun;
+
+        ++this->m_nBytes;
+        this->m_fHaveByte = false;
+        }
+    }
+
+/*
+
+Name:   McciCatena4610::cFed3TrafficGen::buildFrame()
+
+Function:
+    Build one frame of a synthetic run.
+
+Definition:
+    static std::size_t McciCatena4610::cFed3TrafficGen::buildFrame(
+            std::uint32_t i,
+            std::uint8_t *pBuffer,
+            std::uint8_t nDevices
+            );
+
+Description:
+    Frame i carries a plausible event: the pokes go left, right, pellet
+    in turn, and the counts add up, so the uplink encoders see the
+    same kind of deltas as they would from a real FED3. The timestamp
+    is i, so the frames can be told apart at the far end.
+
+    With several devices, frame i comes from device i % nDevices, at
+    address kFrameId + i % nDevices, with that number as its
+    DeviceNumber; each device's counts add up on their own.
+
+Returns:
+    The number of bytes written, kFrameSize.
+
+*/
+
+std::size_t cFed3TrafficGen::buildFrame(std::uint32_t i, std::uint8_t *pBuffer, std::uint8_t nDevices)
+    {
+    if (nDevices == 0)
+        nDevices = 1;
+
+    std::uint8_t const iDevice = std::uint8_t(i % nDevices);
+    // the device's own frame count.
+    std::uint32_t const n = i / nDevices;
+    Fed3Event event;
+
+    std::memset(&event, 0, sizeof(event));
+    event.TimeStamp = i;
+    event.VersionMajor = 1;
+    event.DeviceNumber = std::uint16_t(1 + iDevice);
+    event.SessionType = 1;
+    event.Vbat = 3700 * 4096 / 1000;
+    event.FixedRatio = 1;
+    event.EventTime = std::uint16_t(100 + n % 50);
+    event.LeftCount = n / 3 + 1;
+    event.RightCount = (n + 2) / 3;
+    event.PelletCount = (n + 1) / 3;
+    event.NumMotorTurns = event.PelletCount * 2;
+
+    switch (n % 3)
+        {
+    case 0:     event.EventActive = 1; break;       // Left
+    case 1:     event.EventActive = 6; break;       // Right
+    default:    event.EventActive = Fed3Event::kEventPellet; break;
+        }
+
+    pBuffer[0] = std::uint8_t(kFrameId + iDevice);
+    pBuffer[1] = 0;
+    pBuffer[2] = 0;
+    pBuffer[3] = std::uint8_t(Fed3Event::kWireSize);
+    event.encode(pBuffer + cFed3Receiver::kHeaderSize);
+
+    std::size_t const nData = cFed3Receiver::kHeaderSize + Fed3Event::kWireSize;
+    std::uint16_t const crc = cCrc16Modbus::compute(pBuffer, nData);
+
+    pBuffer[nData] = std::uint8_t(crc);
+    pBuffer[nData + 1] = std::uint8_t(crc >> 8);
+    return kFrameSize;
+    }
+
+bool cFed3TrafficGen::loadSynthetic()
+    {
+    if (this->m_iFrame == this->m_nFrame)
+        {
+        // the last frame is all on the line; start the next.
+        if (this->m_nFrames >= this->m_config.nFrames)
+            return false;
+
+        std::size_t n = buildFrame(this->m_nFrames, this->m_frame, this->m_config.nDevices);
+
+        if (this->random() % 100 < this->m_config.corruptPercent)
+            {
+            std::uint32_t const r = this->random();
+
+            if (r & 1)
+                {
+                this->m_frame[cFed3Receiver::kHeaderSize + (r >> 1) % Fed3Event::kWireSize] ^= 0x5A;
+                ++this->m_nCorrupt;
+                }
+            else
+                {
+                n = 1 + (r >> 1) % (n - 1);
+                ++this->m_nTruncated;
+                }
+            }
+
+        this->m_nFrame = std::uint8_t(n);
+        this->m_iFrame = 0;
+        this->m_tByte = this->m_tNext;
+        ++this->m_nFrames;
+        }
+
+    this->m_byte = this->m_frame[this->m_iFrame++];
+    this->m_tByte += kByteTimeUs;
+
+    if (this->m_iFrame == this->m_nFrame)
+        {
+        std::uint32_t const tEnd = this->m_tByte;
+
+        if (++this->m_iBurst < this->m_config.nBurst)
+            {
+            // the next frame follows without a gap.
+            this->m_tNext = tEnd;
+            ++this->m_nBackToBack;
+            }
+        else
+            {
+            // bursts can't overlap.
+            this->m_iBurst = 0;
+            this->m_tBurst += this->m_config.intervalMs * 1000;
+            this->m_tNext = std::int32_t(this->m_tBurst - tEnd) > 0 ? this->m_tBurst : tEnd;
+            }
+        }
+
+    return true;
+    }
+
+bool cFed3TrafficGen::loadReplay()
+    {
+    if (this->m_iReplay >= this->m_nReplay)
+        return false;
+
+    // m_tNext is when the last byte finished arriving.
+    std::uint32_t const tDelay = this->m_tNext + this->m_pReplayDelayMs[this->m_iReplay] * 1000u;
+    std::uint32_t const tFree = this->m_tNext + kByteTimeUs;
+
+    this->m_byte = this->m_pReplayData[this->m_iReplay++];
+    this->m_tByte = this->m_tNext = std::int32_t(tDelay - tFree) > 0 ? tDelay : tFree;
+    return true;
+    }
+
+// xorshift32: cheap, and the same sequence everywhere for a given seed.
+std::uint32_t cFed3TrafficGen::random()
+    {
+    std::uint32_t x = this->m_random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return this->m_random = x;
+    }
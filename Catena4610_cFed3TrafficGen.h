@@ -0,0 +1,214 @@
+/*
+
+Module: Catena4610_cFed3TrafficGen.h
+
+Function:
+    cFed3TrafficGen: synthetic and recorded FED3 traffic for load tests.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cFed3TrafficGen_h_
+# define _Catena4610_cFed3TrafficGen_h_
+
+#pragma once
+
+#include "Catena4610_cFed3Receiver.h"
+#include "Catena4610_Fed3Event.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cFed3TrafficGen
+
+Description:
+    A stand-in for Serial1 carrying FED3 traffic, so the whole receive
+    path (framing, CRC, validation, queueing and logging) can be loaded
+    without a FED3. The loop drains it with cFed3Receiver::pump(), just
+    as it drains Serial1, so its bytes are stamped as they're read.
+
+    In synthetic mode, frames are built from made-up events: nFrames
+    of them, in bursts of nBurst sent back to back (so only the byte
+    count separates them), with intervalMs from the start of one burst
+    to the start of the next. corruptPercent of the frames are damaged,
+    half by flipping a payload byte (the CRC fails) and half by cutting
+    them short (a runt, or a merge with the next frame of the burst).
+    The damage is chosen by a seeded pseudo-random sequence, so a run
+    can be repeated exactly. The frames can come from nDevices FED3s,
+    at addresses kFrameId and up, in turn.
+
+    In replay mode, recorded bytes are sent with their recorded
+    inter-byte delays. The data belongs to the caller, and must stay
+    put until the replay is done.
+
+    Either way, the bytes go on the line one every kByteTimeUs at
+    most, and wait in a buffer of kRxBufferSize bytes until they're
+    read, as in the Arduino core. If the loop is late reading them,
+    the buffer fills, and bytes are lost just as they would be from
+    the UART.
+
+    The clock, micros() on the node, is passed to begin(). Nothing
+    here depends on Arduino, so it can be run off-target against a
+    simulated clock.
+
+*/
+
+class cFed3TrafficGen
+    {
+public:
+    // one byte at 115200 baud, 8N1, in microseconds.
+    static constexpr std::uint32_t kByteTimeUs = 87;
+    // the STM32 core's SERIAL_RX_BUFFER_SIZE.
+    static constexpr std::size_t kRxBufferSize = 64;
+    // the frame header: ID, ADDR_HI, ADDR_LO, BYTE_CNT. The ID is the
+    // address of the first FED3.
+    static constexpr std::uint8_t kFrameId = 0x01;
+    static constexpr std::size_t kFrameSize =
+        cFed3Receiver::kHeaderSize + Fed3Event::kWireSize + cFed3Receiver::kCrcSize;
+
+    static_assert((kRxBufferSize & (kRxBufferSize - 1)) == 0, "kRxBufferSize must be a power of two");
+
+    // the clock: microseconds, wrapping.
+    using Clock_t = std::uint32_t (*)();
+
+    struct Config
+        {
+        std::uint32_t   nFrames;
+        std::uint32_t   intervalMs;
+        std::uint8_t    nBurst;
+        std::uint8_t    corruptPercent;
+        std::uint32_t   seed;
+        std::uint8_t    nDevices = 1;
+        };
+
+    cFed3TrafficGen() {}
+
+    // neither copyable nor movable
+    cFed3TrafficGen(const cFed3TrafficGen&) = delete;
+    cFed3TrafficGen& operator=(const cFed3TrafficGen&) = delete;
+    cFed3TrafficGen(const cFed3TrafficGen&&) = delete;
+    cFed3TrafficGen& operator=(const cFed3TrafficGen&&) = delete;
+
+    // start sending synthetic frames, the first now.
+    void begin(const Config &config, Clock_t clock);
+    // start replaying n bytes; byte i is sent pDelayMs[i] after byte
+    // i - 1 (or after now, for the first), or as soon as the line is
+    // free, if that's later.
+    void beginReplay(
+            const std::uint8_t *pData,
+            const std::uint16_t *pDelayMs,
+            std::size_t n,
+            Clock_t clock
+            );
+    // stop sending, and drop anything not yet read; the counts are kept.
+    void end();
+
+    // true while there's anything still to send or to be read.
+    bool isActive() const
+        {
+        return this->m_mode != Mode::Idle || this->m_rxHead != this->m_rxTail;
+        }
+
+    // the Stream side: what's arrived by now, and not yet read.
+    int available();
+    int peek();
+    int read();
+
+    // frames sent, and how many of them were damaged on purpose or
+    // sent hard on the heels of the previous one.
+    std::uint32_t getFrameCount() const
+        {
+        return this->m_nFrames;
+        }
+    std::uint32_t getCorruptCount() const
+        {
+        return this->m_nCorrupt;
+        }
+    std::uint32_t getTruncateCount() const
+        {
+        return this->m_nTruncated;
+        }
+    std::uint32_t getBackToBackCount() const
+        {
+        return this->m_nBackToBack;
+        }
+    std::uint32_t getByteCount() const
+        {
+        return this->m_nBytes;
+        }
+    // bytes lost because the buffer was full when they arrived.
+    std::uint32_t getOverrunCount() const
+        {
+        return this->m_nOverrun;
+        }
+
+    // build frame i of a synthetic run from nDevices FED3s; returns
+    // its size (kFrameSize).
+    static std::size_t buildFrame(std::uint32_t i, std::uint8_t *pBuffer, std::uint8_t nDevices = 1);
+
+private:
+    enum class Mode : std::uint8_t
+        {
+        Idle,
+        Synthetic,
+        Replay,
+        };
+
+    std::uint32_t random();
+    // put everything that has arrived by now into the buffer.
+    void receive();
+    // set up the next byte to go on the line; false if there's none.
+    bool loadSynthetic();
+    bool loadReplay();
+    void start(Mode mode, Clock_t clock);
+
+    Mode                            m_mode = Mode::Idle;
+    Config                          m_config;
+    Clock_t                         m_clock = nullptr;
+    // the next byte on the line, and when (micros) it will have arrived
+    std::uint8_t                    m_byte = 0;
+    bool                            m_fHaveByte = false;
+    std::uint32_t                   m_tByte = 0;
+    // synthetic: the frame on the line, the time (micros) the next
+    // frame may start, and the time the current burst started
+    std::uint8_t                    m_frame[kFrameSize];
+    std::uint8_t                    m_nFrame = 0;
+    std::uint8_t                    m_iFrame = 0;
+    std::uint32_t                   m_tNext = 0;
+    std::uint32_t                   m_tBurst = 0;
+    // position in the current burst
+    std::uint8_t                    m_iBurst = 0;
+    // pseudo-random state
+    std::uint32_t                   m_random = 1;
+
+    // the replay
+    const std::uint8_t              *m_pReplayData = nullptr;
+    const std::uint16_t             *m_pReplayDelayMs = nullptr;
+    std::size_t                     m_nReplay = 0;
+    std::size_t                     m_iReplay = 0;
+
+    // the receive buffer
+    std::uint8_t                    m_rx[kRxBufferSize];
+    std::uint8_t                    m_rxHead = 0;
+    std::uint8_t                    m_rxTail = 0;
+
+    std::uint32_t                   m_nFrames = 0;
+    std::uint32_t                   m_nCorrupt = 0;
+    std::uint32_t                   m_nTruncated = 0;
+    std::uint32_t                   m_nBackToBack = 0;
+    std::uint32_t                   m_nBytes = 0;
+    std::uint32_t                   m_nOverrun = 0;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cFed3TrafficGen_h_ */
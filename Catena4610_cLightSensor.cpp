@@ -0,0 +1,171 @@
+/*
+
+Module: Catena4610_cLightSensor.cpp
+
+Function:
+    cLightSensor: non-blocking, auto-ranging Si1133 light measurement.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cLightSensor.h"
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+constexpr std::uint8_t cLightSensor::kHwGainMax;
+constexpr std::uint8_t cLightSensor::kSwGainMax;
+constexpr std::uint8_t cLightSensor::kHwGainDefault;
+constexpr std::uint8_t cLightSensor::kSwGainDefault;
+constexpr std::uint32_t cLightSensor::kPollIntervalMs;
+constexpr std::uint32_t cLightSensor::kRangeUp;
+constexpr std::uint32_t cLightSensor::kRangeDown;
+
+// the accumulated result is shifted right this far.
+static constexpr std::uint8_t kPostShift = 1;
+
+bool cLightSensor::begin()
+    {
+    this->m_fBusy = false;
+    this->m_fResult = false;
+    this->m_fPresent = this->m_si1133.begin();
+
+    if (this->m_fPresent)
+        this->m_fPresent = this->configure();
+
+    return this->m_fPresent;
+    }
+
+bool cLightSensor::configure()
+    {
+    auto const measConfig = Catena_Si1133::ChannelConfiguration_t()
+        .setAdcMux(Catena_Si1133::InputLed_t::LargeWhite)
+        .setSwGainCode(this->m_swGain)
+        .setHwGainCode(this->m_hwGain)
+        .setPostShift(kPostShift)
+        .set24bit(true);
+
+    this->m_fReconfigure = false;
+    return this->m_si1133.configure(0, measConfig, 0);
+    }
+
+void cLightSensor::setGain(std::uint8_t hwGain, std::uint8_t swGain)
+    {
+    this->m_hwGain = hwGain > kHwGainMax ? kHwGainMax : hwGain;
+    this->m_swGain = swGain > kSwGainMax ? kSwGainMax : swGain;
+    this->m_fReconfigure = true;
+    }
+
+std::uint32_t cLightSensor::getConversionMs() const
+    {
+    // 24.4 us, times 2^hwGain, times 2^swGain; rounded up.
+    return ((std::uint32_t(244) << (this->m_hwGain + this->m_swGain)) + 9999) / 10000;
+    }
+
+bool cLightSensor::start(std::uint32_t tNow)
+    {
+    if (! this->m_fPresent || this->m_fBusy)
+        return false;
+
+    if (this->m_fReconfigure && ! this->configure())
+        return false;
+
+    if (! this->m_si1133.start(true))
+        return false;
+
+    this->m_fBusy = true;
+    this->m_tStart = tNow;
+    this->m_tNextCheck = tNow + this->getConversionMs();
+    return true;
+    }
+
+/*
+
+Name:   McciCatena4610::cLightSensor::poll()
+
+Function:
+    Finish a light measurement, if one is ready.
+
+Definition:
+    bool McciCatena4610::cLightSensor::poll(
+            std::uint32_t tNow
+            );
+
+Description:
+    Does nothing unless a measurement is running and due. Then, if the
+    sensor has the result, it's read, the sensor is stopped and, with
+    auto-ranging, the gain for the next measurement is chosen. If the
+    result is four conversion times late, the measurement is given up.
+
+Returns:
+    true if a measurement finished on this call.
+
+*/
+
+bool cLightSensor::poll(std::uint32_t tNow)
+    {
+    if (! this->m_fBusy)
+        return false;
+
+    if (std::int32_t(tNow - this->m_tNextCheck) < 0)
+        return false;
+
+    if (! this->m_si1133.isOneTimeReady())
+        {
+        if (tNow - this->m_tStart > 4 * this->getConversionMs() + 100)
+            {
+            ++this->m_nTimeouts;
+            this->cancel();
+            }
+        else
+            this->m_tNextCheck = tNow + kPollIntervalMs;
+
+        return false;
+        }
+
+    std::uint32_t data[1];
+
+    this->m_si1133.readMultiChannelData(data, 1);
+    this->m_si1133.stop();
+    this->m_fBusy = false;
+
+    this->m_white = float(data[0]);
+    this->m_tResult = this->m_tStart;
+    this->m_fResult = true;
+    ++this->m_nMeasurements;
+
+    if (this->m_fAutoRange)
+        this->autoRange(data[0]);
+
+    return true;
+    }
+
+void cLightSensor::cancel()
+    {
+    if (this->m_fBusy)
+        {
+        this->m_si1133.stop();
+        this->m_fBusy = false;
+        }
+    }
+
+// trade conversion time for number of conversions, keeping the total
+// the same.
+void cLightSensor::autoRange(std::uint32_t raw)
+    {
+    std::uint32_t const mean = (raw << kPostShift) >> this->m_swGain;
+
+    if (mean < kRangeUp && this->m_hwGain < kHwGainMax && this->m_swGain > 0)
+        this->setGain(this->m_hwGain + 1, this->m_swGain - 1);
+    else if (mean > kRangeDown && this->m_hwGain > 0 && this->m_swGain < kSwGainMax)
+        this->setGain(this->m_hwGain - 1, this->m_swGain + 1);
+    else
+        return;
+
+    ++this->m_nRangeChanges;
+    }
@@ -0,0 +1,173 @@
+/*
+
+Module: Catena4610_cLightSensor.h
+
+Function:
+    cLightSensor: non-blocking, auto-ranging Si1133 light measurement.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cLightSensor_h_
+# define _Catena4610_cLightSensor_h_
+
+#pragma once
+
+#include <Catena_Si1133.h>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cLightSensor
+
+Description:
+    Runs one-shot white light measurements on the Si1133 without
+    waiting for them. start() begins a conversion and returns at once;
+    poll() checks for completion and reads the result. The sensor
+    isn't asked whether it's done until the conversion should be
+    complete, and then only every kPollIntervalMs, to keep I2C traffic
+    off the loop.
+
+    Each measurement is the sum of 2^swGain conversions, each of
+    which integrates for 24.4 us * 2^hwGain. With auto-ranging, after
+    each measurement hwGain is moved up in dim light, or down near
+    saturation, and swGain the other way. hwGain + swGain is constant,
+    so the measurement takes as long and the result is on the same
+    scale whatever the range, but dim light gets longer, less noisy
+    conversions, and bright light doesn't saturate them.
+
+*/
+
+class cLightSensor
+    {
+public:
+    static constexpr std::uint8_t kHwGainMax = 11;
+    static constexpr std::uint8_t kSwGainMax = 7;
+    static constexpr std::uint8_t kHwGainDefault = 4;
+    static constexpr std::uint8_t kSwGainDefault = 7;
+    static constexpr std::uint32_t kPollIntervalMs = 5;
+    // range when the mean conversion leaves these limits.
+    static constexpr std::uint32_t kRangeUp = 0x1000;
+    static constexpr std::uint32_t kRangeDown = 0xC000;
+
+    cLightSensor()
+        : m_fPresent(false)
+        , m_fBusy(false)
+        , m_fResult(false)
+        , m_fAutoRange(true)
+        , m_fReconfigure(false)
+        {}
+
+    // neither copyable nor movable
+    cLightSensor(const cLightSensor&) = delete;
+    cLightSensor& operator=(const cLightSensor&) = delete;
+    cLightSensor(const cLightSensor&&) = delete;
+    cLightSensor& operator=(const cLightSensor&&) = delete;
+
+    // find and configure the sensor; false if it's not there.
+    bool begin();
+    bool isPresent() const
+        {
+        return this->m_fPresent;
+        }
+
+    // the gain for the next measurement; out of range values are
+    // clamped.
+    void setGain(std::uint8_t hwGain, std::uint8_t swGain);
+    std::uint8_t getHwGain() const
+        {
+        return this->m_hwGain;
+        }
+    std::uint8_t getSwGain() const
+        {
+        return this->m_swGain;
+        }
+    void setAutoRange(bool fEnable)
+        {
+        this->m_fAutoRange = fEnable;
+        }
+    bool isAutoRange() const
+        {
+        return this->m_fAutoRange;
+        }
+
+    // configure the sensor again before the next measurement, as it
+    // may have lost power.
+    void reconfigure()
+        {
+        this->m_fReconfigure = true;
+        }
+
+    // start a measurement; false if there's no sensor, or one is
+    // already running.
+    bool start(std::uint32_t tNow);
+    // finish a measurement once it's ready, or give up on it if it's
+    // well overdue. Returns true when one finishes.
+    bool poll(std::uint32_t tNow);
+    // abandon the measurement in progress.
+    void cancel();
+    bool isBusy() const
+        {
+        return this->m_fBusy;
+        }
+    // how long a measurement takes at the current gain.
+    std::uint32_t getConversionMs() const;
+
+    // the last result, in raw counts, and when (millis()) it was
+    // started; false if there isn't one.
+    bool getResult(float &white, std::uint32_t &tResult) const
+        {
+        if (! this->m_fResult)
+            return false;
+
+        white = this->m_white;
+        tResult = this->m_tResult;
+        return true;
+        }
+
+    std::uint32_t getMeasurementCount() const
+        {
+        return this->m_nMeasurements;
+        }
+    std::uint32_t getRangeChangeCount() const
+        {
+        return this->m_nRangeChanges;
+        }
+    std::uint32_t getTimeoutCount() const
+        {
+        return this->m_nTimeouts;
+        }
+
+private:
+    bool configure();
+    void autoRange(std::uint32_t raw);
+
+    McciCatena::Catena_Si1133       m_si1133;
+    float                           m_white = 0.0f;
+    std::uint32_t                   m_tStart = 0;
+    std::uint32_t                   m_tResult = 0;
+    std::uint32_t                   m_tNextCheck = 0;
+    std::uint32_t                   m_nMeasurements = 0;
+    std::uint32_t                   m_nRangeChanges = 0;
+    std::uint32_t                   m_nTimeouts = 0;
+    std::uint8_t                    m_hwGain = kHwGainDefault;
+    std::uint8_t                    m_swGain = kSwGainDefault;
+
+    bool                            m_fPresent : 1;
+    bool                            m_fBusy : 1;
+    bool                            m_fResult : 1;
+    bool                            m_fAutoRange : 1;
+    // set true when the gain changed since the sensor was configured
+    bool                            m_fReconfigure : 1;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cLightSensor_h_ */
@@ -16,7 +16,6 @@ Author:
 #include "Catena4610_cMeasurementLoop.h"
 #include <arduino_lmic.h>
 #include <Catena4610_FED3.h>
-#include <Catena_Si1133.h>
 
 using namespace McciCatena4610;
 using namespace McciCatena;
@@ -25,6 +24,36 @@ extern cMeasurementLoop gMeasurementLoop;
 
 static constexpr uint8_t kVddPin = D11;
 
+/****************************************************************************\
+|
+|   The RAM report
+|
+\****************************************************************************/
+
+const cMeasurementLoop::RamComponent cMeasurementLoop::kRamReport[] =
+    {
+    { "fsm",            sizeof(cMeasurementLoop::m_fsm) },
+    { "bme280",         sizeof(cMeasurementLoop::m_BME280) },
+    { "light",          sizeof(cMeasurementLoop::m_light) },
+    { "uplink-timer",   sizeof(cMeasurementLoop::m_UplinkTimer) },
+    { "scheduler",      sizeof(cMeasurementLoop::m_uplinkScheduler) },
+    { "measurement",    sizeof(cMeasurementLoop::m_data) },
+    { "event-queues",   sizeof(cMeasurementLoop::m_ramQueues) },
+    { "fed3-devices",   sizeof(cMeasurementLoop::m_fed3Devices) },
+    { "staged-seq",     sizeof(cMeasurementLoop::m_stagedSeq) },
+    { "event-log",      sizeof(cMeasurementLoop::m_eventLog) },
+    { "log-storage",    sizeof(cMeasurementLoop::m_eventLogFlash) + sizeof(cMeasurementLoop::m_eventLogIndex) },
+    { "log-fallback",   sizeof(cMeasurementLoop::m_logFallback) },
+    { "fed3-rx",        sizeof(cMeasurementLoop::m_fed3Rx) },
+    { "fed3-frame",     sizeof(cMeasurementLoop::au8Buffer) },
+    { "traffic-gen",    sizeof(cMeasurementLoop::m_fed3Gen) },
+    { "serial-wakeup",  sizeof(cMeasurementLoop::m_serialWakeup) },
+    { "supply",         sizeof(cMeasurementLoop::m_supply) },
+    };
+
+const std::size_t cMeasurementLoop::kRamReportCount =
+    sizeof(cMeasurementLoop::kRamReport) / sizeof(cMeasurementLoop::kRamReport[0]);
+
 /****************************************************************************\
 |
 |   An object to represent the uplink activity
@@ -36,6 +65,10 @@ void cMeasurementLoop::begin()
     // register for polling.
     if (! this->m_registered)
         {
+        // settings saved by "meas" or a control downlink.
+        if (this->loadSettings())
+            gCatena.SafePrintf("measurement settings loaded from FRAM\n");
+
         this->m_registered = true;
 
         gCatena.registerObject(this);
@@ -43,6 +76,15 @@ void cMeasurementLoop::begin()
         this->m_UplinkTimer.begin(this->m_txCycleSec * 1000);
         }
 
+    this->m_supply.setReader(
+        cSupplySampler::Channel::Vbat,
+        []() { return gCatena.ReadVbat(); }
+        );
+    this->m_supply.setReader(
+        cSupplySampler::Channel::Vbus,
+        []() { return gCatena.ReadVbus(); }
+        );
+
     Wire.begin();
     if (this->m_BME280.begin(BME280_ADDRESS, Adafruit_BME280::OPERATING_MODE::Sleep))
         {
@@ -54,27 +96,45 @@ void cMeasurementLoop::begin()
         gCatena.SafePrintf("No BME280 found: check wiring\n");
         }
 
-    if (this->m_si1133.begin())
+    if (! this->m_light.begin())
+        {
+        gCatena.SafePrintf("No Si1133 found: check hardware\n");
+        }
+
+    m_prevEvent = 0;
+    for (auto &ramQueue : this->m_ramQueues)
         {
-        this->m_fSi1133 = true;
+        ramQueue.events.clear();
+        ramQueue.nBacklog = 0;
+        }
+    this->m_iTxQueue = 0;
+    this->m_logFallback.clear();
+    this->m_fTxFallback = false;
+    this->m_uplinkScheduler.begin(millis());
+    this->m_nStaged = this->m_nStagedLive = 0;
 
-        auto const measConfig =	Catena_Si1133::ChannelConfiguration_t()
-            .setAdcMux(Catena_Si1133::InputLed_t::LargeWhite)
-            .setSwGainCode(7)
-            .setHwGainCode(4)
-            .setPostShift(1)
-            .set24bit(true);
+    if (this->m_pFlash != nullptr)
+        {
+        this->m_eventLogFlash.begin(this->m_pFlash, this->m_pSPI2);
+        this->m_eventLogIndex.begin(gCatena.getFram());
+        }
 
-        this->m_si1133.configure(0, measConfig, 0);
+    if (this->m_pFlash != nullptr &&
+        this->m_eventLog.begin(&this->m_eventLogFlash, &this->m_eventLogIndex))
+        {
+        gCatena.SafePrintf(
+            "FED3 event log: %u of %u events\n",
+            unsigned(this->m_eventLog.size()),
+            unsigned(this->m_eventLog.capacity())
+            );
         }
     else
         {
-        this->m_fSi1133 = false;
-        gCatena.SafePrintf("No Si1133 found: check hardware\n");
+        gCatena.SafePrintf("No FED3 event log: events are kept in RAM\n");
         }
 
-    m_prevEvent = 0;
-    m_BufferIndex = 0;
+    // whatever survived the reset is backlog.
+    this->markBacklog();
 
     // start (or restart) the FSM.
     if (! this->m_running)
@@ -86,7 +146,8 @@ void cMeasurementLoop::begin()
     this->u16InCnt = 0;
     this->u16errCnt = 0;
     this->u8BufferSize = 0;
-    this->lastRec = 0;
+    this->m_fed3Rx.begin();
+    this->m_fDeepSleepDeferred = false;
     }
 
 void cMeasurementLoop::end()
@@ -160,9 +221,65 @@ cMeasurementLoop::fsmDispatch(
             newState = State::stInactive;
             }
         else if (this->m_UplinkTimer.isready())
+            {
+            // the uplink cycle is a heartbeat: skip it if events have
+            // been going up anyway.
+            if (millis() - this->m_uplinkScheduler.getLastUplinkTime() >= this->m_txCycleSec * 1000 / 2)
+                newState = State::stMeasure;
+            }
+        else if (this->isUplinkDue())
+            newState = State::stMeasure;
+        else if (this->isBackfillDue())
             newState = State::stMeasure;
-        else if (this->m_UplinkTimer.getRemaining() > 1500)
-            this->sleep();
+        else if (this->getSleepIntervalMs() > 1500)
+            {
+            if (! this->m_fPrintedSleeping && this->checkDeepSleep())
+                newState = State::stSleepAlert;
+            else
+                this->sleep();
+            }
+        break;
+
+    // count down to the first deep sleep, one dot a second. Everything
+    // else keeps being polled meanwhile; if anything needs doing, or
+    // deep sleep is no longer allowed, give up, and count down again
+    // next time.
+    case State::stSleepAlert:
+        if (fEntry)
+            {
+            this->doSleepAlert(true);
+            }
+
+        if (this->m_rqInactive ||
+            this->m_UplinkTimer.isready() ||
+            this->isUplinkDue() ||
+            this->isBackfillDue() ||
+            ! this->checkDeepSleep())
+            {
+            this->clearTimer();
+            this->m_fPrintedSleeping = false;
+            gCatena.SafePrintf("\n");
+            newState = State::stSleeping;
+            }
+        else if (this->timedOut())
+            {
+            if (this->m_nSleepAlert != 0)
+                {
+                gCatena.SafePrintf(".");
+                if (--this->m_nSleepAlert != 0)
+                    this->setTimer(1000);
+                else
+                    {
+                    gCatena.SafePrintf("\nStarting deep sleep.\n");
+                    this->setTimer(100);
+                    }
+                }
+            else
+                {
+                this->doDeepSleep();
+                newState = State::stSleeping;
+                }
+            }
         break;
 
     // get some data. This is only called while booting up.
@@ -177,28 +294,34 @@ cMeasurementLoop::fsmDispatch(
             newState = State::stMeasure;
         break;
 
-    // fill in the measurement
+    // fill in the measurement, unless the last one is still fresh;
+    // then go straight on to send the next of the queued events.
     case State::stMeasure:
         if (fEntry)
             {
-            // start SI1133 measurement (one-time)
-            this->m_si1133.start(true);
+            if (this->isEnvFresh())
+                {
+                newState = State::stTransmit;
+                break;
+                }
+
+            this->resetMeasurements();
             this->updateSynchronousMeasurements();
-            this->setTimer(1000);
+
+            // the light measurement started first, and has been
+            // running meanwhile; give it no more than its own time.
+            this->setTimer(this->m_light.getConversionMs() + 2 * cLightSensor::kPollIntervalMs);
             }
 
-        if (this->m_si1133.isOneTimeReady())
-            {
-            // this->updateLightMeasurements();
-            this->m_si1133.stop();
+        // a late light measurement carries on, and goes in a later
+        // uplink.
+        if (! this->m_light.isBusy())
             newState = State::stTransmit;
-            }
         else if (this->timedOut())
             {
-            this->m_si1133.stop();
             newState = State::stTransmit;
-            if (this->isTraceEnabled(this->DebugFlags::kError))
-                gCatena.SafePrintf("S1133 timed out\n");
+            if (this->isTraceEnabled(this->DebugFlags::kInfo))
+                gCatena.SafePrintf("Si1133 not ready; sending without it\n");
             }
         break;
 
@@ -207,17 +330,56 @@ cMeasurementLoop::fsmDispatch(
             {
             TxBuffer_t b;
 
-            this->fillTxBuffer(b, this->m_data);
-            this->m_FileData = this->m_data;
+            this->m_data.flags = this->m_data.flags & ~Flags::FED3;
+            this->updateLightMeasurements();
+            this->m_fTxSummary = this->m_fSummaryMode;
+
+            if (this->m_fTxSummary)
+                {
+                // the totals for the window just ended, instead of events.
+                for (auto const &device : this->m_fed3Devices)
+                    {
+                    if (! device.summary.empty())
+                        this->m_data.flags |= Flags::FED3;
+                    }
+
+                this->fillSummaryTxBuffer(b, this->m_data);
+                }
+            else if (this->m_fBatchUplinks)
+                {
+                this->stageEvents();
+
+                // take as many queued FED3 events as will fit.
+                if (! this->getTxQueue().empty())
+                    this->m_data.flags |= Flags::FED3;
 
-            this->m_FileTxBuffer.begin();
-            for (auto i = 0; i < b.getn(); ++i)
-                this->m_FileTxBuffer.put(b.getbase()[i]);
+                this->fillBatchTxBuffer(b, this->m_data, this->getTxQueue());
+                }
+            else
+                {
+                this->stageEvents();
+
+                // take the oldest FED3 event, if any.
+                this->m_nTxEvents = 0;
+                if (auto const pEvent = this->getTxQueue().peek())
+                    {
+                    this->m_data.fed3 = *pEvent;
+                    this->m_data.flags |= Flags::FED3;
+                    this->m_nTxEvents = 1;
+                    }
+
+                this->fillTxBuffer(b, this->m_data);
+                }
+            this->m_nTxBytes = std::uint8_t(b.getn());
 
             if (gLoRaWAN.IsProvisioned())
                 this->startTransmission(b);
-
-            m_BufferIndex = m_BufferIndex + 1;
+            else
+                {
+                this->markBacklog();
+                if (this->m_fTxSummary)
+                    this->restoreSentSummaries();
+                }
             }
         if (! gLoRaWAN.IsProvisioned())
             {
@@ -225,7 +387,33 @@ cMeasurementLoop::fsmDispatch(
             }
         if (this->txComplete())
             {
-            if (m_BufferIndex < m_eventCount)
+            // events leave the queue only once they've been sent.
+            if (! this->m_txerr)
+                {
+                this->m_fLinkUp = true;
+                if (! this->m_fTxSummary)
+                    this->commitSentEvents();
+                }
+            else
+                {
+                ++this->m_nUplinkFailures;
+                this->markBacklog();
+                this->m_nTxEvents = 0;
+
+                // the totals go in the next window's instead.
+                if (this->m_fTxSummary)
+                    this->restoreSentSummaries();
+                }
+
+            // backfill shares the duty cycle with everything else.
+            std::uint32_t const tAir = getUplinkAirtimeMs(this->m_nTxBytes);
+            this->m_tBackfillNext = millis() +
+                    tAir * (100 - this->m_backfillDutyCycle) / this->m_backfillDutyCycle;
+            this->m_uplinkScheduler.noteUplink(millis(), tAir, this->getLiveDepth());
+
+            // keep going while live events are due, unless none at
+            // all fit at this data rate; then wait for the next cycle.
+            if (this->m_nTxEvents != 0 && this->isUplinkDue())
                 newState = State::stMeasure;
 
             else
@@ -234,7 +422,6 @@ cMeasurementLoop::fsmDispatch(
 
                 // calculate the new sleep interval.
                 this->updateTxCycleTime();
-                this->resetMeasurements();
                 }
             }
         break;
@@ -259,16 +446,24 @@ void cMeasurementLoop::resetMeasurements()
     {
     memset((void *) &this->m_data, 0, sizeof(this->m_data));
     this->m_data.flags = Flags(0);
-    m_eventCount = 0;
-    m_BufferIndex = 0;
+    this->m_fEnvValid = false;
     }
 
 void cMeasurementLoop::updateSynchronousMeasurements()
     {
-    this->m_data.Vbat = gCatena.ReadVbat();
+    auto const tNow = millis();
+
+    this->m_tEnvSample = tNow;
+    this->m_fEnvValid = true;
+
+    // start the light measurement first, so it runs while we do the
+    // rest.
+    this->m_light.start(tNow);
+
+    this->m_data.Vbat = this->m_supply.get(cSupplySampler::Channel::Vbat, tNow);
     this->m_data.flags |= Flags::Vbat;
 
-    this->m_data.Vbus = gCatena.ReadVbus();
+    this->m_data.Vbus = this->m_supply.get(cSupplySampler::Channel::Vbus, tNow);
     this->m_data.flags |= Flags::Vbus;
 
     if (gCatena.getBootCount(this->m_data.BootCount))
@@ -287,90 +482,627 @@ void cMeasurementLoop::updateSynchronousMeasurements()
 
     }
 
+// use the latest light measurement, if it belongs with the rest.
 void cMeasurementLoop::updateLightMeasurements()
     {
-    uint32_t data[1];
+    float white;
+    std::uint32_t tResult;
 
-    this->m_si1133.readMultiChannelData(data, 1);
-    this->m_si1133.stop();
+    if (! this->m_fEnvValid || ! this->m_light.getResult(white, tResult))
+        return;
+
+    if (this->m_tEnvSample - tResult > this->m_envFreshMs)
+        return;
 
     this->m_data.flags |= Flags::Light;
-    this->m_data.light.White = (float) data[0];
+    this->m_data.light.White = white;
     }
 
 void cMeasurementLoop::updatePelletFeederData()
     {
-    uint8_t current;
+    CATENA4610_PERF_SCOPE(Fed3Rx);
 
-    // check if there is any incoming frame
-    current = Serial1.available();
+    // move whatever the UART has into the receive ring, stamping each
+    // byte as it's read. Load-test traffic comes in the same way.
+    if (this->m_fed3Gen.isActive())
+        this->m_fed3Rx.pump(this->m_fed3Gen, []() { return millis(); });
+
+    this->m_fed3Rx.pump(Serial1, []() { return millis(); });
+
+    // a late poll can find several frames waiting; take them all.
+    while (this->m_fed3Rx.isFrameReady(millis()))
+        {
+        this->num_bytes = this->getRxBuffer(this->errCode);
+
+        if (this->errCode == SUCCESS)
+            {
+            this->errCode = this->validateAnswer();
+            }
 
-    if (current == 0)
+        this->processFrame();
+        this->countFrame(this->errCode);
+        }
+    }
+
+void cMeasurementLoop::processFrame()
+    {
+    constexpr unsigned kHeaderSize = BYTE_CNT + 1;
+    constexpr unsigned kCrcSize = 2;
+
+    if (this->errCode != SUCCESS)
         return;
-    if (current != this->lastRec)
+
+    Measurement::FED3 event;
+
+    // decode straight out of the receive buffer.
+    if (this->num_bytes < kHeaderSize + kCrcSize ||
+        ! event.decode(&this->au8Buffer[kHeaderSize], this->num_bytes - kHeaderSize - kCrcSize))
+        {
+        this->u16errCnt++;
+        this->errCode = RUNT_PACKET;
+        return;
+        }
+
+    // validateAnswer() has checked the address.
+    auto const iDevice = getFed3DeviceIndex(this->au8Buffer[unsigned(SerialMessageOffset::ID)]);
+    auto const priority = this->classifyEvent(event, iDevice);
+
+    // in summary mode, the event only counts towards the totals.
+    if (this->m_fSummaryMode)
         {
-        this->lastRec = current;
-        this->u32time = millis() + kT35;
+        this->m_fed3Devices[iDevice].summary.add(event);
         return;
         }
-    if ((int32_t)(millis() - this->u32time) < 0)
+
+    // while events the log wouldn't take are waiting, this one waits
+    // behind them.
+    if (this->m_eventLog.isEnabled() && this->m_logFallback.empty())
+        {
+        bool fAppended;
+
+            {
+            CATENA4610_PERF_SCOPE(LogAppend);
+            fAppended = this->m_eventLog.append(event);
+            }
+        if (fAppended)
+            {
+            this->m_uplinkScheduler.noteEvent(millis(), priority);
+            return;
+            }
+
+        // fall back to RAM rather than lose the event.
+        if (this->isTraceEnabled(this->DebugFlags::kError))
+            gCatena.SafePrintf("FED3 event log write failed\n");
+        }
+
+    auto &queue = this->m_eventLog.isEnabled()
+                    ? this->m_logFallback
+                    : this->m_ramQueues[kEventQueues == 1 ? 0 : iDevice].events;
+
+    if (! queue.push(event))
+        {
+        if (this->isTraceEnabled(this->DebugFlags::kWarning))
+            gCatena.SafePrintf(
+                "FED3 %u event queue full: %u lost\n",
+                unsigned(kFed3AddressFirst + iDevice),
+                unsigned(queue.getDropCount())
+                );
+        }
+
+    this->m_uplinkScheduler.noteEvent(millis(), priority);
+    }
+
+// count a received frame against the FED3 it's addressed from.
+void cMeasurementLoop::countFrame(std::uint8_t errcode)
+    {
+    if (this->num_bytes == 0)
+        return;
+
+    auto const iDevice = getFed3DeviceIndex(this->au8Buffer[unsigned(SerialMessageOffset::ID)]);
+
+    if (iDevice >= kFed3Devices)
         {
+        if (errcode == INVALID_MSG_ID)
+            ++this->m_nFed3UnknownAddress;
         return;
         }
 
-    this->lastRec = 0;
+    auto &stats = this->m_fed3Devices[iDevice].stats;
+
+    switch (errcode)
+        {
+    case SUCCESS:       ++stats.nFrames; break;
+    case BAD_CRC:       ++stats.nCrcErrors; break;
+    case RUNT_PACKET:   ++stats.nRunts; break;
+    case BUFF_OVERFLOW: ++stats.nOverflows; break;
+    default:            break;
+        }
+    }
+
+std::uint32_t cMeasurementLoop::getQueuedEventCount() const
+    {
+    std::uint32_t n = 0;
+
+    for (auto const &ramQueue : this->m_ramQueues)
+        n += ramQueue.events.size();
+    return n + this->m_logFallback.size();
+    }
+
+std::uint32_t cMeasurementLoop::getEventDropCount() const
+    {
+    std::uint32_t n = 0;
+
+    for (auto const &ramQueue : this->m_ramQueues)
+        n += ramQueue.events.getDropCount();
+    return n + this->m_logFallback.getDropCount();
+    }
+
+/****************************************************************************\
+|
+|   Summary mode
+|
+\****************************************************************************/
+
+// start every FED3's window over, dropping its totals.
+void cMeasurementLoop::beginSummaryWindow()
+    {
+    auto const tNow = millis();
+
+    for (auto &device : this->m_fed3Devices)
+        {
+        device.summary.begin(tNow);
+        device.summarySent.begin(tNow);
+        }
+    }
+
+// the summary uplink failed: fold what it carried into the current
+// windows, to go with the next one.
+void cMeasurementLoop::restoreSentSummaries()
+    {
+    for (auto &device : this->m_fed3Devices)
+        {
+        device.summary.merge(device.summarySent);
+        device.summarySent.begin(device.summary.tStart);
+        }
+    }
+
+/****************************************************************************\
+|
+|   Backlog and backfill
+|
+\****************************************************************************/
+
+std::uint32_t cMeasurementLoop::getBacklogDepth() const
+    {
+    if (! this->m_eventLog.isEnabled())
+        {
+        std::uint32_t nBacklog = 0;
+
+        for (auto const &ramQueue : this->m_ramQueues)
+            {
+            auto const nQueued = ramQueue.events.size();
+
+            nBacklog += ramQueue.nBacklog < nQueued ? ramQueue.nBacklog : nQueued;
+            }
+        return nBacklog;
+        }
+
+    return this->m_eventLog.size() - this->getLoggedLiveDepth();
+    }
+
+std::uint32_t cMeasurementLoop::getLiveDepth() const
+    {
+    if (! this->m_eventLog.isEnabled())
+        return this->getQueuedEventCount() - this->getBacklogDepth();
+
+    // those the log wouldn't take are live too.
+    return this->getLoggedLiveDepth() + this->m_logFallback.size();
+    }
+
+// with the flash log: the live events in it.
+std::uint32_t cMeasurementLoop::getLoggedLiveDepth() const
+    {
+    std::uint32_t nLive = this->m_eventLog.getEnd() - this->m_liveFirst;
+
+    // if a full log dropped the backlog, and then some, all that's
+    // left is live.
+    if (nLive > this->m_eventLog.getEnd() - this->m_eventLog.getFirst())
+        nLive = this->m_eventLog.getEnd() - this->m_eventLog.getFirst();
+    if (nLive > this->m_eventLog.size())
+        nLive = this->m_eventLog.size();
+    return nLive;
+    }
+
+bool cMeasurementLoop::isBackfillDue() const
+    {
+    return ! this->m_fSummaryMode &&
+           this->m_fLinkUp &&
+           std::int32_t(millis() - this->m_tBackfillNext) >= 0 &&
+           this->getBacklogDepth() != 0;
+    }
+
+/****************************************************************************\
+|
+|   Uplink scheduling
+|
+\****************************************************************************/
+
+// pellets need to reach the server quickly; pokes can wait. A change
+// of session type on a FED3 is high priority, but its first event
+// after boot can't be a change.
+cUplinkScheduler::Priority cMeasurementLoop::classifyEvent(const Fed3Event &event, std::uint8_t iDevice)
+    {
+    auto &device = this->m_fed3Devices[iDevice];
+    auto priority = this->getFed3EventPriority(event.EventActive);
+
+    if (this->m_fSessionChangeHigh &&
+        device.fHaveSessionType &&
+        event.SessionType != device.lastSessionType)
+        priority = cUplinkScheduler::Priority::High;
+
+    device.lastSessionType = event.SessionType;
+    device.fHaveSessionType = true;
+    return priority;
+    }
+
+// roughly how many FED3 events fit in an uplink at the current data
+// rate: mostly deltas, with a full record every m_nKeyframeInterval.
+std::uint32_t cMeasurementLoop::getEventsPerUplink() const
+    {
+    if (! this->m_fBatchUplinks)
+        return 1;
+
+    std::size_t nMax = getMaxUplinkSize();
+    if (nMax > MeasurementFormat::kTxBufferSize)
+        nMax = MeasurementFormat::kTxBufferSize;
+
+    std::size_t const k = this->m_nKeyframeInterval ? this->m_nKeyframeInterval : 1;
+    std::size_t const nPerEvent = 1 + (Fed3Event::kWireSize + (k - 1) * Fed3Event::kDeltaSize) / k;
+
+    if (nMax < MeasurementFormat::kTxHeaderSizeMax + 2 * nPerEvent)
+        return 1;
+
+    return std::uint32_t((nMax - MeasurementFormat::kTxHeaderSizeMax) / nPerEvent);
+    }
+
+// how long until the live events should go up; see cUplinkScheduler.
+// In summary mode, only the uplink cycle sends anything.
+std::uint32_t cMeasurementLoop::getUplinkDelayMs() const
+    {
+    std::uint32_t const nLive = this->getLiveDepth();
+
+    if (nLive == 0 || this->m_fSummaryMode)
+        return cUplinkScheduler::kNever;
+
+    std::uint32_t const nPerUplink = this->getEventsPerUplink();
+    std::uint32_t const nSend = nLive < nPerUplink ? nLive : nPerUplink;
+    std::size_t nBytes = MeasurementFormat::kTxHeaderSizeMax + nSend * (1 + Fed3Event::kDeltaSize);
+
+    if (nBytes > getMaxUplinkSize())
+        nBytes = getMaxUplinkSize();
+
+    return this->m_uplinkScheduler.getDelayMs(
+        millis(), nLive, nPerUplink, getUplinkAirtimeMs(nBytes)
+        );
+    }
+
+// how long we can sleep: until the next uplink cycle, or until the
+// live events are due, whichever is sooner.
+std::uint32_t cMeasurementLoop::getSleepIntervalMs()
+    {
+    std::uint32_t const msCycle = this->m_UplinkTimer.getRemaining();
+    std::uint32_t const msEvents = this->getUplinkDelayMs();
+
+    return msEvents < msCycle ? msEvents : msCycle;
+    }
+
+// everything waiting now missed its uplink.
+void cMeasurementLoop::markBacklog()
+    {
+    this->m_fLinkUp = false;
+    for (auto &ramQueue : this->m_ramQueues)
+        ramQueue.nBacklog = ramQueue.events.size();
+    this->m_liveFirst = this->m_backfillCursor = this->m_eventLog.getEnd();
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::stageEvents()
+
+Function:
+    Choose the FED3 events for the next uplink.
+
+Definition:
+    void McciCatena4610::cMeasurementLoop::stageEvents(
+            void
+            );
+
+Description:
+    Each uplink carries events from one FED3, so that batches
+    compress well, and the FED3s take turns.
+
+    Without the flash log, the RAM queues already hold everything
+    waiting, oldest first. With a queue per FED3, the next FED3 after
+    the last one sent that has any events is chosen, and its queue is
+    used as it stands; with one queue, it's shared, and an uplink may
+    carry events from several FED3s.
+
+    With the log, the first queue is refilled from it: first the live
+    events, oldest first, then, if backfill is due, backlogged events
+    in the chosen order. Their sequence numbers are kept in
+    m_stagedSeq[] so that commitSentEvents() can consume them from the
+    log once they've been sent. With several FED3s, only the events of
+    one are staged (see isStagedDevice()); the live events passed over
+    stay live.
+
+    Events the log wouldn't take are newer than any in it. They are
+    offered to it again first. If it still won't take them, they are
+    sent straight from m_logFallback once nothing in the log is left
+    to stage, so they aren't held up for good by a failing flash.
+
+    Corrupt records can never be sent, so they are consumed when found.
+    The number of records looked at is limited, so that a long run of
+    consumed records can't stall the uplink; newest-first backfill
+    keeps its place in m_backfillCursor.
 
-    this->num_bytes = this->getRxBuffer(this->errCode);
+*/
 
-    if (this->errCode == SUCCESS)
+void cMeasurementLoop::stageEvents()
+    {
+    if (! this->m_eventLog.isEnabled())
         {
-        this->errCode = this->validateAnswer();
+        this->chooseTxDevice();
+        return;
         }
 
-    if (this->errCode == SUCCESS)        
+    cEventLog &log = this->m_eventLog;
+    this->m_iTxQueue = 0;
+    this->m_fTxFallback = false;
+    EventQueue_t &queue = this->getTxQueue();
+    unsigned nScan = 4 * kEventQueueDepth;
+
+    log.flush();
+    queue.clear();
+    this->m_nStaged = this->m_nStagedLive = 0;
+    this->m_fHaveStagedDevice = false;
+    this->m_fStagedDeviceTentative = false;
+    this->m_fLiveSkipped = false;
+
+    bool const fFallback = ! this->retryLogFallback();
+
+    if (! log.contains(this->m_liveFirst) && this->m_liveFirst != log.getEnd())
+        this->m_liveFirst = log.getFirst();
+
+    // while the events are only from the FED3 sent last time, keep
+    // looking for another one's.
+    for (auto seq = this->m_liveFirst;
+         seq != log.getEnd() && (! queue.full() || this->m_fStagedDeviceTentative) && nScan > 0;
+         ++seq, --nScan)
+        this->stageLoggedEvent(seq, true);
+
+    this->m_nStagedLive = this->m_nStaged;
+    this->m_fStagedDeviceTentative = false;
+
+    if (this->isBackfillDue())
         {
-        if (m_eventCount > 9)
+        if (this->m_backfillOrder == BackfillOrder::OldestFirst)
+            {
+            for (auto seq = log.getFirst();
+                 seq != this->m_liveFirst && ! queue.full() && nScan > 0;
+                 ++seq, --nScan)
+                this->stageLoggedEvent(seq, false);
+            }
+        else
             {
-            for (uint8_t nIndex = 0; nIndex <= this->num_bytes; ++nIndex)
+            // the cursor must lie in [first, liveFirst].
+            if (this->m_backfillCursor - log.getFirst() > this->m_liveFirst - log.getFirst())
+                this->m_backfillCursor = this->m_liveFirst;
+
+            for (auto seq = this->m_backfillCursor;
+                 seq != log.getFirst() && ! queue.full() && nScan > 0;
+                 --seq, --nScan)
                 {
-                m_data.fed3.DataBytes[m_eventCount - 10][nIndex] = m_data.fed3.DataBytes[m_eventCount - 9][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 9][nIndex] = m_data.fed3.DataBytes[m_eventCount - 8][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 8][nIndex] = m_data.fed3.DataBytes[m_eventCount - 7][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 7][nIndex] = m_data.fed3.DataBytes[m_eventCount - 6][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 6][nIndex] = m_data.fed3.DataBytes[m_eventCount - 5][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 5][nIndex] = m_data.fed3.DataBytes[m_eventCount - 4][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 4][nIndex] = m_data.fed3.DataBytes[m_eventCount - 3][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 3][nIndex] = m_data.fed3.DataBytes[m_eventCount - 2][nIndex];
-                m_data.fed3.DataBytes[m_eventCount - 2][nIndex] = m_data.fed3.DataBytes[m_eventCount - 1][nIndex];
+                // skip past consumed records for good.
+                if (this->stageLoggedEvent(seq - 1, false) == cEventLog::ReadStatus::Consumed &&
+                    seq == this->m_backfillCursor)
+                    this->m_backfillCursor = seq - 1;
                 }
-            m_eventCount = 9;
             }
-        for (uint8_t nIndex = 1; nIndex <= this->num_bytes; ++nIndex)
+        }
+
+    if (this->m_fHaveStagedDevice && this->m_nStaged != 0)
+        {
+        this->m_txDeviceNumber = this->m_stagedDeviceNumber;
+        this->m_fHaveTxDeviceNumber = true;
+        }
+
+    // once the older events in the log are sent, send the rest from
+    // RAM; the flash is failing, and they'd never go otherwise.
+    if (fFallback && this->m_nStaged == 0)
+        this->m_fTxFallback = true;
+    }
+
+cEventLog::ReadStatus cMeasurementLoop::stageLoggedEvent(std::uint32_t seq, bool fLive)
+    {
+    Measurement::FED3 event;
+    auto const status = this->m_eventLog.read(seq, event);
+
+    if (status == cEventLog::ReadStatus::Ok)
+        {
+        EventQueue_t &queue = this->getTxQueue();
+
+        if (this->isStagedDevice(event, fLive) && ! queue.full())
             {
-            m_data.fed3.DataBytes[m_eventCount][nIndex - 1] = this->au8Buffer[nIndex + BYTE_CNT];
+            this->m_stagedSeq[this->m_nStaged++] = seq;
+            queue.push(event);
             }
-        if (m_eventCount <= 9)
+        else if (fLive && ! this->m_fLiveSkipped)
             {
-            m_eventCount += 1;
+            this->m_fLiveSkipped = true;
+            this->m_liveSkipped = seq;
             }
-        this->m_data.flags |= Flags::FED3;
         }
+    else if (status == cEventLog::ReadStatus::Corrupt)
+        {
+        if (this->isTraceEnabled(this->DebugFlags::kWarning))
+            gCatena.SafePrintf("FED3 event log: discarding corrupt record %u\n", unsigned(seq));
+        this->m_eventLog.consume(seq);
+        }
+
+    return status;
     }
 
-uint8_t cMeasurementLoop::getRxBuffer(uint8_t &errcode)
-{
-    boolean bBuffOverflow = false;
+/*
 
-    this->u8BufferSize = 0;
-    while ( Serial1.available() )
+Name:   McciCatena4610::cMeasurementLoop::isStagedDevice()
+
+Function:
+    Decide whether a logged event is from the FED3 being staged.
+
+Definition:
+    bool McciCatena4610::cMeasurementLoop::isStagedDevice(
+            const Fed3Event &event,
+            bool fLive
+            );
+
+Description:
+    The log doesn't record bus addresses, so FED3s are told apart by
+    their device numbers; these must differ anyway, as they're all the
+    server has to go on.
+
+    The first event staged chooses the FED3. If it's a live event from
+    the FED3 that was sent last time, the choice is only tentative:
+    should a live event from another FED3 turn up, that FED3 is
+    chosen instead, and the events staged so far are put back, to go
+    in a later uplink. So each waiting FED3 gets its turn, oldest
+    first.
+
+    With only one FED3, every event is staged.
+
+Returns:
+    true if the event should be staged.
+
+*/
+
+bool cMeasurementLoop::isStagedDevice(const Fed3Event &event, bool fLive)
+    {
+    if (kFed3Devices == 1)
+        return true;
+
+    if (! this->m_fHaveStagedDevice)
         {
-        if (this->u8BufferSize >= sizeof(this->au8Buffer))
-            bBuffOverflow = true;
-        else
+        this->m_fHaveStagedDevice = true;
+        this->m_stagedDeviceNumber = event.DeviceNumber;
+        this->m_fStagedDeviceTentative =
+            fLive &&
+            this->m_fHaveTxDeviceNumber &&
+            event.DeviceNumber == this->m_txDeviceNumber;
+        return true;
+        }
+
+    if (event.DeviceNumber == this->m_stagedDeviceNumber)
+        return true;
+
+    if (! (fLive && this->m_fStagedDeviceTentative))
+        return false;
+
+    // another FED3 is waiting: it goes first.
+    this->m_fLiveSkipped = true;
+    this->m_liveSkipped = this->m_stagedSeq[0];
+    this->getTxQueue().clear();
+    this->m_nStaged = 0;
+    this->m_stagedDeviceNumber = event.DeviceNumber;
+    this->m_fStagedDeviceTentative = false;
+    return true;
+    }
+
+// move the events the log wouldn't take into it, oldest first; true
+// if they're all in.
+bool cMeasurementLoop::retryLogFallback()
+    {
+    for (Fed3Event const *pEvent; (pEvent = this->m_logFallback.peek()) != nullptr; )
+        {
+        if (! this->m_eventLog.append(*pEvent))
+            return false;
+        this->m_logFallback.pop();
+        }
+
+    return true;
+    }
+
+// without the flash log: the queues with events waiting take turns.
+void cMeasurementLoop::chooseTxDevice()
+    {
+    for (unsigned i = 1; i <= kEventQueues; ++i)
+        {
+        std::uint8_t const iQueue = std::uint8_t((this->m_iTxQueue + i) % kEventQueues);
+
+        if (! this->m_ramQueues[iQueue].events.empty())
             {
-            this->au8Buffer[ this->u8BufferSize++ ] = Serial1.read();
+            this->m_iTxQueue = iQueue;
+            return;
             }
         }
+    }
+
+// the first m_nTxEvents events in the uplink queue were sent.
+void cMeasurementLoop::commitSentEvents()
+    {
+    std::uint32_t const nSent = this->m_nTxEvents;
+    std::uint32_t nBackfill;
+
+    if (this->m_fTxFallback)
+        {
+        // they never reached the log, and were live.
+        nBackfill = 0;
+        }
+    else if (this->m_eventLog.isEnabled())
+        {
+        std::uint32_t const liveFirst = this->m_liveFirst;
+
+        nBackfill = 0;
+
+        for (std::uint32_t i = 0; i < nSent && i < this->m_nStaged; ++i)
+            {
+            this->m_eventLog.consume(this->m_stagedSeq[i]);
+
+            if (i < this->m_nStagedLive)
+                this->m_liveFirst = this->m_stagedSeq[i] + 1;
+            else
+                ++nBackfill;
+            }
+
+        // live events passed over in staging are still live.
+        if (this->m_fLiveSkipped &&
+            this->m_liveFirst - liveFirst > this->m_liveSkipped - liveFirst)
+            this->m_liveFirst = this->m_liveSkipped;
+        }
+    else
+        {
+        auto &ramQueue = this->m_ramQueues[this->m_iTxQueue];
+        auto const nQueued = ramQueue.events.size();
+
+        nBackfill = ramQueue.nBacklog < nQueued ? ramQueue.nBacklog : nQueued;
+        if (nBackfill > nSent)
+            nBackfill = nSent;
+        ramQueue.nBacklog -= nBackfill;
+        }
+
+    for (std::uint32_t i = 0; i < nSent; ++i)
+        this->getTxQueue().pop();
+
+    this->m_nBackfillSent += nBackfill;
+    }
+
+uint8_t cMeasurementLoop::getRxBuffer(uint8_t &errcode)
+{
+    bool bBuffOverflow = false;
+
+    this->u8BufferSize = 0;
+    this->m_fed3Rx.readFrame(
+        this->au8Buffer, sizeof(this->au8Buffer),
+        this->u8BufferSize, bBuffOverflow
+        );
     this->u16InCnt++;
 
     if (bBuffOverflow)
@@ -392,26 +1124,11 @@ uint16_t cMeasurementLoop::getMessageWord(unsigned offset)
 
 uint16_t cMeasurementLoop::calcCRC(uint8_t u8length)
 {
-    unsigned int temp, temp2, flag;
-    temp = 0xFFFF;
-    for (unsigned char i = 0; i < u8length; i++)
-    {
-        temp = temp ^ this->au8Buffer[i];
-        for (unsigned char j = 1; j <= 8; j++)
-        {
-            flag = temp & 0x0001;
-            temp >>=1;
-            if (flag)
-                temp ^= 0xA001;
-        }
-    }
-    // Reverse byte order.
-    temp2 = temp >> 8;
-    temp = (temp << 8) | temp2;
-    temp &= 0xFFFF;
+    uint16_t const crc = cCrc16Modbus::compute(this->au8Buffer, u8length);
+
     // the returned value is already swapped
     // crcLo byte is first & crcHi byte is last
-    return temp;
+    return uint16_t((crc << 8) | (crc >> 8));
 }
 
 uint8_t cMeasurementLoop::validateAnswer()
@@ -421,18 +1138,17 @@ uint8_t cMeasurementLoop::validateAnswer()
         this->u16errCnt ++;
         return RUNT_PACKET;
     }
-    // check message crc vs calculated crc
-    uint16_t u16MsgCRC = this->getMessageWord(this->u8BufferSize - 2);
-
-    if ( this->calcCRC( this->u8BufferSize-2 ) != u16MsgCRC )
+    // the receiver ran the CRC over the frame as it arrived; a good
+    // frame leaves a zero residue.
+    if (! this->m_fed3Rx.isLastFrameCrcGood())
         {
         this->u16errCnt ++;
         gCatena.SafePrintf("CRC: %d\n", this->au8Buffer[unsigned(SerialMessageOffset::ID)]);
         return BAD_CRC;
         }
 
-    // check exception
-    if (this->au8Buffer[ unsigned(SerialMessageOffset::ID) ] != 0x01)
+    // the ID is the address of the FED3 that sent it.
+    if (getFed3DeviceIndex(this->au8Buffer[unsigned(SerialMessageOffset::ID)]) >= kFed3Devices)
         {
         this->u16errCnt ++;
         gCatena.SafePrintf("Message ID: %d\n", this->au8Buffer[unsigned(SerialMessageOffset::ID)]);
@@ -486,6 +1202,98 @@ void cMeasurementLoop::startTransmission(
         }
     }
 
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::getMaxUplinkSize()
+
+Function:
+    Return the largest application payload allowed at the current
+    data rate.
+
+Definition:
+    static std::size_t McciCatena4610::cMeasurementLoop::getMaxUplinkSize(
+            void
+            );
+
+Description:
+    The limits are the regional parameters' maximum application payload
+    with no FOpts, for the regions the Catena 4610 ships for. Unknown
+    regions and data rates get the smallest limit common to all of
+    them.
+
+*/
+
+std::size_t cMeasurementLoop::getMaxUplinkSize()
+    {
+    auto const dr = LMIC.datarate;
+
+#if defined(CFG_us915)
+    static const std::uint8_t kMaxPayload[] = { 11, 53, 125, 242, 242 };
+#elif defined(CFG_au915)
+    static const std::uint8_t kMaxPayload[] = { 51, 51, 51, 115, 242, 242, 242 };
+#else
+    // EU868, AS923, IN866, KR920 (222 allows for a repeater)
+    static const std::uint8_t kMaxPayload[] = { 51, 51, 51, 115, 222, 222 };
+#endif
+
+    if (dr < sizeof(kMaxPayload))
+        return kMaxPayload[dr];
+    else
+        return 51;
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::getUplinkAirtimeMs()
+
+Function:
+    Estimate the air time of an uplink at the current data rate.
+
+Definition:
+    static std::uint32_t McciCatena4610::cMeasurementLoop::getUplinkAirtimeMs(
+            std::size_t nPayload
+            );
+
+Description:
+    The LoRa time-on-air formula is applied to the application payload
+    plus 13 bytes of LoRaWAN overhead, with an 8-symbol preamble,
+    explicit header, CRC and coding rate 4/5. Unknown data rates are
+    taken to be the slowest.
+
+Returns:
+    Air time in milliseconds, rounded up.
+
+*/
+
+std::uint32_t cMeasurementLoop::getUplinkAirtimeMs(std::size_t nPayload)
+    {
+    // spreading factor, and bandwidth as 125 kHz << bw
+    struct DataRate { std::uint8_t sf; std::uint8_t bw; };
+
+#if defined(CFG_us915)
+    static const DataRate kDataRate[] = { {10,0}, {9,0}, {8,0}, {7,0}, {8,2} };
+#elif defined(CFG_au915)
+    static const DataRate kDataRate[] = { {12,0}, {11,0}, {10,0}, {9,0}, {8,0}, {7,0}, {8,2} };
+#else
+    static const DataRate kDataRate[] = { {12,0}, {11,0}, {10,0}, {9,0}, {8,0}, {7,0} };
+#endif
+
+    auto const dr = LMIC.datarate;
+    DataRate const r = kDataRate[dr < sizeof(kDataRate) / sizeof(kDataRate[0]) ? dr : 0];
+
+    // symbol time in microseconds: 2^sf / (125 kHz << bw)
+    std::uint32_t const tSym = (std::uint32_t(8) << r.sf) >> r.bw;
+    // low data rate optimization
+    std::int32_t const de = (r.sf >= 11 && r.bw == 0) ? 1 : 0;
+    std::int32_t const pl = std::int32_t(nPayload) + 13;
+    std::int32_t const num = 8 * pl - 4 * r.sf + 28 + 16;
+    std::int32_t const den = 4 * (r.sf - 2 * de);
+    std::uint32_t const nSym = 8 + (num > 0 ? (num + den - 1) / den * 5 : 0);
+
+    // 12.25 symbols of preamble
+    return (49 * tSym / 4 + nSym * tSym + 999) / 1000;
+    }
+
 void cMeasurementLoop::sendBufferDone(bool fSuccess)
     {
     this->m_txpending = false;
@@ -502,6 +1310,7 @@ void cMeasurementLoop::sendBufferDone(bool fSuccess)
 
 void cMeasurementLoop::poll()
     {
+    CATENA4610_PERF_SCOPE(Poll);
     bool fEvent;
 
     // no need to evaluate unless something happens.
@@ -535,11 +1344,34 @@ void cMeasurementLoop::poll()
         fEvent = true;
         }
 
+    if (this->isBackfillDue())
+        fEvent = true;
+
+    if (this->isUplinkDue())
+        fEvent = true;
+
+    if (this->m_light.poll(millis()))
+        fEvent = true;
+
+    // try again to deep sleep once the FED3 is quiet.
+    if (this->m_fDeepSleepDeferred && ! this->isFed3Busy())
+        {
+        this->m_fDeepSleepDeferred = false;
+        fEvent = true;
+        }
+
     if (fEvent)
+        {
+        CATENA4610_PERF_SCOPE(FsmEval);
         this->m_fsm.eval();
+        }
 
-    this->m_data.Vbus = gCatena.ReadVbus();
-    setVbus(this->m_data.Vbus);
+    // only does an ADC conversion when a sample is due.
+        {
+        CATENA4610_PERF_SCOPE(Supply);
+        this->m_supply.poll(millis());
+        }
+    setVbus(this->m_supply.peek(cSupplySampler::Channel::Vbus));
     }
 
 /****************************************************************************\
@@ -552,6 +1384,10 @@ void cMeasurementLoop::updateTxCycleTime()
     {
     auto txCycleCount = this->m_txCycleCount;
 
+    // in summary mode, the cycle is the window; see applySettings().
+    if (this->m_fSummaryMode)
+        return;
+
     // update the sleep parameters
     if (txCycleCount > 1)
             {
@@ -567,7 +1403,13 @@ void cMeasurementLoop::updateTxCycleTime()
             }
     else
             {
-            // it's zero. Leave it alone.
+            // it's zero. Stretch the cycle while the FED3 is idle.
+            std::uint32_t const txCycleSec =
+                this->m_uplinkScheduler.isIdle(millis()) ? this->m_txCycleSec_Idle
+                                                         : this->m_txCycleSec_Permanent;
+
+            if (txCycleSec != this->m_txCycleSec)
+                this->setTxCycleTime(txCycleSec, 0);
             }
     }
 
@@ -588,21 +1430,23 @@ void cMeasurementLoop::sleep()
             this->doDeepSleep();
     }
 
-// for now, we simply don't allow deep sleep. In the future might want to
-// use interrupts on activity to wake us up; then go back to sleep when we've
-// seen nothing for a while.
+// deep sleep is only allowed if the FED3 can wake us; see cSerialWakeup.
 bool cMeasurementLoop::checkDeepSleep()
     {
     bool const fDeepSleepTest = gCatena.GetOperatingFlags() &
                     static_cast<uint32_t>(gCatena.OPERATING_FLAGS::fDeepSleepTest);
     bool fDeepSleep;
-    std::uint32_t const sleepInterval = this->m_UplinkTimer.getRemaining() / 1000;
+    std::uint32_t const sleepInterval = this->getSleepIntervalMs() / 1000;
 
-    if (! this->kEnableDeepSleep)
+    if (! this->kEnableDeepSleep || ! this->m_serialWakeup.isEnabled())
         {
         return false;
         }
 
+    // backfill runs on its own schedule.
+    if (this->m_fLinkUp && this->getBacklogDepth() != 0)
+        return false;
+
     if (sleepInterval < 2)
         fDeepSleep = false;
     else if (fDeepSleepTest)
@@ -652,27 +1496,10 @@ void cMeasurementLoop::doSleepAlert(bool fDeepSleep)
                             deepSleepDelay
                             );
 
-        // sleep and print
+        // stSleepAlert prints a dot each second, then sleeps.
         gLed.Set(McciCatena::LedPattern::TwoShort);
-
-        for (auto n = deepSleepDelay; n > 0; --n)
-            {
-            uint32_t tNow = millis();
-
-            while (uint32_t(millis() - tNow) < 1000)
-                {
-                gCatena.poll();
-                yield();
-                }
-            gCatena.SafePrintf(".");
-            }
-        gCatena.SafePrintf("\nStarting deep sleep.\n");
-        uint32_t tNow = millis();
-        while (uint32_t(millis() - tNow) < 100)
-            {
-            gCatena.poll();
-            yield();
-            }
+        this->m_nSleepAlert = std::uint8_t(deepSleepDelay);
+        this->setTimer(1000);
         }
     else
         gCatena.SafePrintf("using light sleep\n");
@@ -680,27 +1507,77 @@ void cMeasurementLoop::doSleepAlert(bool fDeepSleep)
 
 void cMeasurementLoop::doDeepSleep()
     {
-    std::uint32_t const sleepInterval = this->m_UplinkTimer.getRemaining() / 1000;
+    std::uint32_t const sleepInterval = this->getSleepIntervalMs() / 1000;
 
     if (sleepInterval == 0)
         return;
 
+    // don't sleep part way through a FED3 frame: the rest would be
+    // timestamped after we woke, and taken for a new frame. poll()
+    // tries again once the line is quiet.
+    if (this->isFed3Busy())
+        {
+        this->m_fDeepSleepDeferred = true;
+        return;
+        }
+
     /* ok... now it's time for a deep sleep */
     gLed.Set(McciCatena::LedPattern::Off);
+    CATENA4610_PERF_CANCEL();
     this->deepSleepPrepare();
 
-    /* sleep */
-    gCatena.Sleep(sleepInterval);
+    /*
+    || sleep a second at a time. The USART keeps receiving while we're
+    || stopped, and each byte wakes us briefly; if the FED3 has sent
+    || anything, stop sleeping and go deal with it.
+    */
+    std::uint32_t const tSleep = millis();
+    bool fSerialWake = false;
+
+    for (std::uint32_t n = sleepInterval; n != 0; --n)
+        {
+        gCatena.Sleep(1);
+        if (Serial1.available() > 0)
+            {
+            fSerialWake = true;
+            break;
+            }
+        }
 
     /* recover from sleep */
     this->deepSleepRecovery();
 
+    ++this->m_nDeepSleeps;
+    this->m_msDeepSleep += millis() - tSleep;
+    if (fSerialWake)
+        {
+        ++this->m_nSerialWakes;
+        this->m_tSerialWake = millis();
+        }
+
     /* and now... we're awake again. trigger another measurement */
     this->m_fsm.eval();
     }
 
+// true if a FED3 frame is arriving (or being generated), or we were
+// woken by the FED3 very recently.
+bool cMeasurementLoop::isFed3Busy()
+    {
+    return ! this->m_fed3Rx.isIdle() ||
+           this->m_fed3Gen.isActive() ||
+           Serial1.available() > 0 ||
+           millis() - this->m_tSerialWake < kSerialWakeHoldMs;
+    }
+
 void cMeasurementLoop::deepSleepPrepare(void)
     {
+    // buffered events don't survive a deep sleep.
+    this->m_eventLog.flush();
+
+    this->m_light.cancel();
+
+    // Serial1 is left running: it receives in STOP mode, and wakes us.
+
     pinMode(kVddPin, INPUT);
 
     Serial.end();
@@ -723,6 +1600,9 @@ void cMeasurementLoop::deepSleepRecovery(void)
     SPI.begin();
     //if (this->m_pSPI2)
     //    this->m_pSPI2->begin();
+
+    // the sensors were unpowered.
+    this->m_light.reconfigure();
     }
 
 /****************************************************************************\
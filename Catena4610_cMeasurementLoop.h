@@ -27,13 +27,26 @@ Author:
 #include <Catena_Log.h>
 #include <Catena_Mx25v8035f.h>
 #include <Catena_PollableInterface.h>
-#include <Catena_Si1133.h>
 #include <Catena_Timer.h>
 #include <Catena_TxBuffer.h>
 #include <Catena.h>
 #include <mcciadk_baselib.h>
 #include <stdlib.h>
 #include <Catena_Date.h>
+#include "Catena4610_cEventLog.h"
+#include "Catena4610_cEventLogStorage.h"
+#include "Catena4610_cFed3Receiver.h"
+#include "Catena4610_cFed3TrafficGen.h"
+#include "Catena4610_cLightSensor.h"
+#include "Catena4610_cPerf.h"
+#include "Catena4610_cRingQueue.h"
+#include "Catena4610_cSerialWakeup.h"
+#include "Catena4610_cSupplySampler.h"
+#include "Catena4610_cUplinkBuffer.h"
+#include "Catena4610_cUplinkScheduler.h"
+#include "Catena4610_Fed3Event.h"
+#include "Catena4610_Fed3Summary.h"
+#include "Catena4610_MessageSchema.h"
 
 #include <cstdint>
 #include <cstring>
@@ -42,46 +55,33 @@ extern McciCatena::Catena gCatena;
 extern McciCatena::Catena::LoRaWAN gLoRaWAN;
 extern McciCatena::StatusLed gLed;
 
+// number of FED3 events held in RAM. Each costs sizeof(Fed3Event), plus
+// a 4-byte sequence number when the flash log is used; set this from the
+// build to trade queue depth against RAM. "meas ram" shows the result.
+#ifndef CATENA4610_EVENT_QUEUE_DEPTH
+# define CATENA4610_EVENT_QUEUE_DEPTH 10
+#endif
+
+// number of FED3s sharing the serial bus, at addresses 1 to N (the ID
+// byte of their frames).
+#ifndef CATENA4610_FED3_DEVICES
+# define CATENA4610_FED3_DEVICES 1
+#endif
+
+// with the flash log, events wait in the log, and a single queue of
+// CATENA4610_EVENT_QUEUE_DEPTH events stages the next uplink; without
+// it, that queue is shared by all the FED3s. Set this to 1 for a build
+// that runs without the flash, to give each FED3 a queue of its own.
+#ifndef CATENA4610_EVENT_QUEUE_PER_FED3
+# define CATENA4610_EVENT_QUEUE_PER_FED3 0
+#endif
+
 #define SUCCESS         0
 #define BUFF_OVERFLOW   1
 #define RUNT_PACKET     2
 #define BAD_CRC         3
 #define INVALID_MSG_ID  4
 
-static constexpr unsigned kT35 = 5;
-
-static const char* sessionType[] = {
-        "Custom_Application",
-        "ClassicFED3",
-        "ClosedEconomy_PR1",
-        "Dispenser",
-        "Extinction",
-        "FixedRatio1",
-        "FR_Customizable",
-        "FreeFeeding",
-        "MenuExample",
-        "Optogenetic_Self_Stim",
-        "Pavlovian",
-        "ProbReversalTask",
-        "ProgressiveRatio",
-        "RandomRatio"
-        };
-
-static const char* eventActive[] = {
-        "Unknown",
-        "Left",
-        "LeftShort",
-        "LeftWithPellet",
-        "LeftinTimeout",
-        "LeftDuringDispense",
-        "Right",
-        "RightShort",
-        "RightWithPellet",
-        "RightinTimeout",
-        "RightDuringDispense",
-        "Pellet"
-        };
-
 namespace McciCatena4610 {
 
 /****************************************************************************\
@@ -99,6 +99,16 @@ class cMeasurementFormat : public cMeasurementBase
     {
 public:
     static constexpr uint8_t kMessageFormat = 0x24;
+    static constexpr uint8_t kMessageFormatBatch = 0x25;
+    static constexpr uint8_t kMessageFormatSummary = 0x26;
+
+    // each FED3 record in a format 0x25 message starts with one of these
+    enum class BatchRecord : uint8_t
+            {
+            Full = 0,           // Fed3Event::kWireSize bytes follow
+            Delta = 1,          // Fed3Event::kDeltaSize bytes follow
+            Varint = 2,         // a Fed3Event::encodeVarintDelta() record follows
+            };
 
     enum class Flags : uint8_t
             {
@@ -111,8 +121,22 @@ public:
             FED3 = 1 << 6,      // pellet feeder 3 data
             };
 
-    // buffer size for uplink data
-    static constexpr size_t kTxBufferSize = 54;
+    // the fields this sketch ever sends: everything but Vcc.
+    static constexpr uint8_t kFlagsSent =
+        uint8_t(Flags::Vbat) | uint8_t(Flags::Vbus) | uint8_t(Flags::Boot) |
+        uint8_t(Flags::TPH) | uint8_t(Flags::Light) | uint8_t(Flags::FED3);
+
+    // buffer size for uplink data. Batches are further limited by the
+    // current data rate.
+    static constexpr size_t kTxBufferSize = 128;
+    static_assert(
+        MessageSchema::messageSize(kFlagsSent) <= kTxBufferSize,
+        "a single-event message must fit in the buffer"
+        );
+    // the most that goes before the FED3 records in format 0x25: the
+    // format 0x24 header and fields without FED3, then the count.
+    static constexpr size_t kTxHeaderSizeMax =
+        MessageSchema::messageSize(kFlagsSent & ~uint8_t(Flags::FED3)) + 1;
 
     // the structure of a measurement
     struct Measurement
@@ -126,7 +150,7 @@ public:
             {
             // temperature (in degrees C)
             float                   Temperature;
-            // pressure (in millibars/hPa)
+            // pressure (in Pa)
             float                   Pressure;
             // humidity (in % RH)
             float                   Humidity;
@@ -139,11 +163,8 @@ public:
             float                   White;
             };
 
-        // fed3 data
-        struct FED3
-            {
-            uint8_t                 DataBytes[10][44];
-            };
+        // fed3 data: one event, decoded when received
+        using FED3 = Fed3Event;
 
         //---------------------------
         // the actual members as POD
@@ -174,11 +195,62 @@ class cMeasurementLoop : public McciCatena::cPollableObject
 public:
     // some parameters
     static constexpr std::uint8_t kUplinkPort = 3;
-    static constexpr bool kEnableDeepSleep = false;
+    // downlinks that change the settings; see processControlDownlink().
+    static constexpr std::uint8_t kControlPort = 4;
+    static constexpr std::uint32_t kTxCycleSecFast = 30;
+    static constexpr std::uint32_t kTxCycleSecDefault = 3 * 60;
+    static constexpr std::uint32_t kTxCycleSecIdleDefault = 15 * 60;
+    static constexpr std::uint32_t kTxCycleSecMin = 10;
+    static constexpr std::uint32_t kTxCycleCountDefault = 10;
+    // in summary mode, one uplink per window; see setSummaryMode().
+    static constexpr std::uint32_t kSummaryWindowSecDefault = 60 * 60;
+    static constexpr std::uint32_t kSummaryWindowSecMin = 60;
+    static constexpr std::uint32_t kSummaryWindowSecMax = 24 * 60 * 60;
+    static constexpr bool kEnableDeepSleep = true;
+    // stay awake this long after the FED3 wakes us, in case more follows.
+    static constexpr std::uint32_t kSerialWakeHoldMs = 50;
+    static constexpr std::size_t kEventQueueDepth = CATENA4610_EVENT_QUEUE_DEPTH;
+    static constexpr std::uint8_t kFed3Devices = CATENA4610_FED3_DEVICES;
+    static constexpr std::uint8_t kEventQueues = CATENA4610_EVENT_QUEUE_PER_FED3 ? kFed3Devices : 1;
+    static constexpr std::uint8_t kFed3AddressFirst = 1;
+    static constexpr std::uint8_t kKeyframeIntervalDefault = 8;
+    static constexpr std::uint8_t kBackfillDutyCycleDefault = 1;    // percent
+    static constexpr std::uint32_t kEnvFreshMsDefault = 60 * 1000;
     using MeasurementFormat = cMeasurementFormat;
     using Measurement = MeasurementFormat::Measurement;
     using Flags = MeasurementFormat::Flags;
     static constexpr std::uint8_t kMessageFormat = MeasurementFormat::kMessageFormat;
+    static constexpr std::uint8_t kMessageFormatBatch = MeasurementFormat::kMessageFormatBatch;
+    static constexpr std::uint8_t kMessageFormatSummary = MeasurementFormat::kMessageFormatSummary;
+    using BatchRecord = MeasurementFormat::BatchRecord;
+    using EventQueue_t = cRingQueue<Measurement::FED3, kEventQueueDepth>;
+
+    static_assert(
+        kFed3Devices >= 1 && kFed3AddressFirst + kFed3Devices - 1 <= 247,
+        "FED3 addresses must be 1..247"
+        );
+
+    // receive statistics for one FED3. Frames are counted against the
+    // address in their ID byte, which may itself be damaged.
+    struct Fed3DeviceStats
+        {
+        std::uint32_t   nFrames;        // frames with a good CRC
+        std::uint32_t   nCrcErrors;     // frames with a bad CRC
+        std::uint32_t   nRunts;         // frames too short for an event
+        std::uint32_t   nOverflows;     // frames too long to receive
+        };
+
+    // the RAM taken by one part of the loop; see kRamReport[].
+    struct RamComponent
+        {
+        const char      *pName;
+        std::size_t     size;
+        };
+
+    // the larger members, and what they cost. Whatever isn't listed
+    // is sizeof(cMeasurementLoop) less the sum of these.
+    static const RamComponent kRamReport[];
+    static const std::size_t kRamReportCount;
 
     void deepSleepPrepare();
     void deepSleepRecovery();
@@ -209,11 +281,27 @@ public:
     // constructor
     cMeasurementLoop(
             )
-        : m_txCycleSec_Permanent(3 * 60)      // default uplink interval
-        , m_txCycleSec(30)                  // initial uplink interval
-        , m_txCycleCount(10)                // initial count of fast uplinks
-        , m_DebugFlags(DebugFlags(kError | kTrace))
-        {};
+        : m_DebugFlags(DebugFlags(kError | kTrace))
+        , m_txCycleSec(kTxCycleSecFast)             // initial uplink interval
+        , m_txCycleCount(kTxCycleCountDefault)      // initial count of fast uplinks
+        , m_txCycleSec_Permanent(kTxCycleSecDefault)  // default uplink interval
+        , m_txCycleSec_Idle(kTxCycleSecIdleDefault) // uplink interval while the FED3 is idle
+        {
+        this->m_fBatchUplinks = true;
+        this->m_fCompactEncoding = true;
+        this->m_fSummaryMode = false;
+        this->m_fTxSummary = false;
+        this->m_nKeyframeInterval = kKeyframeIntervalDefault;
+        this->m_backfillOrder = BackfillOrder::OldestFirst;
+        this->m_backfillDutyCycle = kBackfillDutyCycleDefault;
+        this->m_fed3HighPriority = std::uint16_t(1u << Fed3Event::kEventPellet);
+        this->m_fSessionChangeHigh = true;
+        this->m_fHaveStagedDevice = false;
+        this->m_fStagedDeviceTentative = false;
+        this->m_fHaveTxDeviceNumber = false;
+        this->m_fLiveSkipped = false;
+        this->m_fTxFallback = false;
+        };
 
     // neither copyable nor movable
     cMeasurementLoop(const cMeasurementLoop&) = delete;
@@ -242,12 +330,20 @@ public:
         BYTE_CNT    = int(SerialMessageOffset::BYTEC),      //!< Index of byte counter
         };
 
+    // order in which backlogged FED3 events are sent
+    enum class BackfillOrder : std::uint8_t
+        {
+        OldestFirst,
+        NewestFirst,
+        };
+
     enum class State : std::uint8_t
         {
         stNoChange = 0, // this name must be present: indicates "no change of state"
         stInitial,      // this name must be present: it's the starting state.
         stInactive,     // parked; not doing anything.
         stSleeping,     // active; sleeping between measurements
+        stSleepAlert,   // counting down to the first deep sleep
         stWarmup,       // transition from inactive to measure, get some data.
         stMeasure,      // take measurents
         stTransmit,     // transmit data
@@ -263,6 +359,7 @@ public:
         case State::stInitial:  return "stInitial";
         case State::stInactive: return "stInactive";
         case State::stSleeping: return "stSleeping";
+        case State::stSleepAlert: return "stSleepAlert";
         case State::stWarmup:   return "stWarmup";
         case State::stMeasure:  return "stMeasure";
         case State::stTransmit: return "stTransmit";
@@ -272,16 +369,15 @@ public:
         }
 
     // concrete type for uplink data buffer
-    using TxBuffer_t = McciCatena::AbstractTxBuffer_t<MeasurementFormat::kTxBufferSize>;
+    using TxBuffer_t = cUplinkBuffer<MeasurementFormat::kTxBufferSize>;
 
-    uint8_t lastRec;
     uint16_t u16timeOut;
-    uint32_t u32time, u32timeOut;
+    uint32_t u32timeOut;
     uint8_t u8BufferSize;
     uint16_t u16InCnt, u16errCnt;
     uint8_t errCode;
     uint8_t num_bytes;
-    uint8_t au8Buffer[44];
+    uint8_t au8Buffer[cFed3Receiver::kMaxFrame];
 
     // initialize measurement FSM.
     void begin();
@@ -322,6 +418,188 @@ public:
         {
         return this->m_DebugFlags & mask;
         }
+    void setDebugFlags(DebugFlags mask)
+        {
+        this->m_DebugFlags = mask;
+        }
+    DebugFlags getDebugFlags() const
+        {
+        return this->m_DebugFlags;
+        }
+
+    // The settings that can be changed from the console ("meas"), or
+    // by a downlink on kControlPort. They're kept in FRAM, and loaded
+    // by begin().
+    struct Settings
+        {
+        std::uint32_t   txCycleSec;         // uplink interval
+        std::uint32_t   txCycleSecIdle;     // ... while the FED3 is idle
+        std::uint32_t   txCycleCount;       // fast uplinks after boot
+        std::uint32_t   debugFlags;         // DebugFlags
+        std::uint32_t   summaryWindowSec;   // summary mode window
+        bool            fBatchUplinks;
+        bool            fCompactEncoding;
+        bool            fSummaryMode;
+        };
+    static Settings getDefaultSettings();
+    Settings getSettings() const;
+    // put settings into effect; false (and nothing changed) if any
+    // are out of range. Turning summary mode on starts a new window.
+    bool applySettings(const Settings &settings);
+    bool loadSettings();
+    bool saveSettings() const;
+    // forget the saved settings; the defaults are used from next boot.
+    bool eraseSettings();
+    // handle a downlink on kControlPort: apply and save the settings
+    // in it. Returns false if it's malformed.
+    bool processControlDownlink(const std::uint8_t *pBuffer, std::size_t nBuffer);
+
+    // choose what happens when FED3 events arrive faster than we
+    // can send them.
+    void setEventOverflowPolicy(QueueOverflowPolicy policy)
+        {
+        for (auto &ramQueue : this->m_ramQueues)
+            ramQueue.events.setPolicy(policy);
+        this->m_logFallback.setPolicy(policy);
+        }
+
+    // send FED3 events several to an uplink (format 0x25), or one
+    // per uplink (format 0x24).
+    void setBatchUplinks(bool fEnable)
+        {
+        this->m_fBatchUplinks = fEnable;
+        }
+    bool isBatchUplinks() const
+        {
+        return this->m_fBatchUplinks;
+        }
+
+    // in a batch, send varint deltas (compact) or fixed-size deltas,
+    // with a full record at least every nInterval records.
+    void setCompactEncoding(bool fEnable, std::uint8_t nInterval = kKeyframeIntervalDefault)
+        {
+        this->m_fCompactEncoding = fEnable;
+        this->m_nKeyframeInterval = nInterval ? nInterval : 1;
+        }
+    bool isCompactEncoding() const
+        {
+        return this->m_fCompactEncoding;
+        }
+    std::uint8_t getKeyframeInterval() const
+        {
+        return this->m_nKeyframeInterval;
+        }
+
+    // In summary mode, FED3 events aren't sent one by one. Each FED3's
+    // events are totalled over a window instead, and one uplink
+    // (format 0x26) carries the totals at the end of each window, so
+    // uplinks don't grow with activity. The window replaces the uplink
+    // interval. Events queued or logged before summary mode was turned
+    // on wait until it's turned off. Use applySettings() to change
+    // the mode or the window.
+    bool isSummaryMode() const
+        {
+        return this->m_fSummaryMode;
+        }
+    std::uint32_t getSummaryWindow() const
+        {
+        return this->m_summaryWindowSec;
+        }
+    // the current window's totals for the FED3 at kFed3AddressFirst
+    // + iDevice.
+    const Fed3Summary &getFed3Summary(std::uint8_t iDevice) const
+        {
+        return this->m_fed3Devices[iDevice < kFed3Devices ? iDevice : 0].summary;
+        }
+
+    // the queue of FED3 events waiting to be sent from the FED3 at
+    // kFed3AddressFirst + iDevice; with one queue (kEventQueues), all
+    // the FED3s share it. With the flash log, events wait in the log
+    // instead, and the first queue holds those staged for the next
+    // uplink.
+    const EventQueue_t &getEventQueue(std::uint8_t iDevice = 0) const
+        {
+        return this->m_ramQueues[iDevice < kEventQueues ? iDevice : 0].events;
+        }
+    // totals over all the queues.
+    std::uint32_t getQueuedEventCount() const;
+    std::uint32_t getEventDropCount() const;
+
+    // receive statistics for the FED3 at kFed3AddressFirst + iDevice.
+    const Fed3DeviceStats &getFed3DeviceStats(std::uint8_t iDevice) const
+        {
+        return this->m_fed3Devices[iDevice < kFed3Devices ? iDevice : 0].stats;
+        }
+    // good frames from addresses with no FED3 configured.
+    std::uint32_t getFed3UnknownAddressCount() const
+        {
+        return this->m_nFed3UnknownAddress;
+        }
+
+    // the flash log of FED3 events waiting to be sent; only used
+    // if a flash was registered.
+    const cEventLog &getEventLog() const
+        {
+        return this->m_eventLog;
+        }
+
+    // Events that missed their first uplink are backlogged. Once an
+    // uplink succeeds, the backlog is sent in the given order, using
+    // no more than nPercent of the air time. Events that arrive in
+    // the meantime go first.
+    void setBackfillOrder(BackfillOrder order)
+        {
+        this->m_backfillOrder = order;
+        }
+    BackfillOrder getBackfillOrder() const
+        {
+        return this->m_backfillOrder;
+        }
+    void setBackfillDutyCycle(std::uint8_t nPercent)
+        {
+        this->m_backfillDutyCycle = nPercent == 0 ? 1 : nPercent > 100 ? 100 : nPercent;
+        }
+    std::uint8_t getBackfillDutyCycle() const
+        {
+        return this->m_backfillDutyCycle;
+        }
+
+    // Uplinks reuse the environmental measurement (BME280, Si1133,
+    // supply voltages, boot count) for this long, rather than measuring
+    // again for each one. Zero measures for every uplink. A light
+    // measurement that finishes late is sent if it's within this
+    // window, too.
+    void setEnvFreshness(std::uint32_t ms)
+        {
+        this->m_envFreshMs = ms;
+        }
+    std::uint32_t getEnvFreshness() const
+        {
+        return this->m_envFreshMs;
+        }
+    bool isEnvFresh() const
+        {
+        return this->m_fEnvValid &&
+               millis() - this->m_tEnvSample < this->m_envFreshMs;
+        }
+
+    // number of events waiting to be sent: backlogged, and not.
+    std::uint32_t getBacklogDepth() const;
+    std::uint32_t getLiveDepth() const;
+
+    // true if the last uplink succeeded.
+    bool isLinkUp() const
+        {
+        return this->m_fLinkUp;
+        }
+    std::uint32_t getUplinkFailures() const
+        {
+        return this->m_nUplinkFailures;
+        }
+    std::uint32_t getBackfillCount() const
+        {
+        return this->m_nBackfillSent;
+        }
 
     // register an additional SPI for sleep/resume
     // can be called before begin().
@@ -330,21 +608,231 @@ public:
         this->m_pSPI2 = pSpi;
         }
 
+    // register the flash for the FED3 event log; must be called
+    // before begin().
+    void registerFlash(McciCatena::Catena_Mx25v8035f *pFlash)
+        {
+        this->m_pFlash = pFlash;
+        }
+
+    // let the FED3 wake us from deep sleep; call after Serial1.begin().
+    // Without this, deep sleep isn't used, as FED3 events would be lost.
+    bool enableSerialWakeup(std::uint32_t baud)
+        {
+        return this->m_serialWakeup.begin(baud);
+        }
+    bool isSerialWakeupEnabled() const
+        {
+        return this->m_serialWakeup.isEnabled();
+        }
+
+    // load testing: feed generated or recorded FED3 traffic into the
+    // receiver, alongside Serial1. The events are handled like any
+    // others, and are uplinked. A replay's data must stay put until
+    // it's done; see cFed3TrafficGen::beginReplay().
+    void startTrafficGen(const cFed3TrafficGen::Config &config)
+        {
+        this->m_fed3Gen.begin(config, []() { return std::uint32_t(micros()); });
+        }
+    void startTrafficReplay(
+            const std::uint8_t *pData,
+            const std::uint16_t *pDelayMs,
+            std::size_t n
+            )
+        {
+        this->m_fed3Gen.beginReplay(pData, pDelayMs, n, []() { return std::uint32_t(micros()); });
+        }
+    void stopTrafficGen()
+        {
+        this->m_fed3Gen.end();
+        }
+    const cFed3TrafficGen &getTrafficGen() const
+        {
+        return this->m_fed3Gen;
+        }
+    // bytes lost because the receive ring was full.
+    std::uint32_t getRxOverrunCount() const
+        {
+        return this->m_fed3Rx.getOverrunCount();
+        }
+
+    // the Si1133 light measurement. Gain changes take effect from the
+    // next measurement.
+    cLightSensor &getLightSensor()
+        {
+        return this->m_light;
+        }
+
+    // FED3 events are uplinked when the scheduler says so, rather than
+    // waiting for the next uplink cycle; see cUplinkScheduler. The
+    // uplink cycle stretches to the idle interval when the FED3 is
+    // idle.
+    cUplinkScheduler &getUplinkScheduler()
+        {
+        return this->m_uplinkScheduler;
+        }
+    // FED3 events can be high priority by type (eventActive index),
+    // and when the session type changes. High priority events go up
+    // at once, within the scheduler's highLatencyMs, rather than
+    // waiting to be batched. By default, pellets and session changes
+    // are high priority.
+    void setFed3EventPriority(std::uint8_t eventActive, cUplinkScheduler::Priority priority)
+        {
+        if (eventActive >= 16)
+            return;
+
+        std::uint16_t const bit = std::uint16_t(1u << eventActive);
+
+        if (priority == cUplinkScheduler::Priority::High)
+            this->m_fed3HighPriority |= bit;
+        else
+            this->m_fed3HighPriority &= ~bit;
+        }
+    cUplinkScheduler::Priority getFed3EventPriority(std::uint8_t eventActive) const
+        {
+        return (eventActive < 16 && (this->m_fed3HighPriority & (1u << eventActive)) != 0)
+                ? cUplinkScheduler::Priority::High
+                : cUplinkScheduler::Priority::Routine;
+        }
+    void setSessionChangePriority(cUplinkScheduler::Priority priority)
+        {
+        this->m_fSessionChangeHigh = priority == cUplinkScheduler::Priority::High;
+        }
+    cUplinkScheduler::Priority getSessionChangePriority() const
+        {
+        return this->m_fSessionChangeHigh ? cUplinkScheduler::Priority::High
+                                          : cUplinkScheduler::Priority::Routine;
+        }
+
+    void setIdleTxCycleTime(std::uint32_t txCycleSec)
+        {
+        this->m_txCycleSec_Idle = txCycleSec;
+        }
+    std::uint32_t getIdleTxCycleTime() const
+        {
+        return this->m_txCycleSec_Idle;
+        }
+
+    // the cached supply voltages. Each is read at most once per
+    // period; see cSupplySampler.
+    cSupplySampler &getSupplySampler()
+        {
+        return this->m_supply;
+        }
+
+    // the stages of handling one FED3 event, as timed by runBenchmark().
+    enum class BenchStage : std::uint8_t
+        {
+        RxFrame,        // receive a frame a byte at a time, and read it out
+        Crc,            // CRC-16 over a frame
+        Validate,       // validateAnswer()
+        Decode,         // Fed3Event::decode()
+        QueuePush,      // push onto an EventQueue_t
+        Encode,         // fillTxBuffer(), without console output
+        EncodeBatch,    // fillBatchTxBuffer() of a full queue, per event
+        EncodeTrace,    // fillTxBuffer(), with console output
+        Count           // number of stages; must be last
+        };
+    static constexpr std::size_t kBenchStages = std::size_t(BenchStage::Count);
+
+    static constexpr const char *getBenchStageName(BenchStage s)
+        {
+        switch (s)
+            {
+        case BenchStage::RxFrame:       return "rx-frame";
+        case BenchStage::Crc:           return "crc";
+        case BenchStage::Validate:      return "validate";
+        case BenchStage::Decode:        return "decode";
+        case BenchStage::QueuePush:     return "queue-push";
+        case BenchStage::Encode:        return "encode";
+        case BenchStage::EncodeBatch:   return "encode-batch";
+        case BenchStage::EncodeTrace:   return "encode-trace";
+        default:                        return "<<unknown>>";
+            }
+        }
+
+    // time each stage over nIter synthetic events, and put the
+    // average in nanoseconds per event in nsPerEvent[]. Returns false,
+    // having done nothing, if a FED3 frame is on its way in.
+    bool runBenchmark(std::uint32_t nIter, std::uint32_t (&nsPerEvent)[kBenchStages]);
+
+    // deep sleep accounting: number of deep sleeps, how many of them
+    // the FED3 cut short, and the total time asleep.
+    std::uint32_t getDeepSleepCount() const
+        {
+        return this->m_nDeepSleeps;
+        }
+    std::uint32_t getSerialWakeCount() const
+        {
+        return this->m_nSerialWakes;
+        }
+    std::uint32_t getDeepSleepMs() const
+        {
+        return this->m_msDeepSleep;
+        }
+
 private:
     // sleep handling
     void sleep();
     bool checkDeepSleep();
     void doSleepAlert(bool fDeepSleep);
     void doDeepSleep();
+    bool isFed3Busy();
 
     // read data
     void updateSynchronousMeasurements();
     void updateLightMeasurements();
     void resetMeasurements();
     void updatePelletFeederData();
+    void processFrame();
+    void countFrame(std::uint8_t errcode);
+    // index of the FED3 at a bus address; kFed3Devices if there's none.
+    static std::uint8_t getFed3DeviceIndex(std::uint8_t address)
+        {
+        return std::uint8_t(address - kFed3AddressFirst) < kFed3Devices
+                ? std::uint8_t(address - kFed3AddressFirst)
+                : kFed3Devices;
+        }
+    // the queue the next (or current) uplink is taken from.
+    EventQueue_t &getTxQueue()
+        {
+        return this->m_fTxFallback
+                ? this->m_logFallback
+                : this->m_ramQueues[this->m_iTxQueue].events;
+        }
+
+    // summary mode.
+    void beginSummaryWindow();
+    void restoreSentSummaries();
+
+    // backlog handling.
+    void stageEvents();
+    cEventLog::ReadStatus stageLoggedEvent(std::uint32_t seq, bool fLive);
+    bool isStagedDevice(const Fed3Event &event, bool fLive);
+    bool retryLogFallback();
+    void chooseTxDevice();
+    void commitSentEvents();
+    void markBacklog();
+    bool isBackfillDue() const;
+    std::uint32_t getLoggedLiveDepth() const;
+
+    // uplink scheduling.
+    cUplinkScheduler::Priority classifyEvent(const Fed3Event &event, std::uint8_t iDevice);
+    std::uint32_t getEventsPerUplink() const;
+    std::uint32_t getUplinkDelayMs() const;
+    bool isUplinkDue() const
+        {
+        return this->getUplinkDelayMs() == 0;
+        }
+    std::uint32_t getSleepIntervalMs();
 
     // telemetry handling.
     void fillTxBuffer(TxBuffer_t &b, Measurement const & mData);
+    void fillBatchTxBuffer(TxBuffer_t &b, Measurement const & mData, const EventQueue_t &queue);
+    void fillTxHeader(TxBuffer_t &b, std::uint8_t format, Measurement const & mData);
+    void fillSummaryTxBuffer(TxBuffer_t &b, Measurement const & mData);
+    static std::size_t getMaxUplinkSize();
+    static std::uint32_t getUplinkAirtimeMs(std::size_t nPayload);
     void startTransmission(TxBuffer_t &b);
     void sendBufferDone(bool fSuccess);
     bool txComplete()
@@ -373,10 +861,12 @@ private:
     State fsmDispatch(State currentState, bool fEntry);
 
     Adafruit_BME280                 m_BME280;
-    McciCatena::Catena_Si1133       m_si1133;
+    cLightSensor                    m_light;
 
     // second SPI class
     SPIClass                        *m_pSPI2;
+    // the flash on SPI2, if any
+    McciCatena::Catena_Mx25v8035f   *m_pFlash = nullptr;
 
     // debug flags
     DebugFlags                      m_DebugFlags;
@@ -403,8 +893,6 @@ private:
     bool                            m_fUsbPower : 1;
     // set true if BME280 is present
     bool                            m_fBme280 : 1;
-    // set true if SI1133 is present
-    bool                            m_fSi1133: 1;
 
     // set true while a transmit is pending.
     bool                            m_txpending : 1;
@@ -425,17 +913,50 @@ private:
     bool                            m_fPelletPoke : 1;
     // set true if if FED3 right poke is changed
     bool                            m_fRightCount : 1;
+    // set true to send several FED3 events per uplink
+    bool                            m_fBatchUplinks : 1;
+    // set true to send batched FED3 events as varint deltas
+    bool                            m_fCompactEncoding : 1;
+    // set true to send FED3 summaries instead of events
+    bool                            m_fSummaryMode : 1;
+    // set true while the uplink being sent carries summaries
+    bool                            m_fTxSummary : 1;
+    // set true when an uplink succeeds, false when one fails
+    bool                            m_fLinkUp : 1;
+    // set true when deep sleep was put off because the FED3 was busy
+    bool                            m_fDeepSleepDeferred : 1;
+    // set true when a change of FED3 session type is high priority
+    bool                            m_fSessionChangeHigh : 1;
+    // with the flash log and several FED3s: set true once the device
+    // for the uplink being staged is chosen, and while it's only the
+    // one sent last time; see isStagedDevice().
+    bool                            m_fHaveStagedDevice : 1;
+    bool                            m_fStagedDeviceTentative : 1;
+    // ... set true when m_txDeviceNumber is valid
+    bool                            m_fHaveTxDeviceNumber : 1;
+    // ... set true if a live event was passed over in staging
+    bool                            m_fLiveSkipped : 1;
+    // set true when the uplink is taken from m_logFallback
+    bool                            m_fTxFallback : 1;
+    // set true when m_data holds an environmental measurement
+    bool                            m_fEnvValid : 1;
 
-    // number of events happened
-    std::uint8_t                   m_eventCount;
     // previous event happened
     std::uint8_t                   m_prevEvent;
 
     // uplink time control
     McciCatena::cTimer              m_UplinkTimer;
+    // the fast uplink count we started with, for getSettings().
+    std::uint32_t                   m_txCycleCountInitial = kTxCycleCountDefault;
     std::uint32_t                   m_txCycleSec;
     std::uint32_t                   m_txCycleCount;
     std::uint32_t                   m_txCycleSec_Permanent;
+    std::uint32_t                   m_txCycleSec_Idle;
+    std::uint32_t                   m_summaryWindowSec = kSummaryWindowSecDefault;
+    // when to send FED3 events
+    cUplinkScheduler                m_uplinkScheduler;
+    // bit n set: FED3 events with eventActive n are high priority
+    std::uint16_t                   m_fed3HighPriority;
 
     // simple timer for timing-out sensors.
     std::uint32_t                   m_timer_start;
@@ -443,13 +964,96 @@ private:
 
     // the current measurement
     Measurement                     m_data;
+    // when (millis()) the environment was last measured, and for how
+    // long that measurement is good
+    std::uint32_t                   m_tEnvSample = 0;
+    std::uint32_t                   m_envFreshMs = kEnvFreshMsDefault;
+
+    // a queue of FED3 events waiting to be sent; with the flash log,
+    // the first holds the events staged for the next uplink.
+    struct RamQueue
+        {
+        EventQueue_t        events;
+        // without the flash log: number of events at the front of the
+        // queue that are backlogged.
+        std::uint32_t       nBacklog = 0;
+        };
 
-    // the data to write to the file
-    Measurement                     m_FileData;
-    TxBuffer_t                      m_FileTxBuffer;
+    // a FED3 on the serial bus.
+    struct Fed3Device
+        {
+        Fed3DeviceStats     stats {};
+        // the session type of its last event, if fHaveSessionType.
+        std::uint8_t        lastSessionType = 0;
+        bool                fHaveSessionType = false;
+        // in summary mode: the totals for this window, and those in
+        // the uplink being sent, in case it fails.
+        Fed3Summary         summary {};
+        Fed3Summary         summarySent {};
+        };
 
-    // index of buffer to be written to Tx buffer
-    std::uint8_t                    m_BufferIndex;
+    RamQueue                        m_ramQueues[kEventQueues];
+    Fed3Device                      m_fed3Devices[kFed3Devices];
+    // index of the queue the uplink is taken from
+    std::uint8_t                    m_iTxQueue = 0;
+    // good frames from addresses with no FED3 configured
+    std::uint32_t                   m_nFed3UnknownAddress = 0;
+    // number of FED3 events in the uplink being sent
+    std::uint8_t                    m_nTxEvents;
+    // maximum number of records between full records in a batch
+    std::uint8_t                    m_nKeyframeInterval;
+    // size of the uplink being sent
+    std::uint8_t                    m_nTxBytes;
+    // seconds left in the deep sleep countdown
+    std::uint8_t                    m_nSleepAlert;
+
+    // backfill control
+    BackfillOrder                   m_backfillOrder;
+    std::uint8_t                    m_backfillDutyCycle;
+    // earliest time (millis()) for the next uplink with backlogged events
+    std::uint32_t                   m_tBackfillNext = 0;
+    std::uint32_t                   m_nUplinkFailures = 0;
+    std::uint32_t                   m_nBackfillSent = 0;
+    // with the flash log: sequence number of the oldest event that
+    // isn't backlogged, and, for newest-first backfill, one past the
+    // newest backlogged event that might not be consumed.
+    std::uint32_t                   m_liveFirst = 0;
+    std::uint32_t                   m_backfillCursor = 0;
+    // with the flash log: sequence numbers of the events in the queue;
+    // the first m_nStagedLive aren't backlogged.
+    std::uint32_t                   m_stagedSeq[kEventQueueDepth];
+    std::uint8_t                    m_nStaged = 0;
+    std::uint8_t                    m_nStagedLive = 0;
+    // with the flash log and several FED3s: the device numbers of the
+    // FED3 being staged and of the one sent last, and the first live
+    // event passed over, which m_liveFirst mustn't move past.
+    std::uint16_t                   m_stagedDeviceNumber = 0;
+    std::uint16_t                   m_txDeviceNumber = 0;
+    std::uint32_t                   m_liveSkipped = 0;
+
+    // the flash log of FED3 events, and its storage; events it
+    // wouldn't take wait in m_logFallback, oldest first, until it
+    // takes them or they're sent from there.
+    cEventLog                       m_eventLog;
+    cEventLogFlashMx25              m_eventLogFlash;
+    cEventLogIndexFram              m_eventLogIndex;
+    EventQueue_t                    m_logFallback;
+
+    // the FED3 serial receiver
+    cFed3Receiver                   m_fed3Rx;
+    // generated FED3 traffic, for load tests
+    cFed3TrafficGen                 m_fed3Gen;
+    // lets the FED3 wake us from deep sleep
+    cSerialWakeup                   m_serialWakeup;
+    // cached Vbat and Vbus
+    cSupplySampler                  m_supply;
+
+    // deep sleep accounting
+    std::uint32_t                   m_nDeepSleeps = 0;
+    std::uint32_t                   m_nSerialWakes = 0;
+    std::uint32_t                   m_msDeepSleep = 0;
+    // millis() when the FED3 last woke us
+    std::uint32_t                   m_tSerialWake = 0;
     };
 
 //
@@ -465,6 +1069,11 @@ static constexpr cMeasurementLoop::Flags operator& (const cMeasurementLoop::Flag
         return cMeasurementLoop::Flags(uint8_t(lhs) & uint8_t(rhs));
         };
 
+static constexpr cMeasurementLoop::Flags operator~ (const cMeasurementLoop::Flags v)
+        {
+        return cMeasurementLoop::Flags(~uint8_t(v));
+        };
+
 static cMeasurementLoop::Flags operator|= (cMeasurementLoop::Flags &lhs, const cMeasurementLoop::Flags &rhs)
         {
         lhs = lhs | rhs;
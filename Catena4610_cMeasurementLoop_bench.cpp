@@ -0,0 +1,180 @@
+/*
+
+Module: Catena4610_cMeasurementLoop_bench.cpp
+
+Function:
+    Time the stages of handling a FED3 event.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cMeasurementLoop.h"
+
+using namespace McciCatena4610;
+
+constexpr std::size_t cMeasurementLoop::kBenchStages;
+
+// average nanoseconds per event, given microseconds for n events.
+static std::uint32_t getNsPerEvent(std::uint32_t us, std::uint32_t n)
+    {
+    return std::uint32_t((std::uint64_t(us) * 1000 + n / 2) / n);
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::runBenchmark()
+
+Function:
+    Time each stage of handling a FED3 event.
+
+Definition:
+    bool McciCatena4610::cMeasurementLoop::runBenchmark(
+            std::uint32_t nIter,
+            std::uint32_t (&nsPerEvent)[kBenchStages]
+            );
+
+Description:
+    Each stage is run nIter times in a loop of its own and timed with
+    micros(), using a synthetic frame from cFed3TrafficGen. Only the
+    stage with console output is cut short, to a few iterations.
+
+    The real receiver and receive buffer are used, so the stages run
+    exactly as they do for a live event; it's only safe because nothing
+    can be received while a command runs, and we insist the receiver is
+    idle to start with. The frame counters are put
+    back afterwards. The queues are scratch ones, and nothing is logged
+    or sent.
+
+Returns:
+    true if the stages were timed.
+
+*/
+
+bool cMeasurementLoop::runBenchmark(std::uint32_t nIter, std::uint32_t (&nsPerEvent)[kBenchStages])
+    {
+    if (nIter == 0 || ! this->m_fed3Rx.isIdle())
+        return false;
+
+    // keeps the compiler from optimizing the work away.
+    volatile std::uint32_t sink = 0;
+    std::uint32_t t;
+
+    std::uint8_t frame[cFed3TrafficGen::kFrameSize];
+    std::size_t const nFrame = cFed3TrafficGen::buildFrame(0, frame);
+    std::uint16_t const nInSaved = this->u16InCnt;
+    std::uint16_t const nErrSaved = this->u16errCnt;
+
+    // framing: a byte at a time, as pump() would, then read it out.
+    t = micros();
+    for (std::uint32_t i = 0; i < nIter; ++i)
+        {
+        cFed3Receiver::Tick_t const tNow = cFed3Receiver::Tick_t(millis());
+        std::uint8_t nActual;
+        bool fOverflow;
+
+        for (std::size_t j = 0; j < nFrame; ++j)
+            this->m_fed3Rx.receiveByte(frame[j], tNow);
+        (void) this->m_fed3Rx.isFrameReady(tNow);
+        (void) this->m_fed3Rx.readFrame(this->au8Buffer, sizeof(this->au8Buffer), nActual, fOverflow);
+        }
+    nsPerEvent[unsigned(BenchStage::RxFrame)] = getNsPerEvent(micros() - t, nIter);
+
+    t = micros();
+    for (std::uint32_t i = 0; i < nIter; ++i)
+        sink = sink + cCrc16Modbus::compute(frame, nFrame);
+    nsPerEvent[unsigned(BenchStage::Crc)] = getNsPerEvent(micros() - t, nIter);
+
+    // one more frame, to leave a good one in the receive buffer.
+    for (std::size_t j = 0; j < nFrame; ++j)
+        this->m_fed3Rx.receiveByte(frame[j], cFed3Receiver::Tick_t(millis()));
+    (void) this->m_fed3Rx.isFrameReady(millis());
+    this->num_bytes = this->getRxBuffer(this->errCode);
+
+    t = micros();
+    for (std::uint32_t i = 0; i < nIter; ++i)
+        sink = sink + this->validateAnswer();
+    nsPerEvent[unsigned(BenchStage::Validate)] = getNsPerEvent(micros() - t, nIter);
+
+    Measurement m;
+
+    std::memset(&m, 0, sizeof(m));
+    m.flags = Flags::Vbat | Flags::Vbus | Flags::FED3;
+    m.Vbat = 3.7f;
+    m.Vbus = 5.0f;
+
+    t = micros();
+    for (std::uint32_t i = 0; i < nIter; ++i)
+        {
+        m.fed3.decode(&this->au8Buffer[cFed3Receiver::kHeaderSize], Fed3Event::kWireSize);
+        sink = sink + m.fed3.TimeStamp;
+        }
+    nsPerEvent[unsigned(BenchStage::Decode)] = getNsPerEvent(micros() - t, nIter);
+
+    do  {
+        EventQueue_t queue;
+
+        t = micros();
+        for (std::uint32_t i = 0; i < nIter; ++i)
+            {
+            if (queue.full())
+                queue.pop();
+            queue.push(m.fed3);
+            }
+        nsPerEvent[unsigned(BenchStage::QueuePush)] = getNsPerEvent(micros() - t, nIter);
+        sink = sink + queue.peek()->TimeStamp + queue.getDropCount();
+        } while (0);
+
+    TxBuffer_t b;
+    DebugFlags const debugFlags = this->m_DebugFlags;
+
+    this->m_DebugFlags = DebugFlags(debugFlags & ~kTrace);
+    t = micros();
+    for (std::uint32_t i = 0; i < nIter; ++i)
+        this->fillTxBuffer(b, m);
+    nsPerEvent[unsigned(BenchStage::Encode)] = getNsPerEvent(micros() - t, nIter);
+
+    // a batch uplink of a full queue of varied events, timed per event
+    // that fits; m_nTxEvents belongs to the uplink, so it's put back.
+    do  {
+        EventQueue_t queue;
+        Measurement::FED3 event;
+        std::uint8_t const nTxSaved = this->m_nTxEvents;
+
+        for (std::uint32_t i = 0; ! queue.full(); ++i)
+            {
+            (void) cFed3TrafficGen::buildFrame(i, frame);
+            event.decode(&frame[cFed3Receiver::kHeaderSize], Fed3Event::kWireSize);
+            queue.push(event);
+            }
+
+        t = micros();
+        for (std::uint32_t i = 0; i < nIter; ++i)
+            this->fillBatchTxBuffer(b, m, queue);
+        t = micros() - t;
+
+        std::uint32_t const nBatch = this->m_nTxEvents != 0 ? this->m_nTxEvents : 1;
+
+        nsPerEvent[unsigned(BenchStage::EncodeBatch)] = getNsPerEvent(t, nIter * nBatch);
+        this->m_nTxEvents = nTxSaved;
+        } while (0);
+
+    // console output is slow and noisy; a few will do.
+    std::uint32_t const nTrace = nIter < 4 ? nIter : 4;
+
+    this->m_DebugFlags = DebugFlags(debugFlags | kTrace);
+    t = micros();
+    for (std::uint32_t i = 0; i < nTrace; ++i)
+        this->fillTxBuffer(b, m);
+    nsPerEvent[unsigned(BenchStage::EncodeTrace)] = getNsPerEvent(micros() - t, nTrace);
+    this->m_DebugFlags = debugFlags;
+
+    this->u16InCnt = nInSaved;
+    this->u16errCnt = nErrSaved;
+    (void) sink;
+    return true;
+    }
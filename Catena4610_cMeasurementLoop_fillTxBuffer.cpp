@@ -17,23 +17,308 @@ Author:
 
 #include <arduino_lmic.h>
 
+#include <cmath>
+#include <utility>
+
 using namespace McciCatena4610;
 
+/****************************************************************************\
+|
+|   The format 0x24 encoder
+|
+\****************************************************************************/
+
+using Measurement = cMeasurementLoop::Measurement;
+using Flags = cMeasurementLoop::Flags;
+using MessageSchema::Field;
+using MessageSchema::Type;
+
+static constexpr std::uint8_t flagOf(Field f)
+    {
+    return MessageSchema::kMessageFields[unsigned(f)].flag;
+    }
+
+static_assert(flagOf(Field::Vbat) == std::uint8_t(Flags::Vbat), "schema doesn't match Flags");
+static_assert(flagOf(Field::Vsys) == std::uint8_t(Flags::Vcc), "schema doesn't match Flags");
+static_assert(flagOf(Field::Vbus) == std::uint8_t(Flags::Vbus), "schema doesn't match Flags");
+static_assert(flagOf(Field::BootCount) == std::uint8_t(Flags::Boot), "schema doesn't match Flags");
+static_assert(flagOf(Field::Temperature) == std::uint8_t(Flags::TPH), "schema doesn't match Flags");
+static_assert(flagOf(Field::Pressure) == std::uint8_t(Flags::TPH), "schema doesn't match Flags");
+static_assert(flagOf(Field::Humidity) == std::uint8_t(Flags::TPH), "schema doesn't match Flags");
+static_assert(flagOf(Field::Light) == std::uint8_t(Flags::Light), "schema doesn't match Flags");
+static_assert(flagOf(Field::Fed3) == std::uint8_t(Flags::FED3), "schema doesn't match Flags");
+static_assert(
+    MessageSchema::sizeOf(Field::Fed3) == Fed3Event::kWireSize,
+    "schema doesn't match Fed3Event"
+    );
+
+// round to nearest, and clamp to [lo, hi]; NaN gives lo.
+static inline std::int32_t roundClamp(float v, std::int32_t lo, std::int32_t hi)
+    {
+    if (! (v > float(lo)))
+        return lo;
+    else if (v >= float(hi))
+        return hi;
+    else
+        return std::int32_t(std::floor(v + 0.5f));
+    }
+
+// put an already-scaled value, big-endian.
+template <Type kType>
+static void putScaled(std::uint8_t *p, float v)
+    {
+    std::uint32_t raw;
+
+    switch (kType)
+        {
+    case Type::Uint8:   raw = std::uint32_t(roundClamp(v, 0, 0xFF)); break;
+    case Type::Int16:   raw = std::uint32_t(roundClamp(v, -0x8000, 0x7FFF)); break;
+    case Type::Uint16:  raw = std::uint32_t(roundClamp(v, 0, 0xFFFF)); break;
+    case Type::Uflt16:  raw = LMIC_f2uflt16(v); break;
+    default:            raw = v > 0.0f ? std::uint32_t(v + 0.5f) : 0; break;
+        }
+
+    for (unsigned i = MessageSchema::sizeOf(kType); i > 0; --i)
+        {
+        p[i - 1] = std::uint8_t(raw);
+        raw >>= 8;
+        }
+    }
+
+// put one field of a measurement, scaled as the schema says.
+template <unsigned kIndex>
+static void putField(std::uint8_t *p, Measurement const &m)
+    {
+    constexpr auto const &f = MessageSchema::kMessageFields[kIndex];
+    constexpr float scale = float(f.scaleNum) / float(f.scaleDen);
+    float v;
+
+    switch (f.field)
+        {
+    case Field::Vbat:           v = m.Vbat; break;
+    case Field::Vsys:           v = m.Vsystem; break;
+    case Field::Vbus:           v = m.Vbus; break;
+    case Field::BootCount:      v = float(m.BootCount & 0xFF); break;
+    case Field::Temperature:    v = m.env.Temperature; break;
+    // the BME280 reports Pa; the schema wants hPa.
+    case Field::Pressure:       v = m.env.Pressure / 100.0f; break;
+    case Field::Humidity:       v = m.env.Humidity; break;
+    case Field::Light:          v = m.light.White; break;
+    default:
+        m.fed3.encode(p);
+        return;
+        }
+
+    putScaled<f.type>(p, v * scale);
+    }
+
+/*
+
+Name:   cPacker<kFlags>::pack()
+
+Function:
+    Put the fields selected by kFlags, each at its fixed offset.
+
+Definition:
+    template <std::uint8_t kFlags, unsigned kIndex = 0>
+    static void cPacker<kFlags, kIndex>::pack(
+            std::uint8_t *p,
+            Measurement const &m
+            );
+
+Description:
+    Presence and offsets are worked out from the schema at compile
+    time, so each specialization is a straight run of stores: there's
+    no test of the flags, and no bookkeeping of the write position.
+
+*/
+
+template <std::uint8_t kFlags, unsigned kIndex = 0>
+struct cPacker
+    {
+    static void pack(std::uint8_t *p, Measurement const &m)
+        {
+        if (MessageSchema::isPresent(kFlags, Field(kIndex)))
+            putField<kIndex>(p + MessageSchema::offsetOf(kFlags, Field(kIndex)), m);
+
+        cPacker<kFlags, kIndex + 1>::pack(p, m);
+        }
+    };
+
+template <std::uint8_t kFlags>
+struct cPacker<kFlags, MessageSchema::kFieldCount>
+    {
+    static void pack(std::uint8_t *, Measurement const &)
+        {
+        }
+    };
+
+using PackFn = void (*)(std::uint8_t *, Measurement const &);
+
+// this sketch always sends Vbat and Vbus; the others come and go. They
+// are adjacent, so they can index a table of specializations.
+static constexpr std::uint8_t kFlagsAlways = std::uint8_t(Flags::Vbat | Flags::Vbus);
+static constexpr std::uint8_t kFlagsVarying = std::uint8_t(Flags::Boot | Flags::TPH | Flags::Light | Flags::FED3);
+static constexpr unsigned kFlagsVaryingShift = 3;
+static constexpr std::size_t kPackers = (kFlagsVarying >> kFlagsVaryingShift) + 1;
+
+static_assert(
+    ((kPackers - 1) & kPackers) == 0 && (kPackers - 1) << kFlagsVaryingShift == kFlagsVarying,
+    "the varying flags must be adjacent"
+    );
+
+template <std::size_t... i>
+static PackFn getPacker(std::uint8_t flags, std::index_sequence<i...>)
+    {
+    static PackFn const kPack[] =
+        {
+        &cPacker<std::uint8_t(kFlagsAlways | (i << kFlagsVaryingShift))>::pack...
+        };
+
+    return kPack[(flags & kFlagsVarying) >> kFlagsVaryingShift];
+    }
+
+template <std::size_t... i>
+static void putFieldAt(unsigned iField, std::uint8_t *p, Measurement const &m, std::index_sequence<i...>)
+    {
+    static PackFn const kPut[] = { &putField<i>... };
+
+    kPut[iField](p, m);
+    }
+
 /*
 
-Name:   McciCatena4430::cMeasurementLoop::fillTxBuffer()
+Name:   encodeMessage()
+
+Function:
+    Encode the start of a format 0x24 or 0x25 message.
+
+Definition:
+    static std::size_t encodeMessage(
+            std::uint8_t *p,
+            std::uint8_t format,
+            std::uint8_t flags,
+            std::uint8_t fields,
+            Measurement const &m
+            );
+
+Description:
+    The format byte and flags byte are put at p, followed by the fields
+    selected by fields (normally the same as flags; format 0x25 leaves
+    out the FED3 record). The combinations this sketch sends use a
+    specialization of cPacker; anything else walks the schema.
+
+Returns:
+    The number of bytes put.
+
+*/
+
+static std::size_t encodeMessage(
+    std::uint8_t *p,
+    std::uint8_t format,
+    std::uint8_t flags,
+    std::uint8_t fields,
+    Measurement const &m
+    )
+    {
+    p[0] = format;
+    p[1] = flags;
+
+    if ((fields & ~kFlagsVarying) == kFlagsAlways)
+        getPacker(fields, std::make_index_sequence<kPackers>())(p, m);
+    else
+        {
+        std::size_t n = 2;
+
+        for (unsigned i = 0; i < MessageSchema::kFieldCount; ++i)
+            {
+            if (MessageSchema::isPresent(fields, Field(i)))
+                {
+                putFieldAt(i, p + n, m, std::make_index_sequence<MessageSchema::kFieldCount>());
+                n += MessageSchema::sizeOf(Field(i));
+                }
+            }
+        }
+
+    return MessageSchema::messageSize(fields);
+    }
+
+static void traceMeasurement(Measurement const &mData)
+    {
+    if ((mData.flags & Flags::Vbat) != Flags(0))
+        gCatena.SafePrintf("Vbat:    %d mV\n", (int) (mData.Vbat * 1000.0f));
+
+    if ((mData.flags & Flags::Vbus) != Flags(0))
+        gCatena.SafePrintf("Vbus:    %d mV\n", (int) (mData.Vbus * 1000.0f));
+
+    if ((mData.flags & Flags::TPH) != Flags(0))
+        gCatena.SafePrintf(
+            "BME280:  T: %d P: %d RH: %d\n",
+            (int) mData.env.Temperature,
+            (int) mData.env.Pressure,
+            (int) mData.env.Humidity
+            );
+
+    if ((mData.flags & Flags::Light) != Flags(0))
+        gCatena.SafePrintf(
+            "Si1133:  %d White\n",
+            (int) mData.light.White
+            );
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::fillTxHeader()
+
+Function:
+    Put the format byte, flags and environmental fields in a TxBuffer.
+
+Definition:
+    void McciCatena4610::cMeasurementLoop::fillTxHeader(
+            cMeasurementLoop::TxBuffer_t& b,
+            std::uint8_t format,
+            Measurement const &mData
+            );
+
+Description:
+    The buffer is reset, then everything up to (but not including) the
+    FED3 data is added. This part is common to formats 0x24, 0x25
+    and 0x26.
+    The values are echoed to the console if kTrace is enabled.
+
+*/
+
+void
+cMeasurementLoop::fillTxHeader(
+    cMeasurementLoop::TxBuffer_t& b, std::uint8_t format, Measurement const &mData
+    )
+    {
+    std::uint8_t const flags = std::uint8_t(mData.flags);
+    std::uint8_t const fields = flags & ~std::uint8_t(Flags::FED3);
+
+    b.begin();
+    encodeMessage(b.append(MessageSchema::messageSize(fields)), format, flags, fields, mData);
+
+    if (this->isTraceEnabled(DebugFlags::kTrace))
+        traceMeasurement(mData);
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::fillTxBuffer()
 
 Function:
     Prepare a messages in a TxBuffer with data from current measurements.
 
 Definition:
-    void McciCatena4430::cMeasurementLoop::fillTxBuffer(
-            cMeasurementLoop::TxBuffer_t& b
+    void McciCatena4610::cMeasurementLoop::fillTxBuffer(
+            cMeasurementLoop::TxBuffer_t& b,
+            Measurement const &mData
             );
 
 Description:
     A format 0x24 message is prepared from the data in the cMeasurementLoop
-    object.
+    object. The layout comes from MessageSchema.
 
 */
 
@@ -42,182 +327,265 @@ cMeasurementLoop::fillTxBuffer(
     cMeasurementLoop::TxBuffer_t& b, Measurement const &mData
     )
     {
+    CATENA4610_PERF_SCOPE(FillTxBuffer);
+
     gLed.Set(McciCatena::LedPattern::Off);
     gLed.Set(McciCatena::LedPattern::Measuring);
 
-    // initialize the message buffer to an empty state
-    b.begin();
+    static_assert(
+        MessageSchema::messageSize(0xFF) <= TxBuffer_t::getCapacity(),
+        "every message must fit in an empty buffer"
+        );
 
-    // insert format byte
-    b.put(kMessageFormat);
+    std::uint8_t const flags = std::uint8_t(mData.flags);
 
-    // the flags in Measurement correspond to the over-the-air flags.
-    b.put(std::uint8_t(mData.flags));
+    b.begin();
+    encodeMessage(b.append(MessageSchema::messageSize(flags)), kMessageFormat, flags, flags, mData);
 
-    // send Vbat
-    if ((mData.flags & Flags::Vbat) != Flags(0))
+    if (this->isTraceEnabled(DebugFlags::kTrace))
         {
-        float Vbat = mData.Vbat;
-        gCatena.SafePrintf("Vbat:    %d mV\n", (int) (Vbat * 1000.0f));
-        b.putV(Vbat);
-        }
+        traceMeasurement(mData);
 
-    // Vbus is sent as 5000 * v
-    if ((mData.flags & Flags::Vbus) != Flags(0))
-        {
-        float Vbus = mData.Vbus;
-        gCatena.SafePrintf("Vbus:    %d mV\n", (int) (Vbus * 1000.0f));
-        b.putV(Vbus);
-        }
+        // the FED3 record is always last.
+        if ((mData.flags & Flags::FED3) != Flags(0))
+                {
+                gCatena.SafePrintf("Data:");
+                for (std::size_t i = b.getn() - Fed3Event::kWireSize; i < b.getn(); ++i)
+                        gCatena.SafePrintf(" %x", b.getbase()[i]);
+                gCatena.SafePrintf("\n");
 
-    // send boot count
-    if ((mData.flags & Flags::Boot) != Flags(0))
-        {
-        b.putBootCountLsb(mData.BootCount);
+                mData.fed3.print();
+                }
         }
 
-    if ((mData.flags & Flags::TPH) != Flags(0))
-        {
-        gCatena.SafePrintf(
-                "BME280:  T: %d P: %d RH: %d\n",
-                (int) mData.env.Temperature,
-                (int) mData.env.Pressure,
-                (int) mData.env.Humidity
-                );
-        b.putT(mData.env.Temperature);
-        b.putP(mData.env.Pressure);
-        // no method for 2-byte RH, directly encode it.
-        b.put2uf((mData.env.Humidity / 100.0f) * 65535.0f);
-        }
+    gLed.Set(McciCatena::LedPattern::Off);
+    }
 
-    // put light
-    if ((mData.flags & Flags::Light) != Flags(0))
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::fillBatchTxBuffer()
+
+Function:
+    Prepare a message carrying as many queued FED3 events as will fit.
+
+Definition:
+    void McciCatena4610::cMeasurementLoop::fillBatchTxBuffer(
+            cMeasurementLoop::TxBuffer_t& b,
+            Measurement const &mData,
+            const EventQueue_t &queue
+            );
+
+Description:
+    A format 0x25 message is prepared. The header and environmental
+    fields are the same as format 0x24 and are sent once. If the FED3
+    flag is set, they are followed by a count byte and that many
+    records, each starting with a BatchRecord tag. The first record is
+    always sent in full, so every message can be decoded on its own,
+    and so is every m_nKeyframeInterval'th record after that. The rest
+    are sent as deltas against the one before: zig-zag varints if
+    compact encoding is on, otherwise fixed-size deltas whenever
+    Fed3Event::encodeDelta() allows. A delta that would be no smaller
+    than the full record is sent in full.
+
+    Events are taken from the front of queue, which is getTxQueue()
+    except when runBenchmark() times this, until the next one wouldn't
+    fit within the maximum payload for the current data rate.
+    They are left in the queue until the uplink succeeds; the number
+    taken is left in m_nTxEvents.
+
+    At the slowest data rates, the environmental fields leave no room
+    for even one full record; then the boot count, TPH and light are
+    left out of this message, so the queue still drains. They go in
+    the next message that has room.
+
+*/
+
+void
+cMeasurementLoop::fillBatchTxBuffer(
+    cMeasurementLoop::TxBuffer_t& b, Measurement const &mData, const EventQueue_t &queue
+    )
+    {
+    CATENA4610_PERF_SCOPE(FillTxBuffer);
+
+    gLed.Set(McciCatena::LedPattern::Off);
+    gLed.Set(McciCatena::LedPattern::Measuring);
+
+    std::size_t nMax = getMaxUplinkSize();
+    if (nMax > MeasurementFormat::kTxBufferSize)
+        nMax = MeasurementFormat::kTxBufferSize;
+
+    // the count, a tag and one full record must fit after the header.
+    constexpr std::size_t kFirstRecordSize = 1 + 1 + Fed3Event::kWireSize;
+    std::uint8_t const fields = std::uint8_t(mData.flags) & ~std::uint8_t(Flags::FED3);
+
+    if ((mData.flags & Flags::FED3) != Flags(0) &&
+        MessageSchema::messageSize(fields) + kFirstRecordSize > nMax)
         {
-        gCatena.SafePrintf(
-                "Si1133:  %d White\n",
-                (int) mData.light.White
-                );
+        Measurement m = mData;
 
-        b.putLux(LMIC_f2uflt16(mData.light.White / pow(2.0, 24)));
+        m.flags = m.flags & ~(Flags::Boot | Flags::TPH | Flags::Light);
+        this->fillTxHeader(b, kMessageFormatBatch, m);
         }
+    else
+        this->fillTxHeader(b, kMessageFormatBatch, mData);
+
+    this->m_nTxEvents = 0;
 
-    // put fed3 data
-    if ((mData.flags & Flags::FED3) != Flags(0)){
-        gCatena.SafePrintf("Data:");
-        for (uint8_t nIndex = 0; nIndex < this->num_bytes; ++nIndex)
+    if ((mData.flags & Flags::FED3) != Flags(0))
+        {
+        // count goes here; filled in at the end.
+        std::size_t const iCount = b.getn();
+        b.put(0);
+
+        Fed3Event prev;
+        std::uint8_t nEvents = 0;
+        std::uint8_t nSinceFull = 0;
+
+        for (Fed3Event const *pEvent; (pEvent = queue.peek(nEvents)) != nullptr && nEvents < 0xFF; )
+            {
+            std::uint8_t record[Fed3Event::kMaxVarintSize];
+            std::size_t nRecord = Fed3Event::kWireSize;
+            BatchRecord tag = BatchRecord::Full;
+            bool const fDelta = nEvents != 0 && nSinceFull < this->m_nKeyframeInterval;
+
+            if (fDelta && this->m_fCompactEncoding)
                 {
-                gCatena.SafePrintf(" %x", m_data.fed3.DataBytes[m_BufferIndex][nIndex]);
-                b.put(m_data.fed3.DataBytes[m_BufferIndex][nIndex]);
+                nRecord = pEvent->encodeVarintDelta(prev, record);
+                tag = BatchRecord::Varint;
                 }
-        gCatena.SafePrintf("\n");
-
-        uint8_t dataIndex;
-        dataIndex = 0;
-
-        // Timestamp (4-bytes)
-        uint32_t fed3TimeStamp;
-        fed3TimeStamp = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 24 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1] << 16
-                | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 2] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 3];
-        dataIndex = dataIndex + 4;
-        gCatena.SafePrintf("fed3TimeStamp: %u\n", fed3TimeStamp);
-
-        // Version (3-bytes)
-        uint32_t fed3VersionMajor;
-        uint32_t fed3VersionMinor;
-        uint32_t fed3VersionLocal;
-        fed3VersionMajor = m_data.fed3.DataBytes[m_BufferIndex][dataIndex];
-        dataIndex = dataIndex + 1;
-        fed3VersionMinor = m_data.fed3.DataBytes[m_BufferIndex][dataIndex];
-        dataIndex = dataIndex + 1;
-        fed3VersionLocal = m_data.fed3.DataBytes[m_BufferIndex][dataIndex];
-        dataIndex = dataIndex + 1;
-        gCatena.SafePrintf("fed3Version: %d.%d.%d\n", fed3VersionMajor, fed3VersionMinor, fed3VersionLocal);
-
-        // device number (2-bytes)
-        uint16_t fed3DeviceNumber;
-        fed3DeviceNumber = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1];
-        dataIndex = dataIndex + 2;
-        gCatena.SafePrintf("fed3DeviceNumber: %d\n", fed3DeviceNumber);
-
-        // session Type (1-byte)
-        uint16_t fed3SessionType;
-        fed3SessionType = m_data.fed3.DataBytes[m_BufferIndex][dataIndex];
-        dataIndex = dataIndex + 1;
-        gCatena.SafePrintf("fed3SessionType Index: [%d] %s\n", fed3SessionType, sessionType[fed3SessionType]);
-
-        // FED3 Battery voltage
-		uint16_t fed3Vbat;
-        fed3Vbat = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1];
-        dataIndex = dataIndex + 2;
-        if (fed3Vbat & 0x8000)
-                fed3Vbat |= -0x10000;
-        gCatena.SafePrintf("fed3Vbat: %d mV\n", (int) ((fed3Vbat / 4096.00) * 1000.f));
-
-        // number of motor turns (4-bytes)
-        uint32_t fed3NumMotorTurns;
-        fed3NumMotorTurns = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 24 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1] << 16
-                | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 2] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 3];
-        dataIndex = dataIndex + 4;
-        gCatena.SafePrintf("fed3NumMotorTurns: %d\n", fed3NumMotorTurns);
-
-        // fixed ratio (2-bytes)
-        uint16_t fed3FixedRatio;
-        fed3FixedRatio = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1];
-        dataIndex = dataIndex + 2;
-        if(fed3FixedRatio & 0x8000)
-                fed3FixedRatio |= -0x10000;
-        gCatena.SafePrintf("fed3FixedRatio: %d\n", fed3FixedRatio);
-
-        // Event Active (1-byte)
-        uint16_t fed3EventActive;
-        fed3EventActive = m_data.fed3.DataBytes[m_BufferIndex][dataIndex];
-        dataIndex = dataIndex + 1;
-        gCatena.SafePrintf("fed3EventActive Index: [%d] %s\n", fed3EventActive, eventActive[fed3EventActive]);
-
-        // Event time (2-bytes)
-        uint32_t fed3PokeTime;
-        uint32_t fed3RetrievalTime;
-        if (fed3EventActive == 11)
+            else if (fDelta && pEvent->encodeDelta(prev, record))
                 {
-                fed3RetrievalTime = ((m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1]));
-                gCatena.SafePrintf("fed3RetrievalTime: %d ms\n", fed3RetrievalTime * 4);
+                tag = BatchRecord::Delta;
+                nRecord = Fed3Event::kDeltaSize;
                 }
-        else
+
+            if (nRecord >= Fed3Event::kWireSize)
+                {
+                tag = BatchRecord::Full;
+                nRecord = Fed3Event::kWireSize;
+                }
+
+            if (b.getn() + 1 + nRecord > nMax)
+                break;
+
+            // full records are encoded in place; deltas had to be
+            // encoded to find their size.
+            b.put(std::uint8_t(tag));
+            if (tag == BatchRecord::Full)
+                pEvent->encode(b.append(nRecord));
+            else
+                b.put(record, nRecord);
+
+            nSinceFull = (tag == BatchRecord::Full) ? 1 : nSinceFull + 1;
+            prev = *pEvent;
+            ++nEvents;
+            }
+
+        b.getbase()[iCount] = nEvents;
+        this->m_nTxEvents = nEvents;
+
+        if (this->isTraceEnabled(DebugFlags::kTrace))
+            gCatena.SafePrintf("FED3 batch: %u events, %u bytes\n", nEvents, unsigned(b.getn()));
+        }
+
+    gLed.Set(McciCatena::LedPattern::Off);
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::fillSummaryTxBuffer()
+
+Function:
+    Prepare a message carrying each FED3's totals for the window.
+
+Definition:
+    void McciCatena4610::cMeasurementLoop::fillSummaryTxBuffer(
+            cMeasurementLoop::TxBuffer_t& b,
+            Measurement const &mData
+            );
+
+Description:
+    A format 0x26 message is prepared. The header and environmental
+    fields are the same as format 0x24. If the FED3 flag is set, they
+    are followed by a count byte and that many Fed3Summary records, one
+    for each FED3 that sent anything in the window.
+
+    Every FED3's window ends here, and a new one begins; the totals
+    that were sent are kept in summarySent, in case the uplink fails.
+    A summary that doesn't fit within the maximum payload for the
+    current data rate isn't ended, and goes in the next uplink.
+
+*/
+
+void
+cMeasurementLoop::fillSummaryTxBuffer(
+    cMeasurementLoop::TxBuffer_t& b, Measurement const &mData
+    )
+    {
+    CATENA4610_PERF_SCOPE(FillTxBuffer);
+
+    static_assert(
+        MeasurementFormat::kTxHeaderSizeMax + Fed3Summary::kWireSize <= TxBuffer_t::getCapacity(),
+        "a summary must fit in the buffer"
+        );
+
+    gLed.Set(McciCatena::LedPattern::Off);
+    gLed.Set(McciCatena::LedPattern::Measuring);
+
+    auto const tNow = millis();
+
+    this->fillTxHeader(b, kMessageFormatSummary, mData);
+    this->m_nTxEvents = 0;
+
+    std::size_t nMax = getMaxUplinkSize();
+    if (nMax > MeasurementFormat::kTxBufferSize)
+        nMax = MeasurementFormat::kTxBufferSize;
+
+    // count goes here; filled in at the end.
+    std::size_t const iCount = b.getn();
+    std::uint8_t nRecords = 0;
+
+    if ((mData.flags & Flags::FED3) != Flags(0))
+        b.put(0);
+
+    for (std::uint8_t i = 0; i < kFed3Devices; ++i)
+        {
+        auto &device = this->m_fed3Devices[i];
+
+        if (! device.summary.empty())
+            {
+            auto const pRecord = b.getn() + Fed3Summary::kWireSize <= nMax
+                                    ? b.append(Fed3Summary::kWireSize)
+                                    : nullptr;
+
+            if (pRecord == nullptr)
                 {
-                fed3PokeTime = ((m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1]));
-                gCatena.SafePrintf("fed3PokeTime: %d ms\n", fed3PokeTime * 4);
+                // carry on adding up; this one goes next time.
+                device.summarySent.begin(tNow);
+                continue;
                 }
-        dataIndex = dataIndex + 2;
-
-        // Left count (4-bytes)
-        uint32_t fed3LeftCount;
-        fed3LeftCount = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 24 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1] << 16
-                | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 2] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 3];
-        dataIndex = dataIndex + 4;
-        gCatena.SafePrintf("fed3LeftCount: %d\n", fed3LeftCount);
-
-        // Right count (4-bytes)
-        uint32_t fed3RightCount;
-        fed3RightCount = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 24 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1] << 16
-                | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 2] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 3];
-        dataIndex = dataIndex + 4;
-        gCatena.SafePrintf("fed3RightCount: %d\n", fed3RightCount);
-
-        // Pellet count (4-bytes)
-        uint32_t fed3PelletCount;
-        fed3PelletCount = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 24 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1] << 16
-                | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 2] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 3];
-        dataIndex = dataIndex + 4;
-        gCatena.SafePrintf("fed3PelletCount: %d\n", fed3PelletCount);
-
-        // Block pellet count (2-bytes)
-		uint16_t fed3BlockPelletCount;
-        fed3BlockPelletCount = m_data.fed3.DataBytes[m_BufferIndex][dataIndex] << 8 | m_data.fed3.DataBytes[m_BufferIndex][dataIndex + 1];
-        dataIndex = dataIndex + 2;
-        if(fed3BlockPelletCount & 0x8000)
-                fed3BlockPelletCount |= -0x10000;
-        gCatena.SafePrintf("fed3BlockPelletCount: %d\n", fed3BlockPelletCount);
+
+            device.summary.encode(pRecord, tNow);
+            ++nRecords;
+
+            if (this->isTraceEnabled(DebugFlags::kTrace))
+                gCatena.SafePrintf(
+                    "FED3 %u summary: %u s, %u events, %u left, %u right, %u pellets\n",
+                    unsigned(kFed3AddressFirst + i),
+                    unsigned(device.summary.getField(Fed3Summary::Field::WindowSec, tNow)),
+                    unsigned(device.summary.nEvents),
+                    unsigned(device.summary.nLeftPokes),
+                    unsigned(device.summary.nRightPokes),
+                    unsigned(device.summary.nPellets)
+                    );
+            }
+
+        device.summarySent = device.summary;
+        device.summary.begin(tNow);
         }
 
+    if ((mData.flags & Flags::FED3) != Flags(0))
+        b.getbase()[iCount] = nRecords;
+
     gLed.Set(McciCatena::LedPattern::Off);
     }
@@ -0,0 +1,333 @@
+/*
+
+Module: Catena4610_cMeasurementLoop_settings.cpp
+
+Function:
+    Settings for the measurement loop: console, downlink and FRAM.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cMeasurementLoop.h"
+
+#include "Catena4610_cCrc16Modbus.h"
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+constexpr std::uint8_t cMeasurementLoop::kControlPort;
+constexpr std::uint32_t cMeasurementLoop::kTxCycleSecFast;
+constexpr std::uint32_t cMeasurementLoop::kTxCycleSecDefault;
+constexpr std::uint32_t cMeasurementLoop::kTxCycleSecIdleDefault;
+constexpr std::uint32_t cMeasurementLoop::kTxCycleSecMin;
+constexpr std::uint32_t cMeasurementLoop::kTxCycleCountDefault;
+constexpr std::uint32_t cMeasurementLoop::kSummaryWindowSecDefault;
+constexpr std::uint32_t cMeasurementLoop::kSummaryWindowSecMin;
+constexpr std::uint32_t cMeasurementLoop::kSummaryWindowSecMax;
+
+// the settings live in FRAM between the event log index and the bench
+// baseline.
+static constexpr std::uint32_t kSettingsFramOffset = 0x7F40;
+static constexpr std::uint16_t kSettingsMagic = 0x534D;     // 'MS'
+static constexpr std::uint8_t kSettingsVersion = 2;
+static constexpr std::size_t kSettingsSize = 2 + 1 + 5 * 4 + 1 + 2;
+
+// flag bits, in FRAM and in downlinks.
+static constexpr std::uint8_t kSettingBatch = 1 << 0;
+static constexpr std::uint8_t kSettingCompact = 1 << 1;
+static constexpr std::uint8_t kSettingSummary = 1 << 2;
+
+// the commands in a control downlink.
+enum class ControlCommand : std::uint8_t
+    {
+    TxCycle = 0x01,         // uint16 seconds
+    TxCycleIdle = 0x02,     // uint16 seconds
+    TxCycleCount = 0x03,    // uint8 count
+    Encoding = 0x04,        // uint8 kSetting... bits
+    DebugMask = 0x05,       // uint32 mask
+    SummaryWindow = 0x06,   // uint32 seconds
+    };
+
+static void putLe32(std::uint8_t *p, std::uint32_t v)
+    {
+    p[0] = std::uint8_t(v);
+    p[1] = std::uint8_t(v >> 8);
+    p[2] = std::uint8_t(v >> 16);
+    p[3] = std::uint8_t(v >> 24);
+    }
+
+static std::uint32_t getLe32(const std::uint8_t *p)
+    {
+    return p[0] | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+    }
+
+cMeasurementLoop::Settings cMeasurementLoop::getDefaultSettings()
+    {
+    Settings settings;
+
+    settings.txCycleSec = kTxCycleSecDefault;
+    settings.txCycleSecIdle = kTxCycleSecIdleDefault;
+    settings.txCycleCount = kTxCycleCountDefault;
+    settings.debugFlags = kError | kTrace;
+    settings.fBatchUplinks = true;
+    settings.fCompactEncoding = true;
+    settings.fSummaryMode = false;
+    settings.summaryWindowSec = kSummaryWindowSecDefault;
+    return settings;
+    }
+
+cMeasurementLoop::Settings cMeasurementLoop::getSettings() const
+    {
+    Settings settings;
+
+    settings.txCycleSec = this->m_txCycleSec_Permanent;
+    settings.txCycleSecIdle = this->m_txCycleSec_Idle;
+    settings.txCycleCount = this->m_txCycleCountInitial;
+    settings.debugFlags = this->m_DebugFlags;
+    settings.fBatchUplinks = this->m_fBatchUplinks;
+    settings.fCompactEncoding = this->m_fCompactEncoding;
+    settings.fSummaryMode = this->m_fSummaryMode;
+    settings.summaryWindowSec = this->m_summaryWindowSec;
+    return settings;
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::applySettings()
+
+Function:
+    Put a set of settings into effect.
+
+Definition:
+    bool McciCatena4610::cMeasurementLoop::applySettings(
+            const Settings &settings
+            );
+
+Description:
+    If the fast uplink count changes, the fast uplinks start over with
+    the new count. Otherwise, once the fast uplinks are done, a new
+    interval takes effect at once. Before begin(), only the values are
+    set; begin() starts the uplink timer with them.
+
+    In summary mode, the uplink interval is the summary window, and
+    there are no fast uplinks. Turning summary mode on starts a new
+    window.
+
+Returns:
+    false, with nothing changed, if an interval is below
+    kTxCycleSecMin, or the summary window is outside
+    kSummaryWindowSecMin to kSummaryWindowSecMax.
+
+*/
+
+bool cMeasurementLoop::applySettings(const Settings &settings)
+    {
+    if (settings.txCycleSec < kTxCycleSecMin || settings.txCycleSecIdle < kTxCycleSecMin)
+        return false;
+    if (settings.summaryWindowSec < kSummaryWindowSecMin ||
+        settings.summaryWindowSec > kSummaryWindowSecMax)
+        return false;
+
+    bool const fRestartFast = settings.txCycleCount != this->m_txCycleCountInitial;
+    bool const fStartSummary = settings.fSummaryMode && ! this->m_fSummaryMode;
+
+    this->m_txCycleSec_Permanent = settings.txCycleSec;
+    this->m_txCycleSec_Idle = settings.txCycleSecIdle;
+    this->m_txCycleCountInitial = settings.txCycleCount;
+    this->m_DebugFlags = DebugFlags(settings.debugFlags);
+    this->m_fBatchUplinks = settings.fBatchUplinks;
+    this->m_fCompactEncoding = settings.fCompactEncoding;
+    this->m_fSummaryMode = settings.fSummaryMode;
+    this->m_summaryWindowSec = settings.summaryWindowSec;
+
+    if (fStartSummary)
+        this->beginSummaryWindow();
+
+    std::uint32_t txCycleSec = this->m_txCycleSec;
+    std::uint32_t txCycleCount = this->m_txCycleCount;
+
+    if (settings.fSummaryMode)
+        {
+        txCycleSec = settings.summaryWindowSec;
+        txCycleCount = 0;
+        }
+    else if (fRestartFast)
+        {
+        txCycleCount = settings.txCycleCount;
+        txCycleSec = txCycleCount != 0 ? kTxCycleSecFast : settings.txCycleSec;
+        }
+    else if (txCycleCount == 0)
+        {
+        txCycleSec = this->m_uplinkScheduler.isIdle(millis()) ? settings.txCycleSecIdle
+                                                              : settings.txCycleSec;
+        }
+
+    if (this->m_registered)
+        this->setTxCycleTime(txCycleSec, txCycleCount);
+    else
+        {
+        this->m_txCycleSec = txCycleSec;
+        this->m_txCycleCount = txCycleCount;
+        }
+
+    return true;
+    }
+
+bool cMeasurementLoop::loadSettings()
+    {
+    auto const pFram = gCatena.getFram();
+    std::uint8_t buf[kSettingsSize];
+
+    if (pFram == nullptr || ! pFram->read(kSettingsFramOffset, buf, sizeof(buf)))
+        return false;
+
+    if ((buf[0] | (buf[1] << 8)) != kSettingsMagic ||
+        buf[2] != kSettingsVersion ||
+        cCrc16Modbus::compute(buf, sizeof(buf)) != 0)
+        return false;
+
+    Settings settings;
+
+    settings.txCycleSec = getLe32(buf + 3);
+    settings.txCycleSecIdle = getLe32(buf + 7);
+    settings.txCycleCount = getLe32(buf + 11);
+    settings.debugFlags = getLe32(buf + 15);
+    settings.summaryWindowSec = getLe32(buf + 19);
+    settings.fBatchUplinks = (buf[23] & kSettingBatch) != 0;
+    settings.fCompactEncoding = (buf[23] & kSettingCompact) != 0;
+    settings.fSummaryMode = (buf[23] & kSettingSummary) != 0;
+
+    return this->applySettings(settings);
+    }
+
+bool cMeasurementLoop::saveSettings() const
+    {
+    auto const pFram = gCatena.getFram();
+    auto const settings = this->getSettings();
+    std::uint8_t buf[kSettingsSize];
+
+    if (pFram == nullptr)
+        return false;
+
+    buf[0] = std::uint8_t(kSettingsMagic);
+    buf[1] = std::uint8_t(kSettingsMagic >> 8);
+    buf[2] = kSettingsVersion;
+    putLe32(buf + 3, settings.txCycleSec);
+    putLe32(buf + 7, settings.txCycleSecIdle);
+    putLe32(buf + 11, settings.txCycleCount);
+    putLe32(buf + 15, settings.debugFlags);
+    putLe32(buf + 19, settings.summaryWindowSec);
+    buf[23] = (settings.fBatchUplinks ? kSettingBatch : 0) |
+              (settings.fCompactEncoding ? kSettingCompact : 0) |
+              (settings.fSummaryMode ? kSettingSummary : 0);
+
+    std::uint16_t const crc = cCrc16Modbus::compute(buf, sizeof(buf) - 2);
+    buf[sizeof(buf) - 2] = std::uint8_t(crc);
+    buf[sizeof(buf) - 1] = std::uint8_t(crc >> 8);
+
+    return pFram->write(kSettingsFramOffset, buf, sizeof(buf));
+    }
+
+bool cMeasurementLoop::eraseSettings()
+    {
+    auto const pFram = gCatena.getFram();
+    std::uint8_t const buf[2] = { 0xFF, 0xFF };
+
+    return pFram != nullptr && pFram->write(kSettingsFramOffset, buf, sizeof(buf));
+    }
+
+/*
+
+Name:   McciCatena4610::cMeasurementLoop::processControlDownlink()
+
+Function:
+    Apply the settings in a control downlink.
+
+Definition:
+    bool McciCatena4610::cMeasurementLoop::processControlDownlink(
+            const std::uint8_t *pBuffer,
+            std::size_t nBuffer
+            );
+
+Description:
+    A control downlink (on kControlPort) is a sequence of commands,
+    each a ControlCommand byte followed by its value, big-endian:
+
+        0x01 {uint16}   uplink interval, seconds
+        0x02 {uint16}   uplink interval while the FED3 is idle, seconds
+        0x03 {uint8}    number of fast uplinks
+        0x04 {uint8}    bit 0: batch FED3 events; bit 1: compact encoding;
+                        bit 2: summary mode
+        0x05 {uint32}   debug mask
+        0x06 {uint32}   summary window, seconds
+
+    The message is checked in full before anything changes, so a bad
+    one has no effect. The new settings are saved to FRAM.
+
+Returns:
+    false if the message is malformed or a value is out of range.
+
+*/
+
+bool cMeasurementLoop::processControlDownlink(
+    const std::uint8_t *pBuffer,
+    std::size_t nBuffer
+    )
+    {
+    auto settings = this->getSettings();
+    std::size_t i = 0;
+
+    if (nBuffer == 0)
+        return false;
+
+    while (i < nBuffer)
+        {
+        auto const command = ControlCommand(pBuffer[i++]);
+        std::size_t nValue;
+
+        switch (command)
+            {
+        case ControlCommand::TxCycle:
+        case ControlCommand::TxCycleIdle:   nValue = 2; break;
+        case ControlCommand::TxCycleCount:
+        case ControlCommand::Encoding:      nValue = 1; break;
+        case ControlCommand::DebugMask:
+        case ControlCommand::SummaryWindow: nValue = 4; break;
+        default:                            return false;
+            }
+
+        if (nBuffer - i < nValue)
+            return false;
+
+        std::uint32_t v = 0;
+        for (std::size_t j = 0; j < nValue; ++j)
+            v = (v << 8) | pBuffer[i++];
+
+        switch (command)
+            {
+        case ControlCommand::TxCycle:       settings.txCycleSec = v; break;
+        case ControlCommand::TxCycleIdle:   settings.txCycleSecIdle = v; break;
+        case ControlCommand::TxCycleCount:  settings.txCycleCount = v; break;
+        case ControlCommand::Encoding:
+            settings.fBatchUplinks = (v & kSettingBatch) != 0;
+            settings.fCompactEncoding = (v & kSettingCompact) != 0;
+            settings.fSummaryMode = (v & kSettingSummary) != 0;
+            break;
+        case ControlCommand::DebugMask:     settings.debugFlags = v; break;
+        case ControlCommand::SummaryWindow: settings.summaryWindowSec = v; break;
+            }
+        }
+
+    if (! this->applySettings(settings))
+        return false;
+
+    if (! this->saveSettings() && this->isTraceEnabled(DebugFlags::kError))
+        gCatena.SafePrintf("control downlink: settings not saved\n");
+
+    return true;
+    }
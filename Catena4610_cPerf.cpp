@@ -0,0 +1,97 @@
+/*
+
+Module: Catena4610_cPerf.cpp
+
+Function:
+    cPerf: lightweight on-target profiling probes.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cPerf.h"
+
+using namespace McciCatena4610;
+
+#if CATENA4610_PERF
+
+#include <Arduino.h>
+#include <cstring>
+
+constexpr std::size_t cPerf::kProbes;
+constexpr std::size_t cPerf::kBuckets;
+constexpr std::uint32_t cPerf::kBucket0;
+
+cPerf::Stats cPerf::sStats[cPerf::kProbes];
+std::uint32_t cPerf::sEpoch;
+
+std::uint32_t cPerf::getCycles()
+    {
+#if defined(SysTick)
+    std::uint32_t ms;
+    std::uint32_t val;
+
+    // if the tick interrupt gets in between, try again.
+    do  {
+        ms = millis();
+        val = SysTick->VAL;
+        } while (ms != millis());
+
+    std::uint32_t const load = SysTick->LOAD + 1;
+
+    return ms * load + (load - 1 - val);
+#else
+    return micros();
+#endif
+    }
+
+std::uint32_t cPerf::getCyclesPerUs()
+    {
+#if defined(SysTick)
+    return (SysTick->LOAD + 1) / 1000;
+#else
+    return 1;
+#endif
+    }
+
+void cPerf::record(PerfProbe probe, std::uint32_t cycles)
+    {
+    Stats &s = sStats[unsigned(probe)];
+
+    if (s.count == 0 || cycles < s.min)
+        s.min = cycles;
+    if (cycles > s.max)
+        s.max = cycles;
+    ++s.count;
+    s.total += cycles;
+
+    std::size_t iBucket = 0;
+    for (std::uint32_t limit = kBucket0; cycles >= limit && iBucket < kBuckets - 1; limit <<= 2)
+        ++iBucket;
+    ++s.histogram[iBucket];
+    }
+
+void cPerf::reset()
+    {
+    std::memset(sStats, 0, sizeof(sStats));
+    }
+
+#endif /* CATENA4610_PERF */
+
+const char *cPerf::getProbeName(PerfProbe probe)
+    {
+    switch (probe)
+        {
+    case PerfProbe::Poll:           return "poll";
+    case PerfProbe::Fed3Rx:         return "fed3-rx";
+    case PerfProbe::Supply:         return "supply";
+    case PerfProbe::FsmEval:        return "fsm-eval";
+    case PerfProbe::FillTxBuffer:   return "fill-tx";
+    case PerfProbe::LogAppend:      return "log-append";
+    default:                        return "<<unknown>>";
+        }
+    }
@@ -0,0 +1,171 @@
+/*
+
+Module: Catena4610_cPerf.h
+
+Function:
+    cPerf: lightweight on-target profiling probes.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cPerf_h_
+# define _Catena4610_cPerf_h_
+
+#pragma once
+
+// set to 0 to compile the probes out entirely.
+#ifndef CATENA4610_PERF
+# define CATENA4610_PERF 1
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+// the places we measure. Add new probes before Count, and give them a
+// name in cPerf::getProbeName().
+enum class PerfProbe : std::uint8_t
+    {
+    Poll,           // cMeasurementLoop::poll(), all of it
+    Fed3Rx,         // updatePelletFeederData()
+    Supply,         // supply voltage sampling in poll()
+    FsmEval,        // FSM evaluation from poll()
+    FillTxBuffer,   // building an uplink
+    LogAppend,      // appending an event to the flash log
+    Count           // number of probes; must be last
+    };
+
+/*
+
+Class:  cPerf
+
+Description:
+    Each probe accumulates the count, minimum, maximum and total of the
+    times recorded against it, and a histogram with kBuckets buckets,
+    each four times as wide as the one before: bucket 0 is under
+    kBucket0 cycles, bucket 1 under 4 * kBucket0, and so on; the last
+    takes everything else.
+
+    Times are in CPU cycles. The Cortex-M0+ has no DWT cycle counter,
+    so the cycle count is made from millis() and the SysTick counter,
+    which counts down once per cycle and reloads every millisecond.
+    Where there is no SysTick, micros() is used, and a "cycle" is a
+    microsecond.
+
+    Nothing is counted while the CPU is stopped, so a measurement that
+    spans a deep sleep is discarded: see cancelAll().
+
+    With CATENA4610_PERF set to 0, CATENA4610_PERF_SCOPE() expands to
+    nothing and no probe code is compiled in.
+
+*/
+
+class cPerf
+    {
+public:
+    static constexpr std::size_t kProbes = std::size_t(PerfProbe::Count);
+    static constexpr std::size_t kBuckets = 8;
+    static constexpr std::uint32_t kBucket0 = 256;
+
+    struct Stats
+        {
+        std::uint32_t   count;
+        std::uint32_t   min;
+        std::uint32_t   max;
+        std::uint64_t   total;
+        std::uint32_t   histogram[kBuckets];
+        };
+
+    static constexpr bool isEnabled()
+        {
+        return CATENA4610_PERF != 0;
+        }
+
+    // the free-running cycle counter.
+    static std::uint32_t getCycles();
+    // cycles per microsecond, for printing.
+    static std::uint32_t getCyclesPerUs();
+
+    static void record(PerfProbe probe, std::uint32_t cycles);
+    static const Stats &getStats(PerfProbe probe)
+        {
+        return sStats[unsigned(probe)];
+        }
+    static void reset();
+    static const char *getProbeName(PerfProbe probe);
+
+    // discard every measurement in progress; called before the CPU
+    // stops.
+    static void cancelAll()
+        {
+        ++sEpoch;
+        }
+    static std::uint32_t getEpoch()
+        {
+        return sEpoch;
+        }
+
+private:
+    static Stats                    sStats[kProbes];
+    static std::uint32_t            sEpoch;
+    };
+
+/*
+
+Class:  cPerfScope
+
+Description:
+    Records the time from construction to destruction against a probe.
+    Use it through CATENA4610_PERF_SCOPE(), so that it disappears when
+    the probes are disabled.
+
+*/
+
+class cPerfScope
+    {
+public:
+    cPerfScope(PerfProbe probe)
+        : m_tStart(cPerf::getCycles())
+        , m_epoch(cPerf::getEpoch())
+        , m_probe(probe)
+        {}
+    ~cPerfScope()
+        {
+        std::uint32_t const tEnd = cPerf::getCycles();
+
+        if (this->m_epoch == cPerf::getEpoch())
+            cPerf::record(this->m_probe, tEnd - this->m_tStart);
+        }
+
+    // neither copyable nor movable
+    cPerfScope(const cPerfScope&) = delete;
+    cPerfScope& operator=(const cPerfScope&) = delete;
+    cPerfScope(const cPerfScope&&) = delete;
+    cPerfScope& operator=(const cPerfScope&&) = delete;
+
+private:
+    std::uint32_t                   m_tStart;
+    std::uint32_t                   m_epoch;
+    PerfProbe                       m_probe;
+    };
+
+} // namespace McciCatena4610
+
+#if CATENA4610_PERF
+# define CATENA4610_PERF_CONCAT2_(a, b)     a ## b
+# define CATENA4610_PERF_CONCAT_(a, b)      CATENA4610_PERF_CONCAT2_(a, b)
+# define CATENA4610_PERF_SCOPE(probe)       \
+    McciCatena4610::cPerfScope CATENA4610_PERF_CONCAT_(perfScope_, __LINE__)(McciCatena4610::PerfProbe::probe)
+# define CATENA4610_PERF_CANCEL()           McciCatena4610::cPerf::cancelAll()
+#else
+# define CATENA4610_PERF_SCOPE(probe)       do { } while (0)
+# define CATENA4610_PERF_CANCEL()           do { } while (0)
+#endif
+
+#endif /* _Catena4610_cPerf_h_ */
@@ -0,0 +1,200 @@
+/*
+
+Module: Catena4610_cRingQueue.h
+
+Function:
+    cRingQueue: fixed-capacity FIFO with constant-time push and pop.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cRingQueue_h_
+# define _Catena4610_cRingQueue_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/****************************************************************************\
+|
+|   What to do when a queue is full
+|
+\****************************************************************************/
+
+enum class QueueOverflowPolicy : std::uint8_t
+    {
+    DropOldest,     // discard the entry at the head to make room
+    DropNewest,     // discard the entry being pushed
+    Coalesce,       // overwrite the entry at the tail with the new one
+    };
+
+/****************************************************************************\
+|
+|   The queue
+|
+\****************************************************************************/
+
+/*
+
+Class:  cRingQueue<T, kCapacity>
+
+Description:
+    Entries are stored in place in a circular array; nothing is ever
+    moved. push() and pop() are O(1) regardless of depth.
+
+    When the queue is full, push() applies the overflow policy and
+    counts the lost entry in getDropCount(). Coalesce is meant for
+    records, like FED3 events, whose counters are cumulative: the newest
+    record supersedes the one it replaces, so only the detail of the
+    replaced event is lost.
+
+    Not interrupt-safe; push and pop from the same context.
+
+*/
+
+template <typename T, std::size_t kCapacity>
+class cRingQueue
+    {
+public:
+    static_assert(kCapacity > 0 && kCapacity < 256, "capacity must be 1..255");
+
+    cRingQueue(QueueOverflowPolicy policy = QueueOverflowPolicy::DropOldest)
+        : m_policy(policy)
+        {}
+
+    // neither copyable nor movable
+    cRingQueue(const cRingQueue&) = delete;
+    cRingQueue& operator=(const cRingQueue&) = delete;
+    cRingQueue(const cRingQueue&&) = delete;
+    cRingQueue& operator=(const cRingQueue&&) = delete;
+
+    static constexpr std::size_t capacity()
+        {
+        return kCapacity;
+        }
+    std::size_t size() const
+        {
+        return this->m_count;
+        }
+    bool empty() const
+        {
+        return this->m_count == 0;
+        }
+    bool full() const
+        {
+        return this->m_count == kCapacity;
+        }
+
+    QueueOverflowPolicy getPolicy() const
+        {
+        return this->m_policy;
+        }
+    void setPolicy(QueueOverflowPolicy policy)
+        {
+        this->m_policy = policy;
+        }
+
+    // number of entries lost to overflow since the last clear().
+    std::uint32_t getDropCount() const
+        {
+        return this->m_nDropped;
+        }
+
+    void clear()
+        {
+        this->m_head = 0;
+        this->m_count = 0;
+        this->m_nDropped = 0;
+        }
+
+    // add an entry at the tail. Returns false if anything was lost.
+    bool push(const T &v)
+        {
+        if (this->full())
+            {
+            ++this->m_nDropped;
+
+            switch (this->m_policy)
+                {
+            case QueueOverflowPolicy::DropNewest:
+                return false;
+
+            case QueueOverflowPolicy::Coalesce:
+                this->m_entries[this->index(kCapacity - 1)] = v;
+                return false;
+
+            case QueueOverflowPolicy::DropOldest:
+            default:
+                this->m_entries[this->m_head] = v;
+                this->m_head = this->index(1);
+                return false;
+                }
+            }
+
+        this->m_entries[this->index(this->m_count)] = v;
+        ++this->m_count;
+        return true;
+        }
+
+    // the entry at the head, or nullptr if empty.
+    const T *peek() const
+        {
+        return this->empty() ? nullptr : &this->m_entries[this->m_head];
+        }
+
+    // the i-th entry from the head, or nullptr if there isn't one.
+    const T *peek(std::size_t i) const
+        {
+        return i < this->m_count ? &this->m_entries[this->index(i)] : nullptr;
+        }
+
+    // remove the entry at the head. Returns false if empty.
+    bool pop(T &v)
+        {
+        if (this->empty())
+            return false;
+
+        v = this->m_entries[this->m_head];
+        return this->pop();
+        }
+
+    // discard the entry at the head. Returns false if empty.
+    bool pop()
+        {
+        if (this->empty())
+            return false;
+
+        this->m_head = this->index(1);
+        --this->m_count;
+        return true;
+        }
+
+private:
+    // physical slot of the i-th entry from the head.
+    std::uint8_t index(std::size_t i) const
+        {
+        std::size_t n = this->m_head + i;
+
+        if (n >= kCapacity)
+            n -= kCapacity;
+        return std::uint8_t(n);
+        }
+
+    T                       m_entries[kCapacity];
+    std::uint8_t            m_head = 0;
+    std::uint8_t            m_count = 0;
+    QueueOverflowPolicy     m_policy;
+    std::uint32_t           m_nDropped = 0;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cRingQueue_h_ */
@@ -0,0 +1,103 @@
+/*
+
+Module: Catena4610_cSerialWakeup.cpp
+
+Function:
+    cSerialWakeup: let the FED3 UART wake the Catena from deep sleep.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cSerialWakeup.h"
+
+#include <Arduino.h>
+
+using namespace McciCatena4610;
+
+constexpr std::uint32_t cSerialWakeup::kStopClockHz;
+
+#if defined(ARDUINO_ARCH_STM32) && defined(USART1) && defined(USART_CR1_UESM) && defined(RCC_CCIPR_USART1SEL)
+# define CATENA4610_SERIAL_WAKEUP 1
+#else
+# define CATENA4610_SERIAL_WAKEUP 0
+#endif
+
+#if CATENA4610_SERIAL_WAKEUP
+static std::uint32_t computeBrr(std::uint32_t clockHz, std::uint32_t baud)
+    {
+    if (USART1->CR1 & USART_CR1_OVER8)
+        {
+        std::uint32_t const div = (2 * clockHz + baud / 2) / baud;
+        return (div & ~0xFu) | ((div & 0xFu) >> 1);
+        }
+    else
+        return (clockHz + baud / 2) / baud;
+    }
+#endif
+
+/*
+
+Name:   McciCatena4610::cSerialWakeup::begin()
+
+Function:
+    Let Serial1 receive, and wake the CPU, in STOP mode.
+
+Definition:
+    bool McciCatena4610::cSerialWakeup::begin(
+            std::uint32_t baud
+            );
+
+Description:
+    Serial1 must already have been started at baud. The USART is
+    briefly disabled while its clock is moved to HSI16 and the baud
+    rate divisor recomputed to suit; call this before the FED3 can
+    be sending.
+
+Returns:
+    true if Serial1 will now wake us from deep sleep.
+
+*/
+
+bool cSerialWakeup::begin(std::uint32_t baud)
+    {
+#if CATENA4610_SERIAL_WAKEUP
+    if (baud == 0)
+        return false;
+
+    if (this->m_fEnabled)
+        this->end();
+
+    this->m_savedBrr = USART1->BRR;
+    this->m_savedClockSel = RCC->CCIPR & RCC_CCIPR_USART1SEL;
+
+    USART1->CR1 &= ~USART_CR1_UE;
+    RCC->CCIPR = (RCC->CCIPR & ~RCC_CCIPR_USART1SEL) | RCC_CCIPR_USART1SEL_1;
+    USART1->BRR = computeBrr(kStopClockHz, baud);
+    USART1->CR1 |= USART_CR1_UESM | USART_CR1_UE;
+
+    this->m_fEnabled = true;
+    return true;
+#else
+    (void) baud;
+    return false;
+#endif
+    }
+
+void cSerialWakeup::end()
+    {
+#if CATENA4610_SERIAL_WAKEUP
+    if (! this->m_fEnabled)
+        return;
+
+    USART1->CR1 &= ~(USART_CR1_UE | USART_CR1_UESM);
+    RCC->CCIPR = (RCC->CCIPR & ~RCC_CCIPR_USART1SEL) | this->m_savedClockSel;
+    USART1->BRR = this->m_savedBrr;
+    USART1->CR1 |= USART_CR1_UE;
+#endif
+    this->m_fEnabled = false;
+    }
@@ -0,0 +1,84 @@
+/*
+
+Module: Catena4610_cSerialWakeup.h
+
+Function:
+    cSerialWakeup: let the FED3 UART wake the Catena from deep sleep.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cSerialWakeup_h_
+# define _Catena4610_cSerialWakeup_h_
+
+#pragma once
+
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cSerialWakeup
+
+Description:
+    The FED3 is on Serial1, which is USART1 of the STM32L0. Deep sleep
+    is STOP mode, which stops the clock the USART normally runs from,
+    so a frame sent while we sleep would be lost.
+
+    The USART can instead run from HSI16 and be left enabled in STOP
+    mode (UESM). It then starts HSI16 itself when it sees a start bit,
+    receives the byte, and the ordinary receive interrupt wakes the
+    CPU. Nothing is missed, not even the byte that woke us, so the
+    first frame after a deep sleep arrives intact.
+
+    HSI16 is already running whenever the CPU is, so the USART is
+    simply left on HSI16 from begin() onwards; there is nothing to do
+    on the way into or out of each sleep, and no window in which a
+    byte could be lost while the USART is reconfigured.
+
+    On other targets begin() fails, and deep sleep should not be used
+    while a FED3 is attached.
+
+*/
+
+class cSerialWakeup
+    {
+public:
+    // the USART kernel clock while in STOP mode: HSI16.
+    static constexpr std::uint32_t kStopClockHz = 16000000;
+
+    cSerialWakeup() {}
+
+    // neither copyable nor movable
+    cSerialWakeup(const cSerialWakeup&) = delete;
+    cSerialWakeup& operator=(const cSerialWakeup&) = delete;
+    cSerialWakeup(const cSerialWakeup&&) = delete;
+    cSerialWakeup& operator=(const cSerialWakeup&&) = delete;
+
+    // switch Serial1, already started at the given baud rate, over to
+    // receiving in STOP mode. Returns true if supported.
+    bool begin(std::uint32_t baud);
+    // put Serial1 back on its usual clock.
+    void end();
+
+    bool isEnabled() const
+        {
+        return this->m_fEnabled;
+        }
+
+private:
+    bool                            m_fEnabled = false;
+    // USART1 settings to restore at end().
+    std::uint32_t                   m_savedBrr = 0;
+    std::uint32_t                   m_savedClockSel = 0;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cSerialWakeup_h_ */
@@ -0,0 +1,139 @@
+/*
+
+Module: Catena4610_cSupplySampler.cpp
+
+Function:
+    cSupplySampler: cached, rate-limited supply voltage readings.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cSupplySampler.h"
+
+using namespace McciCatena4610;
+
+constexpr std::size_t cSupplySampler::kChannels;
+constexpr std::uint32_t cSupplySampler::kPeriodDefault;
+constexpr std::uint8_t cSupplySampler::kEmaShiftDefault;
+
+void cSupplySampler::setFilter(Filter filter, std::uint8_t emaShift)
+    {
+    this->m_filter = filter;
+    this->m_emaShift = emaShift < 8 ? emaShift : 7;
+    for (auto &ch : this->m_channel)
+        ch.nRaw = 0;
+    }
+
+void cSupplySampler::poll(std::uint32_t tNow)
+    {
+    ChannelState *pStalest = nullptr;
+
+    for (auto &ch : this->m_channel)
+        {
+        if (! this->isStale(ch, tNow))
+            continue;
+
+        if (pStalest == nullptr || ! ch.fValid ||
+            (pStalest->fValid && tNow - ch.tSample > tNow - pStalest->tSample))
+            pStalest = &ch;
+        }
+
+    if (pStalest != nullptr)
+        this->refresh(Channel(pStalest - this->m_channel), tNow);
+    }
+
+float cSupplySampler::get(Channel c, std::uint32_t tNow)
+    {
+    auto const &ch = this->m_channel[unsigned(c)];
+
+    if (this->isStale(ch, tNow))
+        return this->refresh(c, tNow);
+
+    return ch.value;
+    }
+
+/*
+
+Name:   McciCatena4610::cSupplySampler::refresh()
+
+Function:
+    Sample a channel, and fold the sample into its filtered value.
+
+Definition:
+    float McciCatena4610::cSupplySampler::refresh(
+            Channel c,
+            std::uint32_t tNow
+            );
+
+Description:
+    The first sample after begin, invalidate() or setFilter() is taken
+    as is. After that, with Filter::Ema, the value moves 1 / 2^emaShift
+    of the way towards each sample; with Filter::Median3, it's the
+    median of the last three samples (or the latest, until there are
+    three).
+
+Returns:
+    The new value.
+
+*/
+
+float cSupplySampler::refresh(Channel c, std::uint32_t tNow)
+    {
+    auto &ch = this->m_channel[unsigned(c)];
+    float const v = ch.pRead ? ch.pRead() : 0.0f;
+
+    ++this->m_nReads;
+
+    switch (this->m_filter)
+        {
+    case Filter::Ema:
+        if (ch.nRaw == 0)
+            ch.value = v;
+        else
+            ch.value += (v - ch.value) / float(1u << this->m_emaShift);
+        ch.nRaw = 1;
+        break;
+
+    case Filter::Median3:
+        ch.raw[0] = ch.raw[1];
+        ch.raw[1] = ch.raw[2];
+        ch.raw[2] = v;
+        if (ch.nRaw < 3)
+            ++ch.nRaw;
+
+        if (ch.nRaw < 3)
+            ch.value = v;
+        else
+            {
+            float const a = ch.raw[0];
+            float const b = ch.raw[1];
+            float const x = ch.raw[2];
+
+            ch.value = (a > b) ? ((b > x) ? b : (a > x) ? x : a)
+                               : ((a > x) ? a : (b > x) ? x : b);
+            }
+        break;
+
+    default:
+        ch.value = v;
+        break;
+        }
+
+    ch.tSample = tNow;
+    ch.fValid = true;
+    return ch.value;
+    }
+
+void cSupplySampler::invalidate()
+    {
+    for (auto &ch : this->m_channel)
+        {
+        ch.fValid = false;
+        ch.nRaw = 0;
+        }
+    }
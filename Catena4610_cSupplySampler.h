@@ -0,0 +1,154 @@
+/*
+
+Module: Catena4610_cSupplySampler.h
+
+Function:
+    cSupplySampler: cached, rate-limited supply voltage readings.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cSupplySampler_h_
+# define _Catena4610_cSupplySampler_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cSupplySampler
+
+Description:
+    Each supply voltage is an ADC conversion, which takes time and
+    power. The sampler reads each channel at most once per period, and
+    everyone else uses the cached value.
+
+    poll() refreshes at most one stale channel per call, so the
+    conversions are spread out rather than all landing on one pass of
+    the loop. get() returns the cached value, first taking a new sample
+    if the cached one is older than the period (or there isn't one);
+    peek() never samples.
+
+    Samples can be smoothed, either with an exponential moving average
+    (each sample moves the value 1 / 2^emaShift of the way) or with the
+    median of the last three samples, which throws out single spikes.
+
+    The channels are read through plain function pointers, and the time
+    is passed in, so the sampler doesn't depend on Arduino and its reads
+    can be counted off-target; test/test_cSupplySampler.cpp does.
+
+    The Catena 4610 senses Vbat and Vbus; it has no separate Vsys
+    sense, so there's no channel for it.
+
+*/
+
+class cSupplySampler
+    {
+public:
+    enum class Channel : std::uint8_t
+        {
+        Vbat,
+        Vbus,
+        Count           // number of channels; must be last
+        };
+    static constexpr std::size_t kChannels = std::size_t(Channel::Count);
+
+    enum class Filter : std::uint8_t
+        {
+        None,
+        Ema,
+        Median3,
+        };
+
+    static constexpr std::uint32_t kPeriodDefault = 1000;
+    static constexpr std::uint8_t kEmaShiftDefault = 2;
+
+    // read a channel: returns volts.
+    using ReadFn_t = float (*)();
+
+    cSupplySampler() {}
+
+    // neither copyable nor movable
+    cSupplySampler(const cSupplySampler&) = delete;
+    cSupplySampler& operator=(const cSupplySampler&) = delete;
+    cSupplySampler(const cSupplySampler&&) = delete;
+    cSupplySampler& operator=(const cSupplySampler&&) = delete;
+
+    // set the reader for a channel; nullptr reads as 0 V.
+    void setReader(Channel c, ReadFn_t pRead)
+        {
+        this->m_channel[unsigned(c)].pRead = pRead;
+        }
+
+    // every channel is sampled at most once per periodMs.
+    void setPeriod(std::uint32_t periodMs)
+        {
+        this->m_periodMs = periodMs;
+        }
+    std::uint32_t getPeriod() const
+        {
+        return this->m_periodMs;
+        }
+
+    // choose the smoothing; this restarts it.
+    void setFilter(Filter filter, std::uint8_t emaShift = kEmaShiftDefault);
+    Filter getFilter() const
+        {
+        return this->m_filter;
+        }
+
+    // refresh the stalest channel, if any is due.
+    void poll(std::uint32_t tNow);
+    // the value of a channel, sampling it first if it's stale.
+    float get(Channel c, std::uint32_t tNow);
+    // the cached value of a channel; 0 if never sampled.
+    float peek(Channel c) const
+        {
+        return this->m_channel[unsigned(c)].value;
+        }
+    // sample a channel now, whether or not it's due.
+    float refresh(Channel c, std::uint32_t tNow);
+    // forget everything, so every channel is sampled on next use.
+    void invalidate();
+
+    // number of ADC reads made.
+    std::uint32_t getReadCount() const
+        {
+        return this->m_nReads;
+        }
+
+private:
+    struct ChannelState
+        {
+        ReadFn_t        pRead = nullptr;
+        float           value = 0.0f;
+        float           raw[3] = {};
+        std::uint32_t   tSample = 0;
+        std::uint8_t    nRaw = 0;
+        bool            fValid = false;
+        };
+
+    bool isStale(const ChannelState &ch, std::uint32_t tNow) const
+        {
+        return ! ch.fValid || tNow - ch.tSample >= this->m_periodMs;
+        }
+
+    ChannelState                    m_channel[kChannels];
+    std::uint32_t                   m_periodMs = kPeriodDefault;
+    std::uint32_t                   m_nReads = 0;
+    Filter                          m_filter = Filter::None;
+    std::uint8_t                    m_emaShift = kEmaShiftDefault;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cSupplySampler_h_ */
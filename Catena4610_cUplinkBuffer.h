@@ -0,0 +1,106 @@
+/*
+
+Module: Catena4610_cUplinkBuffer.h
+
+Function:
+    cUplinkBuffer: an uplink payload, encoded in place.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cUplinkBuffer_h_
+# define _Catena4610_cUplinkBuffer_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cUplinkBuffer<kCapacity>
+
+Description:
+    Like McciCatena::AbstractTxBuffer_t, but an encoder can also
+    reserve space with append() and fill it in place, so a payload is
+    written once, where it's sent from, rather than built elsewhere and
+    put() in a byte at a time.
+
+    Writes that don't fit are dropped, as with AbstractTxBuffer_t.
+
+*/
+
+template <std::size_t kCapacity>
+class cUplinkBuffer
+    {
+public:
+    cUplinkBuffer() {}
+
+    // neither copyable nor movable: payloads are passed by reference.
+    cUplinkBuffer(const cUplinkBuffer&) = delete;
+    cUplinkBuffer& operator=(const cUplinkBuffer&) = delete;
+    cUplinkBuffer(const cUplinkBuffer&&) = delete;
+    cUplinkBuffer& operator=(const cUplinkBuffer&&) = delete;
+
+    void begin()
+        {
+        this->m_n = 0;
+        }
+
+    void put(std::uint8_t v)
+        {
+        if (this->m_n < kCapacity)
+            this->m_buffer[this->m_n++] = v;
+        }
+
+    void put(const std::uint8_t *pData, std::size_t nData)
+        {
+        if (auto const p = this->append(nData))
+            std::memcpy(p, pData, nData);
+        }
+
+    // reserve the next nData bytes, for the caller to fill in. Returns
+    // nullptr, and reserves nothing, if they don't fit.
+    std::uint8_t *append(std::size_t nData)
+        {
+        if (nData > kCapacity - this->m_n)
+            return nullptr;
+
+        std::uint8_t * const p = this->m_buffer + this->m_n;
+        this->m_n += nData;
+        return p;
+        }
+
+    std::uint8_t *getbase()
+        {
+        return this->m_buffer;
+        }
+    const std::uint8_t *getbase() const
+        {
+        return this->m_buffer;
+        }
+    std::size_t getn() const
+        {
+        return this->m_n;
+        }
+    static constexpr std::size_t getCapacity()
+        {
+        return kCapacity;
+        }
+
+private:
+    std::size_t         m_n = 0;
+    std::uint8_t        m_buffer[kCapacity];
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cUplinkBuffer_h_ */
@@ -0,0 +1,194 @@
+/*
+
+Module: Catena4610_cUplinkScheduler.cpp
+
+Function:
+    cUplinkScheduler: decide when to uplink queued FED3 events.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cUplinkScheduler.h"
+
+using namespace McciCatena4610;
+
+constexpr std::uint32_t cUplinkScheduler::kNever;
+
+void cUplinkScheduler::begin(std::uint32_t tNow)
+    {
+    this->m_budgetUs = this->m_config.budgetCapMs * 1000;
+    this->m_tBudget = tNow;
+    this->m_tLastUplink = tNow;
+    this->m_fPending = false;
+    this->m_fHighPending = false;
+    this->m_fHaveEvent = false;
+    this->m_fHaveGap = false;
+    this->m_meanGapMs = 0;
+    }
+
+// the budget refills by dutyPermille us each ms.
+std::uint32_t cUplinkScheduler::getBudgetUs(std::uint32_t tNow) const
+    {
+    std::uint32_t const capUs = this->m_config.budgetCapMs * 1000;
+    std::uint64_t const budgetUs = this->m_budgetUs +
+        std::uint64_t(tNow - this->m_tBudget) * this->m_config.dutyPermille;
+
+    return budgetUs > capUs ? capUs : std::uint32_t(budgetUs);
+    }
+
+void cUplinkScheduler::noteEvent(std::uint32_t tNow, Priority priority)
+    {
+    if (this->m_fHaveEvent)
+        {
+        std::uint32_t gap = tNow - this->m_tLastEvent;
+
+        // a long silence just means "idle"; don't let it swamp the mean.
+        if (gap > this->m_config.idleAfterMs)
+            gap = this->m_config.idleAfterMs;
+
+        if (! this->m_fHaveGap)
+            this->m_meanGapMs = gap;
+        else
+            this->m_meanGapMs = std::uint32_t(
+                std::int32_t(this->m_meanGapMs) +
+                (std::int32_t(gap) - std::int32_t(this->m_meanGapMs)) / 4
+                );
+        this->m_fHaveGap = true;
+        }
+
+    this->m_tLastEvent = tNow;
+    this->m_fHaveEvent = true;
+
+    if (! this->m_fPending)
+        {
+        this->m_tFirstPending = tNow;
+        this->m_fPending = true;
+        }
+
+    if (priority == Priority::High && ! this->m_fHighPending)
+        {
+        this->m_tFirstHigh = tNow;
+        this->m_fHighPending = true;
+        }
+    }
+
+void cUplinkScheduler::noteUplink(
+    std::uint32_t tNow,
+    std::uint32_t airtimeMs,
+    std::uint32_t nLeft
+    )
+    {
+    std::uint32_t const budgetUs = this->getBudgetUs(tNow);
+    std::uint32_t const costUs = airtimeMs * 1000;
+
+    this->m_budgetUs = budgetUs > costUs ? budgetUs - costUs : 0;
+    this->m_tBudget = tNow;
+    this->m_tLastUplink = tNow;
+    ++this->m_nUplinks;
+    this->m_airtimeMs += airtimeMs;
+
+    // whatever is left is at least as old as the uplink, so it goes as
+    // soon as the budget allows.
+    if (nLeft == 0)
+        this->m_fPending = this->m_fHighPending = false;
+    }
+
+bool cUplinkScheduler::isActive(std::uint32_t tNow) const
+    {
+    return this->m_fHaveGap &&
+           this->m_meanGapMs < this->m_config.activeGapMs &&
+           ! this->isIdle(tNow);
+    }
+
+/*
+
+Name:   McciCatena4610::cUplinkScheduler::getDelayMs()
+
+Function:
+    Decide how long to hold the pending events.
+
+Definition:
+    std::uint32_t McciCatena4610::cUplinkScheduler::getDelayMs(
+            std::uint32_t tNow,
+            std::uint32_t nPending,
+            std::uint32_t nPerUplink,
+            std::uint32_t airtimeMs
+            ) const;
+
+Description:
+    The hold is measured from the arrival of the oldest pending event;
+    see the class description for how long it is. A pending high
+    priority event cuts it short. Events that the scheduler wasn't told
+    about (for example, after a reboot) go at once. Then, if the budget
+    can't cover airtimeMs (or budgetCapMs, if that's less), the delay
+    is stretched until it can.
+
+Returns:
+    The delay in milliseconds; 0 to send now; kNever if nPending is 0.
+
+*/
+
+std::uint32_t cUplinkScheduler::getDelayMs(
+    std::uint32_t tNow,
+    std::uint32_t nPending,
+    std::uint32_t nPerUplink,
+    std::uint32_t airtimeMs
+    ) const
+    {
+    if (nPending == 0)
+        return kNever;
+
+    std::uint32_t delay = 0;
+
+    if (this->m_fPending && nPending < nPerUplink)
+        {
+        std::uint32_t hold = this->m_config.minHoldMs;
+
+        if (this->isActive(tNow))
+            {
+            std::uint32_t const tFill = (nPerUplink - nPending) * this->m_meanGapMs;
+
+            if (tFill > hold)
+                hold = tFill;
+            }
+        if (hold > this->m_config.maxLatencyMs)
+            hold = this->m_config.maxLatencyMs;
+
+        std::uint32_t const age = tNow - this->m_tFirstPending;
+        if (age < hold)
+            delay = hold - age;
+
+        if (this->m_fHighPending)
+            {
+            std::uint32_t const ageHigh = tNow - this->m_tFirstHigh;
+            std::uint32_t const delayHigh =
+                ageHigh < this->m_config.highLatencyMs ? this->m_config.highLatencyMs - ageHigh : 0;
+
+            if (delayHigh < delay)
+                delay = delayHigh;
+            }
+        }
+
+    std::uint32_t needUs = airtimeMs * 1000;
+    std::uint32_t const capUs = this->m_config.budgetCapMs * 1000;
+    std::uint32_t const budgetUs = this->getBudgetUs(tNow);
+
+    if (needUs > capUs)
+        needUs = capUs;
+
+    if (budgetUs < needUs)
+        {
+        std::uint32_t const permille = this->m_config.dutyPermille ? this->m_config.dutyPermille : 1;
+        std::uint32_t const tBudget = (needUs - budgetUs + permille - 1) / permille;
+
+        if (tBudget > delay)
+            delay = tBudget;
+        }
+
+    return delay;
+    }
@@ -0,0 +1,162 @@
+/*
+
+Module: Catena4610_cUplinkScheduler.h
+
+Function:
+    cUplinkScheduler: decide when to uplink queued FED3 events.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena4610_cUplinkScheduler_h_
+# define _Catena4610_cUplinkScheduler_h_
+
+#pragma once
+
+#include <cstdint>
+
+namespace McciCatena4610 {
+
+/*
+
+Class:  cUplinkScheduler
+
+Description:
+    Events are held back for a while, so that several go in one uplink,
+    but not for too long:
+
+    -   a full uplink's worth goes at once;
+    -   otherwise, the first event waits at least minHoldMs, so that a
+        burst (a poke, then a pellet) goes together;
+    -   while the animal is active (the mean gap between events is under
+        activeGapMs), it waits for as long as the uplink is expected to
+        take to fill;
+    -   but never more than maxLatencyMs.
+
+    High priority events aren't held for batching: they, and everything
+    queued before them, go within highLatencyMs (at once, by default).
+
+    Every uplink is charged against an air time budget, which refills at
+    dutyPermille of real time, up to budgetCapMs. An uplink that the
+    budget can't cover waits until it can.
+
+    The scheduler doesn't depend on Arduino: the time is passed in, and
+    it can be simulated off-target.
+
+*/
+
+class cUplinkScheduler
+    {
+public:
+    static constexpr std::uint32_t kNever = UINT32_MAX;
+
+    enum class Priority : std::uint8_t
+        {
+        Routine,        // batched
+        High,           // sent within highLatencyMs
+        };
+
+    struct Config
+        {
+        std::uint32_t   minHoldMs = 2 * 1000;
+        std::uint32_t   maxLatencyMs = 60 * 1000;
+        std::uint32_t   highLatencyMs = 0;
+        std::uint32_t   activeGapMs = 60 * 1000;
+        // no events for this long, and we're idle.
+        std::uint32_t   idleAfterMs = 10 * 60 * 1000;
+        // 1%, as in most EU868 sub-bands.
+        std::uint16_t   dutyPermille = 10;
+        std::uint32_t   budgetCapMs = 36 * 1000;
+        };
+
+    cUplinkScheduler() {}
+
+    // neither copyable nor movable
+    cUplinkScheduler(const cUplinkScheduler&) = delete;
+    cUplinkScheduler& operator=(const cUplinkScheduler&) = delete;
+    cUplinkScheduler(const cUplinkScheduler&&) = delete;
+    cUplinkScheduler& operator=(const cUplinkScheduler&&) = delete;
+
+    // start with a full budget and no history.
+    void begin(std::uint32_t tNow);
+    void setConfig(const Config &config)
+        {
+        this->m_config = config;
+        }
+    const Config &getConfig() const
+        {
+        return this->m_config;
+        }
+
+    // an event has been queued.
+    void noteEvent(std::uint32_t tNow, Priority priority = Priority::Routine);
+    // an uplink has been sent, taking airtimeMs; nLeft events are
+    // still waiting.
+    void noteUplink(std::uint32_t tNow, std::uint32_t airtimeMs, std::uint32_t nLeft);
+
+    // how long to wait before sending nPending events, given that an
+    // uplink holds nPerUplink of them and takes airtimeMs. 0 means now;
+    // kNever if there's nothing to send.
+    std::uint32_t getDelayMs(
+        std::uint32_t tNow,
+        std::uint32_t nPending,
+        std::uint32_t nPerUplink,
+        std::uint32_t airtimeMs
+        ) const;
+
+    bool isActive(std::uint32_t tNow) const;
+    bool isIdle(std::uint32_t tNow) const
+        {
+        return ! this->m_fHaveEvent ||
+               tNow - this->m_tLastEvent >= this->m_config.idleAfterMs;
+        }
+    std::uint32_t getMeanGapMs() const
+        {
+        return this->m_meanGapMs;
+        }
+    // air time available now, in ms.
+    std::uint32_t getBudgetMs(std::uint32_t tNow) const
+        {
+        return this->getBudgetUs(tNow) / 1000;
+        }
+    std::uint32_t getLastUplinkTime() const
+        {
+        return this->m_tLastUplink;
+        }
+    std::uint32_t getUplinkCount() const
+        {
+        return this->m_nUplinks;
+        }
+    std::uint32_t getAirtimeMs() const
+        {
+        return this->m_airtimeMs;
+        }
+
+private:
+    std::uint32_t getBudgetUs(std::uint32_t tNow) const;
+
+    Config                          m_config;
+    // air time budget in us, as of m_tBudget
+    std::uint32_t                   m_budgetUs = 0;
+    std::uint32_t                   m_tBudget = 0;
+    std::uint32_t                   m_tFirstPending = 0;
+    std::uint32_t                   m_tFirstHigh = 0;
+    std::uint32_t                   m_tLastEvent = 0;
+    std::uint32_t                   m_meanGapMs = 0;
+    std::uint32_t                   m_tLastUplink = 0;
+    std::uint32_t                   m_nUplinks = 0;
+    std::uint32_t                   m_airtimeMs = 0;
+    bool                            m_fPending = false;
+    bool                            m_fHighPending = false;
+    bool                            m_fHaveEvent = false;
+    bool                            m_fHaveGap = false;
+    };
+
+} // namespace McciCatena4610
+
+#endif /* _Catena4610_cUplinkScheduler_h_ */
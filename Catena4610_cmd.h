@@ -20,6 +20,12 @@ Author:
 
 #include <Catena_CommandStream.h>
 
+McciCatena::cCommandStream::CommandFn cmdBacklog;
+McciCatena::cCommandStream::CommandFn cmdBench;
+McciCatena::cCommandStream::CommandFn cmdFed3Gen;
 McciCatena::cCommandStream::CommandFn cmdLog;
+McciCatena::cCommandStream::CommandFn cmdMeas;
+McciCatena::cCommandStream::CommandFn cmdPerf;
+McciCatena::cCommandStream::CommandFn cmdSleep;
 
 #endif /* _Catena4610_cmd_h_ */
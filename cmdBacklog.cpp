@@ -0,0 +1,134 @@
+/*
+
+Module:	cmdBacklog.cpp
+
+Function:
+    Process the "backlog" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+#include <cstring>
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+/*
+
+Name:   ::cmdBacklog()
+
+Function:
+    Command dispatcher for "backlog" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdBacklog;
+
+    McciCatena::cCommandStream::CommandStatus cmdBacklog(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "backlog" command has the following syntax:
+
+    backlog
+        Display the number of FED3 events waiting, and the state of
+        the backfill.
+
+    backlog oldest
+    backlog newest
+        Send backlogged events oldest or newest first.
+
+    backlog dutycycle {percent}
+        Limit backfill to {percent} of air time.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "backlog"
+// argv[1] is the setting to change; if omitted, status is printed
+// argv[2] is the new duty cycle
+cCommandStream::CommandStatus cmdBacklog(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    if (argc == 1)
+        {
+        auto const &log = gMeasurementLoop.getEventLog();
+
+        pThis->printf(
+            "backlog: %u events, %u live\n",
+            unsigned(gMeasurementLoop.getBacklogDepth()),
+            unsigned(gMeasurementLoop.getLiveDepth())
+            );
+        if (log.isEnabled())
+            pThis->printf(
+                "log: %u of %u, %u dropped, %u corrupt\n",
+                unsigned(log.size()),
+                unsigned(log.capacity()),
+                unsigned(log.getDropCount()),
+                unsigned(log.getCorruptCount())
+                );
+        pThis->printf(
+            "link: %s, %u failed uplinks, %u events backfilled\n",
+            gMeasurementLoop.isLinkUp() ? "up" : "down",
+            unsigned(gMeasurementLoop.getUplinkFailures()),
+            unsigned(gMeasurementLoop.getBackfillCount())
+            );
+        pThis->printf(
+            "backfill: %s first, %u%% duty cycle\n",
+            gMeasurementLoop.getBackfillOrder() == cMeasurementLoop::BackfillOrder::NewestFirst
+                ? "newest" : "oldest",
+            gMeasurementLoop.getBackfillDutyCycle()
+            );
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "oldest") == 0)
+        {
+        gMeasurementLoop.setBackfillOrder(cMeasurementLoop::BackfillOrder::OldestFirst);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "newest") == 0)
+        {
+        gMeasurementLoop.setBackfillOrder(cMeasurementLoop::BackfillOrder::NewestFirst);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 3 && std::strcmp(argv[1], "dutycycle") == 0)
+        {
+        cCommandStream::CommandStatus status;
+        uint32_t nPercent;
+
+        status = cCommandStream::getuint32(argc, argv, 2, /*radix*/ 0, nPercent, /* default */ 0);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        if (nPercent < 1 || nPercent > 100)
+            return cCommandStream::CommandStatus::kInvalidParameter;
+
+        gMeasurementLoop.setBackfillDutyCycle(std::uint8_t(nPercent));
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else
+        return cCommandStream::CommandStatus::kInvalidParameter;
+    }
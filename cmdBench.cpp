@@ -0,0 +1,195 @@
+/*
+
+Module:	cmdBench.cpp
+
+Function:
+    Process the "bench" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+#include "Catena4610_cCrc16Modbus.h"
+#include <cstring>
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+// the baseline lives near the top of the FRAM, above the event log index.
+static constexpr std::uint32_t kBaselineFramOffset = 0x7F80;
+static constexpr std::uint16_t kBaselineMagic = 0x4E42;     // 'BN'
+static constexpr std::size_t kStages = cMeasurementLoop::kBenchStages;
+static constexpr std::size_t kBaselineSize = 2 + 1 + 4 * kStages + 2;
+
+// results of the last run.
+static std::uint32_t sResult[kStages];
+static bool sfResult;
+
+static bool loadBaseline(std::uint32_t (&ns)[kStages])
+    {
+    auto const pFram = gCatena.getFram();
+    std::uint8_t buf[kBaselineSize];
+
+    if (pFram == nullptr || ! pFram->read(kBaselineFramOffset, buf, sizeof(buf)))
+        return false;
+
+    if ((buf[0] | (buf[1] << 8)) != kBaselineMagic ||
+        buf[2] != kStages ||
+        cCrc16Modbus::compute(buf, sizeof(buf)) != 0)
+        return false;
+
+    for (std::size_t i = 0; i < kStages; ++i)
+        {
+        const std::uint8_t * const p = buf + 3 + 4 * i;
+        ns[i] = p[0] | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+        }
+    return true;
+    }
+
+static bool saveBaseline(const std::uint32_t (&ns)[kStages])
+    {
+    auto const pFram = gCatena.getFram();
+    std::uint8_t buf[kBaselineSize];
+
+    if (pFram == nullptr)
+        return false;
+
+    buf[0] = std::uint8_t(kBaselineMagic);
+    buf[1] = std::uint8_t(kBaselineMagic >> 8);
+    buf[2] = std::uint8_t(kStages);
+    for (std::size_t i = 0; i < kStages; ++i)
+        {
+        std::uint8_t * const p = buf + 3 + 4 * i;
+        p[0] = std::uint8_t(ns[i]);
+        p[1] = std::uint8_t(ns[i] >> 8);
+        p[2] = std::uint8_t(ns[i] >> 16);
+        p[3] = std::uint8_t(ns[i] >> 24);
+        }
+
+    std::uint16_t const crc = cCrc16Modbus::compute(buf, sizeof(buf) - 2);
+    buf[sizeof(buf) - 2] = std::uint8_t(crc);
+    buf[sizeof(buf) - 1] = std::uint8_t(crc >> 8);
+
+    return pFram->write(kBaselineFramOffset, buf, sizeof(buf));
+    }
+
+static void printResults(cCommandStream *pThis)
+    {
+    std::uint32_t baseline[kStages];
+    bool const fBaseline = loadBaseline(baseline);
+
+    for (std::size_t i = 0; i < kStages; ++i)
+        {
+        auto const name = cMeasurementLoop::getBenchStageName(cMeasurementLoop::BenchStage(i));
+
+        if (fBaseline && baseline[i] != 0)
+            {
+            std::int32_t const delta = std::int32_t(
+                (std::int64_t(sResult[i]) - baseline[i]) * 100 / std::int64_t(baseline[i])
+                );
+
+            pThis->printf(
+                "%-13s %8u ns/event (baseline %8u, %+d%%)\n",
+                name, unsigned(sResult[i]), unsigned(baseline[i]), int(delta)
+                );
+            }
+        else
+            pThis->printf("%-13s %8u ns/event\n", name, unsigned(sResult[i]));
+        }
+
+    // RAM for the loop, its buffers and its queue.
+    pThis->printf("%-13s %8u bytes\n", "loop-ram", unsigned(sizeof(cMeasurementLoop)));
+    }
+
+/*
+
+Name:   ::cmdBench()
+
+Function:
+    Command dispatcher for "bench" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdBench;
+
+    McciCatena::cCommandStream::CommandStatus cmdBench(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "bench" command has the following syntax:
+
+    bench [{count}]
+        Time each stage of handling a FED3 event over {count} events
+        (default 100), and print the nanoseconds per event. If a
+        baseline has been saved, each stage is compared with it.
+
+    bench save
+        Save the results of the last run as the baseline, in FRAM, so
+        it survives a firmware update.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "bench"
+// argv[1] is the count of events, or "save"
+cCommandStream::CommandStatus cmdBench(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    if (argc > 2)
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    if (argc == 2 && std::strcmp(argv[1], "save") == 0)
+        {
+        if (! sfResult)
+            {
+            pThis->printf("no results yet: run bench first\n");
+            return cCommandStream::CommandStatus::kError;
+            }
+        if (! saveBaseline(sResult))
+            return cCommandStream::CommandStatus::kError;
+
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+
+    cCommandStream::CommandStatus status;
+    uint32_t nIter;
+
+    status = cCommandStream::getuint32(argc, argv, 1, /*radix*/ 0, nIter, /* default */ 100);
+    if (status != cCommandStream::CommandStatus::kSuccess)
+        return status;
+    if (nIter == 0)
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    if (! gMeasurementLoop.runBenchmark(nIter, sResult))
+        {
+        pThis->printf("FED3 frame in progress: try again\n");
+        return cCommandStream::CommandStatus::kError;
+        }
+
+    sfResult = true;
+    printResults(pThis);
+    return cCommandStream::CommandStatus::kSuccess;
+    }
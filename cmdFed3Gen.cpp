@@ -0,0 +1,183 @@
+/*
+
+Module:	cmdFed3Gen.cpp
+
+Function:
+    Process the "fed3gen" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+#include <cstring>
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+// the counters as they were when the run started.
+static struct
+    {
+    std::uint16_t   nIn;
+    std::uint16_t   nErr;
+    std::uint32_t   nOverrun;
+    std::uint32_t   nQueueDropped;
+    std::uint32_t   nLogDropped;
+    } sBase;
+
+static void printReport(cCommandStream *pThis)
+    {
+    auto const &gen = gMeasurementLoop.getTrafficGen();
+    std::uint16_t const nIn = gMeasurementLoop.u16InCnt - sBase.nIn;
+    std::uint16_t const nErr = gMeasurementLoop.u16errCnt - sBase.nErr;
+    std::uint32_t const nDamaged = gen.getCorruptCount() + gen.getTruncateCount();
+    std::uint32_t const nGood = nIn > nErr ? nIn - nErr : 0;
+    std::uint32_t const nClean = gen.getFrameCount() - nDamaged;
+
+    pThis->printf(
+        "fed3gen: %s; sent %u frames (%u corrupt, %u short, %u back-to-back), %u bytes\n",
+        gen.isActive() ? "running" : "idle",
+        unsigned(gen.getFrameCount()),
+        unsigned(gen.getCorruptCount()),
+        unsigned(gen.getTruncateCount()),
+        unsigned(gen.getBackToBackCount()),
+        unsigned(gen.getByteCount())
+        );
+    pThis->printf(
+        "received: %u frames, %u bad; %u good frames missing\n",
+        unsigned(nIn),
+        unsigned(nErr),
+        unsigned(nClean > nGood ? nClean - nGood : 0)
+        );
+    pThis->printf(
+        "bytes lost: %u to a full UART buffer, %u to a full receive ring\n",
+        unsigned(gen.getOverrunCount()),
+        unsigned(gMeasurementLoop.getRxOverrunCount() - sBase.nOverrun)
+        );
+    pThis->printf(
+        "events lost: %u from queue, %u from log\n",
+        unsigned(gMeasurementLoop.getEventDropCount() - sBase.nQueueDropped),
+        unsigned(gMeasurementLoop.getEventLog().getDropCount() - sBase.nLogDropped)
+        );
+    }
+
+/*
+
+Name:   ::cmdFed3Gen()
+
+Function:
+    Command dispatcher for "fed3gen" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdFed3Gen;
+
+    McciCatena::cCommandStream::CommandStatus cmdFed3Gen(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "fed3gen" command has the following syntax:
+
+    fed3gen
+        Report on the current or last run: frames sent, received and
+        rejected, good frames that never arrived (merged with their
+        neighbours, or lost to a full buffer), bytes lost because the
+        loop didn't read them in time, and events lost to a full queue
+        or log.
+
+    fed3gen start {frames} [{interval-ms} [{burst} [{corrupt%} [{seed} [{devices}]]]]]
+        Feed {frames} made-up FED3 frames into the receiver, {burst}
+        at a time, back to back, one burst every {interval-ms}
+        (default 1000 ms, burst of 1). {corrupt%} of the frames are
+        damaged. The frames come from {devices} FED3s in turn (default
+        1), at addresses 1 and up. The events are treated like real
+        ones, so they will be logged and uplinked.
+
+    fed3gen stop
+        Stop the current run.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "fed3gen"
+// argv[1] is "start" or "stop"; if omitted, the report is printed
+// argv[2..] are the parameters of the run
+cCommandStream::CommandStatus cmdFed3Gen(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    if (argc == 1)
+        {
+        printReport(pThis);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "stop") == 0)
+        {
+        gMeasurementLoop.stopTrafficGen();
+        printReport(pThis);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc >= 3 && argc <= 8 && std::strcmp(argv[1], "start") == 0)
+        {
+        cCommandStream::CommandStatus status;
+        uint32_t nFrames, intervalMs, nBurst, corruptPercent, seed, nDevices;
+
+        status = cCommandStream::getuint32(argc, argv, 2, /*radix*/ 0, nFrames, /* default */ 0);
+        if (status == cCommandStream::CommandStatus::kSuccess)
+            status = cCommandStream::getuint32(argc, argv, 3, /*radix*/ 0, intervalMs, /* default */ 1000);
+        if (status == cCommandStream::CommandStatus::kSuccess)
+            status = cCommandStream::getuint32(argc, argv, 4, /*radix*/ 0, nBurst, /* default */ 1);
+        if (status == cCommandStream::CommandStatus::kSuccess)
+            status = cCommandStream::getuint32(argc, argv, 5, /*radix*/ 0, corruptPercent, /* default */ 0);
+        if (status == cCommandStream::CommandStatus::kSuccess)
+            status = cCommandStream::getuint32(argc, argv, 6, /*radix*/ 0, seed, /* default */ 1);
+        if (status == cCommandStream::CommandStatus::kSuccess)
+            status = cCommandStream::getuint32(argc, argv, 7, /*radix*/ 0, nDevices, /* default */ 1);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+
+        if (nFrames == 0 || nBurst < 1 || nBurst > 255 || corruptPercent > 100 ||
+            nDevices < 1 || nDevices > 247)
+            return cCommandStream::CommandStatus::kInvalidParameter;
+
+        sBase.nIn = gMeasurementLoop.u16InCnt;
+        sBase.nErr = gMeasurementLoop.u16errCnt;
+        sBase.nOverrun = gMeasurementLoop.getRxOverrunCount();
+        sBase.nQueueDropped = gMeasurementLoop.getEventDropCount();
+        sBase.nLogDropped = gMeasurementLoop.getEventLog().getDropCount();
+
+        cFed3TrafficGen::Config config;
+        config.nFrames = nFrames;
+        config.intervalMs = intervalMs;
+        config.nBurst = std::uint8_t(nBurst);
+        config.corruptPercent = std::uint8_t(corruptPercent);
+        config.seed = seed;
+        config.nDevices = std::uint8_t(nDevices);
+
+        gMeasurementLoop.startTrafficGen(config);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else
+        return cCommandStream::CommandStatus::kInvalidParameter;
+    }
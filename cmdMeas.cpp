@@ -0,0 +1,318 @@
+/*
+
+Module:	cmdMeas.cpp
+
+Function:
+    Process the "meas" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+#include <cstring>
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+static void printSettings(cCommandStream *pThis)
+    {
+    auto const settings = gMeasurementLoop.getSettings();
+    auto const &scheduler = gMeasurementLoop.getUplinkScheduler();
+
+    pThis->printf(
+        "interval: %u s, %u s idle, %u fast uplinks (now %u s)\n",
+        unsigned(settings.txCycleSec),
+        unsigned(settings.txCycleSecIdle),
+        unsigned(settings.txCycleCount),
+        unsigned(gMeasurementLoop.getTxCycleTime())
+        );
+    pThis->printf(
+        "batch: %s, compact: %s\n",
+        settings.fBatchUplinks ? "on" : "off",
+        settings.fCompactEncoding ? "on" : "off"
+        );
+    pThis->printf(
+        "summary: %s, every %u s\n",
+        settings.fSummaryMode ? "on" : "off",
+        unsigned(settings.summaryWindowSec)
+        );
+    pThis->printf("debug: %#x\n", unsigned(settings.debugFlags));
+    pThis->printf(
+        "queue: %u of %u, %u dropped; %u live, %u backlogged\n",
+        unsigned(gMeasurementLoop.getQueuedEventCount()),
+        unsigned(cMeasurementLoop::kEventQueueDepth * cMeasurementLoop::kEventQueues),
+        unsigned(gMeasurementLoop.getEventDropCount()),
+        unsigned(gMeasurementLoop.getLiveDepth()),
+        unsigned(gMeasurementLoop.getBacklogDepth())
+        );
+    for (std::uint8_t i = 0; i < cMeasurementLoop::kFed3Devices; ++i)
+        {
+        auto const &stats = gMeasurementLoop.getFed3DeviceStats(i);
+
+        pThis->printf(
+            "fed3 %u: %u frames, %u bad CRC, %u short, %u long",
+            unsigned(cMeasurementLoop::kFed3AddressFirst + i),
+            unsigned(stats.nFrames),
+            unsigned(stats.nCrcErrors),
+            unsigned(stats.nRunts),
+            unsigned(stats.nOverflows)
+            );
+
+        // with one queue, the totals above are the FED3s' too.
+        if (cMeasurementLoop::kEventQueues > 1)
+            {
+            auto const &queue = gMeasurementLoop.getEventQueue(i);
+
+            pThis->printf(
+                "; %u queued, %u dropped",
+                unsigned(queue.size()),
+                unsigned(queue.getDropCount())
+                );
+            }
+        pThis->printf("\n");
+
+        auto const &summary = gMeasurementLoop.getFed3Summary(i);
+
+        if (settings.fSummaryMode)
+            pThis->printf(
+                "  this window: %u events, %u left, %u right, %u pellets\n",
+                unsigned(summary.nEvents),
+                unsigned(summary.nLeftPokes),
+                unsigned(summary.nRightPokes),
+                unsigned(summary.nPellets)
+                );
+        }
+    if (gMeasurementLoop.getFed3UnknownAddressCount() != 0)
+        pThis->printf(
+            "fed3 other addresses: %u frames\n",
+            unsigned(gMeasurementLoop.getFed3UnknownAddressCount())
+            );
+    pThis->printf(
+        "uplinks: %u, %u ms air time, %u ms budget\n",
+        unsigned(scheduler.getUplinkCount()),
+        unsigned(scheduler.getAirtimeMs()),
+        unsigned(scheduler.getBudgetMs(millis()))
+        );
+    }
+
+static void printRam(cCommandStream *pThis)
+    {
+    std::size_t nListed = 0;
+
+    pThis->printf(
+        "%-14s %6u bytes, %u queued events\n",
+        "loop",
+        unsigned(sizeof(cMeasurementLoop)),
+        unsigned(cMeasurementLoop::kEventQueueDepth)
+        );
+
+    for (std::size_t i = 0; i < cMeasurementLoop::kRamReportCount; ++i)
+        {
+        auto const &c = cMeasurementLoop::kRamReport[i];
+
+        pThis->printf("  %-12s %6u\n", c.pName, unsigned(c.size));
+        nListed += c.size;
+        }
+
+    pThis->printf("  %-12s %6u\n", "other", unsigned(sizeof(cMeasurementLoop) - nListed));
+
+    // not part of the loop, but taken from the stack for each uplink.
+    pThis->printf(
+        "%-14s %6u bytes, on the stack\n",
+        "tx-buffer",
+        unsigned(sizeof(cMeasurementLoop::TxBuffer_t))
+        );
+    }
+
+static cCommandStream::CommandStatus getOnOff(const char *arg, bool &fValue)
+    {
+    if (std::strcmp(arg, "on") == 0)
+        fValue = true;
+    else if (std::strcmp(arg, "off") == 0)
+        fValue = false;
+    else
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    return cCommandStream::CommandStatus::kSuccess;
+    }
+
+/*
+
+Name:   ::cmdMeas()
+
+Function:
+    Command dispatcher for "meas" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdMeas;
+
+    McciCatena::cCommandStream::CommandStatus cmdMeas(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "meas" command has the following syntax:
+
+    meas
+        Display the measurement loop settings, the FED3 event queues,
+        receive statistics for each FED3 on the bus, and uplink
+        statistics.
+
+    meas interval {secs} [{idlesecs}]
+        Set the uplink interval, and optionally the interval while the
+        FED3 is idle.
+
+    meas fast {count}
+        Start over with {count} fast uplinks, as after boot.
+
+    meas batch {on|off}
+    meas compact {on|off}
+        Send FED3 events in batches; send batches with compact deltas.
+
+    meas summary {on|off} [{secs}]
+        Send each FED3's totals once every {secs} (format 0x26),
+        instead of its events. The window replaces the uplink
+        interval.
+
+    meas debug [{mask}]
+        Display or set the debug mask: 1 errors, 2 warnings, 4 trace,
+        8 info.
+
+    meas reset
+        Go back to the default settings.
+
+    meas ram
+        Display the RAM taken by the measurement loop, part by part.
+        The FED3 event queue depth is set at build time by
+        CATENA4610_EVENT_QUEUE_DEPTH, and whether each FED3 has a queue
+        of its own by CATENA4610_EVENT_QUEUE_PER_FED3.
+
+    Changes are saved in FRAM, and used from then on, even after a
+    reboot.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "meas"
+// argv[1] is the setting to change; if omitted, settings are printed
+// argv[2..] are the new values
+cCommandStream::CommandStatus cmdMeas(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    cCommandStream::CommandStatus status;
+    auto settings = gMeasurementLoop.getSettings();
+
+    if (argc == 1)
+        {
+        printSettings(pThis);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if ((argc == 3 || argc == 4) && std::strcmp(argv[1], "interval") == 0)
+        {
+        status = cCommandStream::getuint32(argc, argv, 2, /* radix */ 0, settings.txCycleSec, /* default */ 0);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+
+        status = cCommandStream::getuint32(argc, argv, 3, /* radix */ 0, settings.txCycleSecIdle, settings.txCycleSecIdle);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        }
+    else if (argc == 3 && std::strcmp(argv[1], "fast") == 0)
+        {
+        status = cCommandStream::getuint32(argc, argv, 2, /* radix */ 0, settings.txCycleCount, /* default */ 0);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+
+        // the same count starts over, too.
+        if (! gMeasurementLoop.applySettings(settings))
+            return cCommandStream::CommandStatus::kInvalidParameter;
+        // in summary mode, there are no fast uplinks.
+        if (! settings.fSummaryMode)
+            gMeasurementLoop.setTxCycleTime(
+                settings.txCycleCount != 0 ? cMeasurementLoop::kTxCycleSecFast : settings.txCycleSec,
+                settings.txCycleCount
+                );
+        if (! gMeasurementLoop.saveSettings())
+            pThis->printf("meas: no FRAM; settings not saved\n");
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 3 && std::strcmp(argv[1], "batch") == 0)
+        {
+        status = getOnOff(argv[2], settings.fBatchUplinks);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        }
+    else if (argc == 3 && std::strcmp(argv[1], "compact") == 0)
+        {
+        status = getOnOff(argv[2], settings.fCompactEncoding);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        }
+    else if ((argc == 3 || argc == 4) && std::strcmp(argv[1], "summary") == 0)
+        {
+        status = getOnOff(argv[2], settings.fSummaryMode);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+
+        status = cCommandStream::getuint32(argc, argv, 3, /* radix */ 0, settings.summaryWindowSec, settings.summaryWindowSec);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "debug") == 0)
+        {
+        pThis->printf("debug: %#x\n", unsigned(settings.debugFlags));
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 3 && std::strcmp(argv[1], "debug") == 0)
+        {
+        status = cCommandStream::getuint32(argc, argv, 2, /* radix */ 0, settings.debugFlags, /* default */ 0);
+        if (status != cCommandStream::CommandStatus::kSuccess)
+            return status;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "ram") == 0)
+        {
+        printRam(pThis);
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else if (argc == 2 && std::strcmp(argv[1], "reset") == 0)
+        {
+        if (! gMeasurementLoop.applySettings(cMeasurementLoop::getDefaultSettings()))
+            return cCommandStream::CommandStatus::kError;
+        if (! gMeasurementLoop.eraseSettings())
+            pThis->printf("meas: no FRAM; settings not erased\n");
+        return cCommandStream::CommandStatus::kSuccess;
+        }
+    else
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    if (! gMeasurementLoop.applySettings(settings))
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    if (! gMeasurementLoop.saveSettings())
+        pThis->printf("meas: no FRAM; settings not saved\n");
+
+    return cCommandStream::CommandStatus::kSuccess;
+    }
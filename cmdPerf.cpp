@@ -0,0 +1,117 @@
+/*
+
+Module:	cmdPerf.cpp
+
+Function:
+    Process the "perf" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+#include "Catena4610_cPerf.h"
+#include <cstring>
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+/*
+
+Name:   ::cmdPerf()
+
+Function:
+    Command dispatcher for "perf" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdPerf;
+
+    McciCatena::cCommandStream::CommandStatus cmdPerf(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "perf" command has the following syntax:
+
+    perf
+        For each profiling probe, display the number of times it ran,
+        the minimum, mean and maximum time in microseconds, and the
+        histogram of times in cycles. Then display how many supply
+        voltage ADC reads have been made.
+
+    perf reset
+        Display the probes, then clear them.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "perf"
+// argv[1] if present is "reset"
+cCommandStream::CommandStatus cmdPerf(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    bool const fReset = argc == 2 && std::strcmp(argv[1], "reset") == 0;
+
+    if (argc > 2 || (argc == 2 && ! fReset))
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+#if CATENA4610_PERF
+    std::uint32_t const cyclesPerUs = cPerf::getCyclesPerUs() ? cPerf::getCyclesPerUs() : 1;
+
+    pThis->printf("probe          count    min us   mean us    max us  histogram (<%u cycles, then x4)\n", unsigned(cPerf::kBucket0));
+    for (std::size_t i = 0; i < cPerf::kProbes; ++i)
+        {
+        auto const probe = PerfProbe(i);
+        auto const &s = cPerf::getStats(probe);
+        std::uint32_t const mean = s.count ? std::uint32_t(s.total / s.count) : 0;
+
+        pThis->printf(
+            "%-10s %9u %9u %9u %9u ",
+            cPerf::getProbeName(probe),
+            unsigned(s.count),
+            unsigned(s.min / cyclesPerUs),
+            unsigned(mean / cyclesPerUs),
+            unsigned(s.max / cyclesPerUs)
+            );
+        for (auto const n : s.histogram)
+            pThis->printf(" %u", unsigned(n));
+        pThis->printf("\n");
+        }
+
+    if (fReset)
+        cPerf::reset();
+#else
+    pThis->printf("perf: probes not compiled in (CATENA4610_PERF is 0)\n");
+#endif
+
+    auto const &supply = gMeasurementLoop.getSupplySampler();
+    pThis->printf(
+        "supply: %u ADC reads, period %u ms\n",
+        unsigned(supply.getReadCount()),
+        unsigned(supply.getPeriod())
+        );
+
+    return cCommandStream::CommandStatus::kSuccess;
+    }
@@ -0,0 +1,89 @@
+/*
+
+Module:	cmdSleep.cpp
+
+Function:
+    Process the "sleep" command
+
+Copyright and License:
+    This file copyright (C) 2026 by
+
+        MCCI Corporation
+        3520 Krums Corners Road
+        Ithaca, NY  14850
+
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation	October 2026
+
+*/
+
+#include "Catena4610_cmd.h"
+
+#include "Catena4610_FED3.h"
+
+using namespace McciCatena;
+using namespace McciCatena4610;
+
+/*
+
+Name:   ::cmdSleep()
+
+Function:
+    Command dispatcher for "sleep" command.
+
+Definition:
+    McciCatena::cCommandStream::CommandFn cmdSleep;
+
+    McciCatena::cCommandStream::CommandStatus cmdSleep(
+        cCommandStream *pThis,
+        void *pContext,
+        int argc,
+        char **argv
+        );
+
+Description:
+    The "sleep" command has the following syntax:
+
+    sleep
+        Display the number of deep sleeps, how many were cut short by
+        the FED3, and the total time spent in deep sleep.
+
+Returns:
+    cCommandStream::CommandStatus::kSuccess if successful.
+    Some other value for failure.
+
+*/
+
+// argv[0] is "sleep"
+cCommandStream::CommandStatus cmdSleep(
+    cCommandStream *pThis,
+    void *pContext,
+    int argc,
+    char **argv
+    )
+    {
+    if (argc > 1)
+        return cCommandStream::CommandStatus::kInvalidParameter;
+
+    std::uint32_t const msAsleep = gMeasurementLoop.getDeepSleepMs();
+    std::uint32_t const msUp = millis();
+
+    pThis->printf(
+        "deep sleep: %s\n",
+        gMeasurementLoop.isSerialWakeupEnabled() ? "enabled" : "disabled (FED3 can't wake us)"
+        );
+    pThis->printf(
+        "%u deep sleeps, %u woken by FED3\n",
+        unsigned(gMeasurementLoop.getDeepSleepCount()),
+        unsigned(gMeasurementLoop.getSerialWakeCount())
+        );
+    pThis->printf(
+        "asleep %u.%03u of %u.%03u secs\n",
+        unsigned(msAsleep / 1000), unsigned(msAsleep % 1000),
+        unsigned(msUp / 1000), unsigned(msUp % 1000)
+        );
+
+    return cCommandStream::CommandStatus::kSuccess;
+    }
@@ -0,0 +1,305 @@
+/*
+
+Module: catena-message-gen-decoders.cpp
+
+Function:
+    Generate the schema part of the JavaScript decoders.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    This is a host program, not part of the sketch. It writes the field
+    tables from Catena4610_MessageSchema.h, and the functions that walk
+    them, into each decoder named on the command line, replacing
+    everything between the "begin generated" and "end generated" lines.
+    A decoder gets only the tables for the formats its port carries
+    (see kPorts[]); the port comes from its name, "...-port<n>-...".
+    With no decoders named, the port 3 section is written to stdout.
+    Run it after changing the schema:
+
+        g++ -std=c++14 -I.. -o gen catena-message-gen-decoders.cpp
+        ./gen catena-message-port*-format-24-decoder-*.js
+
+    Then run "make -C test check" from the sketch directory. Among
+    other things, test/test_Uplinks.cpp runs the loop on the host and
+    check_Uplinks.js decodes its uplinks with every decoder here, under
+    node, and compares them with what was encoded.
+
+*/
+
+#include "Catena4610_MessageSchema.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace McciCatena4610;
+using MessageSchema::Type;
+
+static const char kBegin[] = "// begin generated from Catena4610_MessageSchema.h";
+static const char kEnd[] = "// end generated from Catena4610_MessageSchema.h";
+
+static const char *typeName(Type t)
+    {
+    switch (t)
+        {
+    case Type::Uint8:   return "uint8";
+    case Type::Int16:   return "int16";
+    case Type::Uint16:  return "uint16";
+    case Type::Uint32:  return "uint32";
+    case Type::Uflt16:  return "uflt16";
+    case Type::Fed3:    return "fed3";
+    default:            return "unknown";
+        }
+    }
+
+// the functions that use the tables; the same in every decoder.
+static const char kFunctions[] = R"(
+// decode one value of the given type.
+function DecodeRaw(Parse, type) {
+    if (type === "uint8")
+        return Parse.bytes[Parse.i++];
+    else if (type === "int16")
+        return DecodeI16(Parse);
+    else if (type === "uint16")
+        return DecodeU16(Parse);
+    else if (type === "uint32")
+        return DecodeU32(Parse);
+    else if (type === "uflt16")
+        return DecodeUflt16(Parse);
+    else
+        return null;
+}
+
+// set decoded[name], where "a.b" means decoded.a.b.
+function SetDecodedField(decoded, name, value) {
+    var path = name.split(".");
+    var o = decoded;
+
+    for (var i = 0; i < path.length - 1; ++i) {
+        if (! (path[i] in o))
+            o[path[i]] = {};
+        o = o[path[i]];
+    }
+    o[path[path.length - 1]] = value;
+}
+
+// decode the fields selected by flags, up to the FED3 data.
+function DecodeMessageFields(Parse, flags, decoded) {
+    for (var iField = 0; iField < MessageFields.length; ++iField) {
+        var field = MessageFields[iField];
+
+        if (field.type === "fed3")
+            break;
+        if (flags & field.flag)
+            SetDecodedField(decoded, field.name, DecodeRaw(Parse, field.type) / field.scale);
+    }
+}
+
+// decode a record laid out as fields into raw field values.
+function DecodeRecordRaw(Parse, fields) {
+    var raw = {};
+
+    for (var iField = 0; iField < fields.length; ++iField) {
+        var field = fields[iField];
+
+        raw[field.name] = DecodeRaw(Parse, field.type);
+    }
+
+    return raw;
+}
+
+// decode a full FED3 record into raw field values.
+function DecodeFED3Raw(Parse) {
+    return DecodeRecordRaw(Parse, FED3Fields);
+}
+)";
+
+// for ports that carry summaries (format 0x26).
+static const char kSummaryFunctions[] = R"(
+// decode a FED3 summary record into raw field values.
+function DecodeFED3SummaryRaw(Parse) {
+    return DecodeRecordRaw(Parse, FED3SummaryFields);
+}
+)";
+
+// what each port's decoders need.
+struct PortTables
+    {
+    unsigned    port;
+    // format 0x26 is only sent on port 3.
+    bool        fSummary;
+    };
+
+static const PortTables kPorts[] =
+    {
+    { 2, false },
+    { 3, true },
+    };
+
+// write a table of record fields, as a JavaScript array.
+static void putRecordFields(
+    std::ostringstream &s,
+    const char *pName,
+    const MessageSchema::RecordField *pFields,
+    std::size_t nFields
+    )
+    {
+    char line[160];
+
+    s << "var " << pName << " = [\n";
+    for (std::size_t i = 0; i < nFields; ++i)
+        {
+        auto const &f = pFields[i];
+
+        std::snprintf(
+            line, sizeof(line),
+            "    { name: \"%s\", type: \"%s\", size: %u%s }%s\n",
+            f.pName,
+            typeName(f.type),
+            unsigned(MessageSchema::sizeOf(f.type)),
+            f.type == Type::Int16 ? ", signed: true" : "",
+            i + 1 < nFields ? "," : ""
+            );
+        s << line;
+        }
+    s << "];\n";
+    }
+
+static std::string generate(const PortTables &tables)
+    {
+    std::ostringstream s;
+    unsigned fed3Flag = 0;
+    char line[160];
+
+    s << kBegin << "\n";
+    s << "// by extra/catena-message-gen-decoders.cpp; don't edit by hand.\n";
+    s << "\n";
+    s << "// the fields that may follow the flags byte, in wire order. A field is\n";
+    s << "// present if (flags & flag) is non-zero; its value is raw / scale.\n";
+    s << "var MessageFields = [\n";
+    for (std::size_t i = 0; i < MessageSchema::kFieldCount; ++i)
+        {
+        auto const &f = MessageSchema::kMessageFields[i];
+        char scale[40];
+
+        if (f.type == Type::Fed3)
+            fed3Flag = f.flag;
+
+        if (f.scaleDen == 1)
+            std::snprintf(scale, sizeof(scale), "%lu", (unsigned long) f.scaleNum);
+        else
+            std::snprintf(scale, sizeof(scale), "%lu / %lu", (unsigned long) f.scaleNum, (unsigned long) f.scaleDen);
+
+        std::snprintf(
+            line, sizeof(line),
+            "    { name: \"%s\", flag: 0x%02x, type: \"%s\", scale: %s }%s\n",
+            f.pName,
+            unsigned(f.flag),
+            typeName(f.type),
+            scale,
+            i + 1 < MessageSchema::kFieldCount ? "," : ""
+            );
+        s << line;
+        }
+    s << "];\n";
+    s << "\n";
+    std::snprintf(line, sizeof(line), "var MessageFlagFED3 = 0x%02x;\n", fed3Flag);
+    s << line;
+    s << "\n";
+    s << "// FED3 record fields in wire order, with their sizes.\n";
+    putRecordFields(s, "FED3Fields", MessageSchema::kFed3Fields, MessageSchema::kFed3FieldCount);
+    if (tables.fSummary)
+        {
+        s << "\n";
+        s << "// FED3 summary record fields (format 0x26) in wire order, with their sizes.\n";
+        putRecordFields(s, "FED3SummaryFields", MessageSchema::kFed3SummaryFields, MessageSchema::kFed3SummaryFieldCount);
+        }
+    s << kFunctions;
+    if (tables.fSummary)
+        s << kSummaryFunctions;
+    s << "\n";
+    s << kEnd << "\n";
+    return s.str();
+    }
+
+// the tables for a decoder, from the port in its name.
+static const PortTables *getPortTables(const char *pFile)
+    {
+    const char *const pPort = std::strstr(pFile, "port");
+    unsigned port;
+
+    if (pPort == nullptr || std::sscanf(pPort, "port%u", &port) != 1)
+        return nullptr;
+
+    for (auto const &tables : kPorts)
+        {
+        if (tables.port == port)
+            return &tables;
+        }
+
+    return nullptr;
+    }
+
+static bool update(const char *pFile, const std::string &generated)
+    {
+    std::ifstream in(pFile, std::ios::binary);
+    std::ostringstream contents;
+
+    if (! in)
+        {
+        std::fprintf(stderr, "%s: can't read\n", pFile);
+        return false;
+        }
+    contents << in.rdbuf();
+    in.close();
+
+    std::string s = contents.str();
+    auto const iBegin = s.find(kBegin);
+    auto const iEnd = s.find(kEnd);
+
+    if (iBegin == std::string::npos || iEnd == std::string::npos || iEnd < iBegin)
+        {
+        std::fprintf(stderr, "%s: no generated section\n", pFile);
+        return false;
+        }
+
+    s.replace(iBegin, iEnd + sizeof(kEnd) - iBegin, generated);
+
+    std::ofstream out(pFile, std::ios::binary);
+    out << s;
+    return bool(out);
+    }
+
+int main(int argc, char **argv)
+    {
+    int status = 0;
+
+    if (argc < 2)
+        {
+        // port 3 has every table.
+        std::fputs(generate(kPorts[1]).c_str(), stdout);
+        return 0;
+        }
+
+    for (int i = 1; i < argc; ++i)
+        {
+        const PortTables *const pTables = getPortTables(argv[i]);
+
+        if (pTables == nullptr)
+            {
+            std::fprintf(stderr, "%s: can't tell the port from the name\n", argv[i]);
+            status = 1;
+            }
+        else if (! update(argv[i], generate(*pTables)))
+            status = 1;
+        }
+
+    return status;
+    }
@@ -177,10 +177,6 @@ function DecodeSflt16(Parse)
     }
 
 
-function DecodeLight(Parse) {
-    return DecodeUflt16(Parse);
-}
-
 function DecodeFED3Data(Parse) {
     
 	return DecodeSflt16(Parse);
@@ -217,7 +213,7 @@ function DecodeU32(Parse) {
     var i = Parse.i;
     var bytes = Parse.bytes;
 
-    var result = (bytes[i + 0] << 24)+ (bytes[i + 1] << 16) + (bytes[i + 2] << 8) + bytes[i + 3];
+    var result = ((bytes[i + 0] << 24) >>> 0) + (bytes[i + 1] << 16) + (bytes[i + 2] << 8) + bytes[i + 3];
     Parse.i = i + 4;
 
     return result;
@@ -233,8 +229,174 @@ function RemainingBytes(Parse) {
         return 0;
 }
 
-function DecodeV(Parse) {
-    return DecodeI16(Parse) / 4096.0;
+// begin generated from Catena4610_MessageSchema.h
+// by extra/catena-message-gen-decoders.cpp; don't edit by hand.
+
+// the fields that may follow the flags byte, in wire order. A field is
+// present if (flags & flag) is non-zero; its value is raw / scale.
+var MessageFields = [
+    { name: "Vbat", flag: 0x01, type: "int16", scale: 4096 },
+    { name: "Vsys", flag: 0x02, type: "int16", scale: 4096 },
+    { name: "Vbus", flag: 0x04, type: "int16", scale: 4096 },
+    { name: "boot", flag: 0x08, type: "uint8", scale: 1 },
+    { name: "tempC", flag: 0x10, type: "int16", scale: 256 },
+    { name: "p", flag: 0x10, type: "uint16", scale: 25 },
+    { name: "rh", flag: 0x10, type: "uint16", scale: 65535 / 100 },
+    { name: "irradiance.White", flag: 0x20, type: "uflt16", scale: 1 / 16777216 },
+    { name: "fed3", flag: 0x40, type: "fed3", scale: 1 }
+];
+
+var MessageFlagFED3 = 0x40;
+
+// FED3 record fields in wire order, with their sizes.
+var FED3Fields = [
+    { name: "time", type: "uint32", size: 4 },
+    { name: "vMajor", type: "uint8", size: 1 },
+    { name: "vMinor", type: "uint8", size: 1 },
+    { name: "vPatch", type: "uint8", size: 1 },
+    { name: "deviceNumber", type: "uint16", size: 2 },
+    { name: "sessionType", type: "uint8", size: 1 },
+    { name: "vbat", type: "int16", size: 2, signed: true },
+    { name: "numMotorTurns", type: "uint32", size: 4 },
+    { name: "fixedRatio", type: "int16", size: 2, signed: true },
+    { name: "eventActive", type: "uint8", size: 1 },
+    { name: "eventTime", type: "uint16", size: 2 },
+    { name: "leftCount", type: "uint32", size: 4 },
+    { name: "rightCount", type: "uint32", size: 4 },
+    { name: "pelletCount", type: "uint32", size: 4 },
+    { name: "blockPelletCount", type: "int16", size: 2, signed: true }
+];
+
+// decode one value of the given type.
+function DecodeRaw(Parse, type) {
+    if (type === "uint8")
+        return Parse.bytes[Parse.i++];
+    else if (type === "int16")
+        return DecodeI16(Parse);
+    else if (type === "uint16")
+        return DecodeU16(Parse);
+    else if (type === "uint32")
+        return DecodeU32(Parse);
+    else if (type === "uflt16")
+        return DecodeUflt16(Parse);
+    else
+        return null;
+}
+
+// set decoded[name], where "a.b" means decoded.a.b.
+function SetDecodedField(decoded, name, value) {
+    var path = name.split(".");
+    var o = decoded;
+
+    for (var i = 0; i < path.length - 1; ++i) {
+        if (! (path[i] in o))
+            o[path[i]] = {};
+        o = o[path[i]];
+    }
+    o[path[path.length - 1]] = value;
+}
+
+// decode the fields selected by flags, up to the FED3 data.
+function DecodeMessageFields(Parse, flags, decoded) {
+    for (var iField = 0; iField < MessageFields.length; ++iField) {
+        var field = MessageFields[iField];
+
+        if (field.type === "fed3")
+            break;
+        if (flags & field.flag)
+            SetDecodedField(decoded, field.name, DecodeRaw(Parse, field.type) / field.scale);
+    }
+}
+
+// decode a record laid out as fields into raw field values.
+function DecodeRecordRaw(Parse, fields) {
+    var raw = {};
+
+    for (var iField = 0; iField < fields.length; ++iField) {
+        var field = fields[iField];
+
+        raw[field.name] = DecodeRaw(Parse, field.type);
+    }
+
+    return raw;
+}
+
+// decode a full FED3 record into raw field values.
+function DecodeFED3Raw(Parse) {
+    return DecodeRecordRaw(Parse, FED3Fields);
+}
+
+// end generated from Catena4610_MessageSchema.h
+
+var FED3SessionTypes = [
+    "Custom_Application",
+    "ClassicFED3",
+    "ClosedEconomy_PR1",
+    "Dispenser",
+    "Extinction",
+    "FixedRatio1",
+    "FR_Customizable",
+    "FreeFeeding",
+    "MenuExample",
+    "Optogenetic_Self_Stim",
+    "Pavlovian",
+    "ProbReversalTask",
+    "ProgressiveRatio",
+    "RandomRatio"
+];
+
+var FED3EventNames = [
+    "Unknown",
+    "Left",
+    "LeftShort",
+    "LeftWithPellet",
+    "LeftinTimeout",
+    "LeftDuringDispense",
+    "Right",
+    "RightShort",
+    "RightWithPellet",
+    "RightinTimeout",
+    "RightDuringDispense",
+    "Pellet"
+];
+
+var FED3EventPellet = 11;
+
+// convert raw FED3 field values to the decoded form.
+function FED3RawToDecoded(raw, decoded) {
+    // fetch time; convert to database time (which is UTC-like ignoring leap seconds)
+    var fed3Time = new Date(raw.time);
+    decoded.fed3Time = fed3Time.getTime();
+
+    decoded.fed3Version = raw.vMajor + "." + raw.vMinor + "." + raw.vPatch;
+    decoded.fed3DeviceNumber = raw.deviceNumber;
+
+    if (raw.sessionType < FED3SessionTypes.length)
+        decoded.fed3SessionType = FED3SessionTypes[raw.sessionType];
+    else
+        decoded.fed3SessionType = FED3SessionTypes[0];
+
+    decoded.fed3Vbat = raw.vbat / 4096.0;
+    decoded.fed3NumMotorTurns = raw.numMotorTurns;
+    decoded.fed3FixedRatio = raw.fixedRatio;
+
+    if (raw.eventActive < FED3EventNames.length)
+        decoded.fed3EventActive = FED3EventNames[raw.eventActive];
+    else
+        decoded.fed3EventActive = FED3EventNames[0];
+
+    if (raw.eventActive === FED3EventPellet) {
+        decoded.fed3RetrievalTime = raw.eventTime * 4.0 / 1000.0;
+    }
+    else {
+        decoded.fed3PokeTime = raw.eventTime * 4.0 / 1000.0;
+    }
+
+    decoded.fed3LeftCount = raw.leftCount;
+    decoded.fed3RightCount = raw.rightCount;
+    decoded.fed3PelletCount = raw.pelletCount;
+    decoded.fed3BlockPelletCount = raw.blockPelletCount;
+    return decoded;
 }
 
 function Decoder(bytes, port) {
@@ -258,69 +420,18 @@ function Decoder(bytes, port) {
     // fetch the bitmap.
     var flags = bytes[Parse.i++];
 
-    if (flags & 0x1) {
-        decoded.Vbat = DecodeV(Parse);
-    }
-
-    if (flags & 0x2) {
-        decoded.Vsys = DecodeV(Parse);
-    }
-
-    if (flags & 0x4) {
-        decoded.Vbus = DecodeV(Parse);
-    }
+    DecodeMessageFields(Parse, flags, decoded);
 
-    if (flags & 0x8) {
-        var iBoot = bytes[Parse.i++];
-        decoded.boot = iBoot;
-    }
-
-    if (flags & 0x10) {
-        // we have temp, pressure, RH
-        decoded.tempC = DecodeI16(Parse) / 256;
-        decoded.p = DecodeU16(Parse) * 4 / 100.0;
-        decoded.rh = DecodeU16(Parse) * 100 / 65535.0;
+    if ("tempC" in decoded && "rh" in decoded) {
         decoded.tDewC = dewpoint(decoded.tempC, decoded.rh);
         var tHeat = CalculateHeatIndex(decoded.tempC * 1.8 + 32, decoded.rh);
         if (tHeat !== null)
             decoded.tHeatIndexC = tHeat;
     }
 
-    if (flags & 0x20) {
-        // we have light
-        decoded.irradiance = {};
-        decoded.irradiance.White = DecodeLight(Parse) * Math.pow(2.0, 24);
+    if (flags & MessageFlagFED3) {
+        FED3RawToDecoded(DecodeFED3Raw(Parse), decoded);
     }
-
-    if (flags & 0x40) {
-        decoded.fed3Vbat = DecodeV(Parse);
-		decoded.fed3NumMotorTurns = DecodeU32(Parse);
-		decoded.fed3FixedRatio = DecodeI16(Parse);
-
-        var nIndex = (Parse.i) + 1;
-        fed3EventActive = 0x03 & bytes[nIndex];
-
-		if (fed3EventActive == 1) {
-			decoded.fed3EventActive = "Left";
-            decoded.fed3PokeTime = (DecodeU16(Parse) >> 2 & 0x3FFF) * 4.0 / 1000.00;
-        }
-		else if (fed3EventActive == 2) {
-			decoded.fed3EventActive = "Right";
-            decoded.fed3PokeTime = (DecodeU16(Parse) >> 2 & 0x3FFF) * 4.0 / 1000.00;
-        }
-		else if (fed3EventActive == 3) {
-			decoded.fed3EventActive = "Pellet";
-            decoded.fed3RetrievalTime = (DecodeU16(Parse) >> 2 & 0x3FFF) * 4.0 / 1000.00;
-        }
-		else {
-			decoded.fed3EventActive = "Unknown";
-        }
-
-		decoded.fed3LeftCount = DecodeU32(Parse);
-		decoded.fed3RightCount = DecodeU32(Parse);
-		decoded.fed3PelletCount = DecodeU32(Parse);
-		decoded.fed3BlockPelletCount = DecodeU16(Parse);	
-		}
     return decoded;
 	}
 
@@ -3,7 +3,7 @@
 Name:   catena-message-port3-format-24-decoder-ttn.js
 
 Function:
-    Decode port 0x03 format 0x24 messages for TTN console.
+    Decode port 0x03 format 0x24, 0x25 and 0x26 messages for TTN console.
 
 Author:
     Dhinesh Kumar Pitchai, MCCI Corporation   June 2021
@@ -177,10 +177,6 @@ function DecodeSflt16(Parse)
     }
 
 
-function DecodeLight(Parse) {
-    return DecodeUflt16(Parse);
-}
-
 function DecodeFED3Data(Parse) {
     
 	return DecodeSflt16(Parse);
@@ -217,7 +213,7 @@ function DecodeU32(Parse) {
     var i = Parse.i;
     var bytes = Parse.bytes;
 
-    var result = (bytes[i + 0] << 24)+ (bytes[i + 1] << 16) + (bytes[i + 2] << 8) + bytes[i + 3];
+    var result = ((bytes[i + 0] << 24) >>> 0) + (bytes[i + 1] << 16) + (bytes[i + 2] << 8) + bytes[i + 3];
     Parse.i = i + 4;
 
     return result;
@@ -233,8 +229,331 @@ function RemainingBytes(Parse) {
         return 0;
 }
 
-function DecodeV(Parse) {
-    return DecodeI16(Parse) / 4096.0;
+// begin generated from Catena4610_MessageSchema.h
+// by extra/catena-message-gen-decoders.cpp; don't edit by hand.
+
+// the fields that may follow the flags byte, in wire order. A field is
+// present if (flags & flag) is non-zero; its value is raw / scale.
+var MessageFields = [
+    { name: "Vbat", flag: 0x01, type: "int16", scale: 4096 },
+    { name: "Vsys", flag: 0x02, type: "int16", scale: 4096 },
+    { name: "Vbus", flag: 0x04, type: "int16", scale: 4096 },
+    { name: "boot", flag: 0x08, type: "uint8", scale: 1 },
+    { name: "tempC", flag: 0x10, type: "int16", scale: 256 },
+    { name: "p", flag: 0x10, type: "uint16", scale: 25 },
+    { name: "rh", flag: 0x10, type: "uint16", scale: 65535 / 100 },
+    { name: "irradiance.White", flag: 0x20, type: "uflt16", scale: 1 / 16777216 },
+    { name: "fed3", flag: 0x40, type: "fed3", scale: 1 }
+];
+
+var MessageFlagFED3 = 0x40;
+
+// FED3 record fields in wire order, with their sizes.
+var FED3Fields = [
+    { name: "time", type: "uint32", size: 4 },
+    { name: "vMajor", type: "uint8", size: 1 },
+    { name: "vMinor", type: "uint8", size: 1 },
+    { name: "vPatch", type: "uint8", size: 1 },
+    { name: "deviceNumber", type: "uint16", size: 2 },
+    { name: "sessionType", type: "uint8", size: 1 },
+    { name: "vbat", type: "int16", size: 2, signed: true },
+    { name: "numMotorTurns", type: "uint32", size: 4 },
+    { name: "fixedRatio", type: "int16", size: 2, signed: true },
+    { name: "eventActive", type: "uint8", size: 1 },
+    { name: "eventTime", type: "uint16", size: 2 },
+    { name: "leftCount", type: "uint32", size: 4 },
+    { name: "rightCount", type: "uint32", size: 4 },
+    { name: "pelletCount", type: "uint32", size: 4 },
+    { name: "blockPelletCount", type: "int16", size: 2, signed: true }
+];
+
+// FED3 summary record fields (format 0x26) in wire order, with their sizes.
+var FED3SummaryFields = [
+    { name: "time", type: "uint32", size: 4 },
+    { name: "deviceNumber", type: "uint16", size: 2 },
+    { name: "sessionType", type: "uint8", size: 1 },
+    { name: "sessionChanges", type: "uint8", size: 1 },
+    { name: "windowSec", type: "uint32", size: 4 },
+    { name: "events", type: "uint16", size: 2 },
+    { name: "leftPokes", type: "uint16", size: 2 },
+    { name: "rightPokes", type: "uint16", size: 2 },
+    { name: "pellets", type: "uint16", size: 2 },
+    { name: "pokeTimeMean", type: "uint16", size: 2 },
+    { name: "pokeTimeMax", type: "uint16", size: 2 },
+    { name: "retrievalTimeMean", type: "uint16", size: 2 },
+    { name: "retrievalTimeMax", type: "uint16", size: 2 },
+    { name: "vbatMin", type: "int16", size: 2, signed: true }
+];
+
+// decode one value of the given type.
+function DecodeRaw(Parse, type) {
+    if (type === "uint8")
+        return Parse.bytes[Parse.i++];
+    else if (type === "int16")
+        return DecodeI16(Parse);
+    else if (type === "uint16")
+        return DecodeU16(Parse);
+    else if (type === "uint32")
+        return DecodeU32(Parse);
+    else if (type === "uflt16")
+        return DecodeUflt16(Parse);
+    else
+        return null;
+}
+
+// set decoded[name], where "a.b" means decoded.a.b.
+function SetDecodedField(decoded, name, value) {
+    var path = name.split(".");
+    var o = decoded;
+
+    for (var i = 0; i < path.length - 1; ++i) {
+        if (! (path[i] in o))
+            o[path[i]] = {};
+        o = o[path[i]];
+    }
+    o[path[path.length - 1]] = value;
+}
+
+// decode the fields selected by flags, up to the FED3 data.
+function DecodeMessageFields(Parse, flags, decoded) {
+    for (var iField = 0; iField < MessageFields.length; ++iField) {
+        var field = MessageFields[iField];
+
+        if (field.type === "fed3")
+            break;
+        if (flags & field.flag)
+            SetDecodedField(decoded, field.name, DecodeRaw(Parse, field.type) / field.scale);
+    }
+}
+
+// decode a record laid out as fields into raw field values.
+function DecodeRecordRaw(Parse, fields) {
+    var raw = {};
+
+    for (var iField = 0; iField < fields.length; ++iField) {
+        var field = fields[iField];
+
+        raw[field.name] = DecodeRaw(Parse, field.type);
+    }
+
+    return raw;
+}
+
+// decode a full FED3 record into raw field values.
+function DecodeFED3Raw(Parse) {
+    return DecodeRecordRaw(Parse, FED3Fields);
+}
+
+// decode a FED3 summary record into raw field values.
+function DecodeFED3SummaryRaw(Parse) {
+    return DecodeRecordRaw(Parse, FED3SummaryFields);
+}
+
+// end generated from Catena4610_MessageSchema.h
+
+var FED3SessionTypes = [
+    "Custom_Application",
+    "ClassicFED3",
+    "ClosedEconomy_PR1",
+    "Dispenser",
+    "Extinction",
+    "FixedRatio1",
+    "FR_Customizable",
+    "FreeFeeding",
+    "MenuExample",
+    "Optogenetic_Self_Stim",
+    "Pavlovian",
+    "ProbReversalTask",
+    "ProgressiveRatio",
+    "RandomRatio"
+];
+
+var FED3EventNames = [
+    "Unknown",
+    "Left",
+    "LeftShort",
+    "LeftWithPellet",
+    "LeftinTimeout",
+    "LeftDuringDispense",
+    "Right",
+    "RightShort",
+    "RightWithPellet",
+    "RightinTimeout",
+    "RightDuringDispense",
+    "Pellet"
+];
+
+var FED3EventPellet = 11;
+
+// decode a delta FED3 record, relative to prev.
+function DecodeFED3DeltaRaw(Parse, prev) {
+    var bytes = Parse.bytes;
+    var raw = {};
+    var d;
+
+    raw.time = (prev.time + DecodeU16(Parse)) >>> 0;
+    raw.vMajor = prev.vMajor;
+    raw.vMinor = prev.vMinor;
+    raw.vPatch = prev.vPatch;
+    raw.deviceNumber = prev.deviceNumber;
+    raw.sessionType = prev.sessionType;
+    raw.fixedRatio = prev.fixedRatio;
+    raw.eventActive = bytes[Parse.i++];
+    raw.eventTime = DecodeU16(Parse);
+    raw.leftCount = (prev.leftCount + bytes[Parse.i++]) >>> 0;
+    raw.rightCount = (prev.rightCount + bytes[Parse.i++]) >>> 0;
+    raw.pelletCount = (prev.pelletCount + bytes[Parse.i++]) >>> 0;
+    raw.numMotorTurns = (prev.numMotorTurns + bytes[Parse.i++]) >>> 0;
+    d = bytes[Parse.i++];
+    raw.vbat = prev.vbat + ((d & 0x80) ? d - 0x100 : d);
+    d = bytes[Parse.i++];
+    d = (prev.blockPelletCount + ((d & 0x80) ? d - 0x100 : d)) & 0xFFFF;
+    raw.blockPelletCount = (d & 0x8000) ? d - 0x10000 : d;
+    return raw;
+}
+
+// convert raw FED3 field values to the decoded form.
+function FED3RawToDecoded(raw, decoded) {
+    // fetch time; convert to database time (which is UTC-like ignoring leap seconds)
+    var fed3Time = new Date(raw.time);
+    decoded.fed3Time = fed3Time.getTime();
+
+    decoded.fed3Version = raw.vMajor + "." + raw.vMinor + "." + raw.vPatch;
+    decoded.fed3DeviceNumber = raw.deviceNumber;
+
+    if (raw.sessionType < FED3SessionTypes.length)
+        decoded.fed3SessionType = FED3SessionTypes[raw.sessionType];
+    else
+        decoded.fed3SessionType = FED3SessionTypes[0];
+
+    decoded.fed3Vbat = raw.vbat / 4096.0;
+    decoded.fed3NumMotorTurns = raw.numMotorTurns;
+    decoded.fed3FixedRatio = raw.fixedRatio;
+
+    if (raw.eventActive < FED3EventNames.length)
+        decoded.fed3EventActive = FED3EventNames[raw.eventActive];
+    else
+        decoded.fed3EventActive = FED3EventNames[0];
+
+    if (raw.eventActive === FED3EventPellet) {
+        decoded.fed3RetrievalTime = raw.eventTime * 4.0 / 1000.0;
+    }
+    else {
+        decoded.fed3PokeTime = raw.eventTime * 4.0 / 1000.0;
+    }
+
+    decoded.fed3LeftCount = raw.leftCount;
+    decoded.fed3RightCount = raw.rightCount;
+    decoded.fed3PelletCount = raw.pelletCount;
+    decoded.fed3BlockPelletCount = raw.blockPelletCount;
+    return decoded;
+}
+
+function DecodeVarint(Parse) {
+    var bytes = Parse.bytes;
+    var result = 0;
+    var scale = 1;
+    var b;
+
+    do {
+        b = bytes[Parse.i++];
+        result += (b & 0x7F) * scale;
+        scale *= 128;
+    } while (b & 0x80);
+
+    return result;
+}
+
+// decode a zig-zag varint delta FED3 record, relative to prev.
+function DecodeFED3VarintRaw(Parse, prev) {
+    var map = DecodeVarint(Parse);
+    var raw = {};
+
+    for (var iField = 0; iField < FED3Fields.length; ++iField) {
+        var field = FED3Fields[iField];
+        var v = prev[field.name];
+
+        if (map & (1 << iField)) {
+            var zz = DecodeVarint(Parse);
+            var d = (zz % 2) ? -(zz + 1) / 2 : zz / 2;
+            var modulus = Math.pow(2, 8 * field.size);
+
+            // add modulo the field size, then restore the sign.
+            v = ((v + d) % modulus + modulus) % modulus;
+            if (field.signed && v >= modulus / 2)
+                v -= modulus;
+        }
+        raw[field.name] = v;
+    }
+
+    return raw;
+}
+
+// decode the FED3 records of a format 0x25 message.
+function DecodeFED3Batch(Parse) {
+    var bytes = Parse.bytes;
+    var nRecords = bytes[Parse.i++];
+    var records = [];
+    var prev = null;
+
+    for (var iRecord = 0; iRecord < nRecords; ++iRecord) {
+        var tag = bytes[Parse.i++];
+        var raw;
+
+        if (tag === 0) {
+            raw = DecodeFED3Raw(Parse);
+        }
+        else if (tag === 1 && prev !== null) {
+            raw = DecodeFED3DeltaRaw(Parse, prev);
+        }
+        else if (tag === 2 && prev !== null) {
+            raw = DecodeFED3VarintRaw(Parse, prev);
+        }
+        else {
+            // can't continue past a record we don't understand.
+            break;
+        }
+
+        records.push(FED3RawToDecoded(raw, {}));
+        prev = raw;
+    }
+
+    return records;
+}
+
+// decode the FED3 summary records of a format 0x26 message.
+function DecodeFED3Summaries(Parse) {
+    var bytes = Parse.bytes;
+    var nRecords = bytes[Parse.i++];
+    var summaries = [];
+
+    for (var iRecord = 0; iRecord < nRecords; ++iRecord) {
+        var raw = DecodeFED3SummaryRaw(Parse);
+        var summary = {};
+
+        summary.fed3Time = new Date(raw.time).getTime();
+        summary.fed3DeviceNumber = raw.deviceNumber;
+
+        if (raw.sessionType < FED3SessionTypes.length)
+            summary.fed3SessionType = FED3SessionTypes[raw.sessionType];
+        else
+            summary.fed3SessionType = FED3SessionTypes[0];
+
+        summary.sessionChanges = raw.sessionChanges;
+        summary.windowSec = raw.windowSec;
+        summary.events = raw.events;
+        summary.leftPokes = raw.leftPokes;
+        summary.rightPokes = raw.rightPokes;
+        summary.pellets = raw.pellets;
+        summary.pokeTimeMean = raw.pokeTimeMean * 4.0 / 1000.0;
+        summary.pokeTimeMax = raw.pokeTimeMax * 4.0 / 1000.0;
+        summary.retrievalTimeMean = raw.retrievalTimeMean * 4.0 / 1000.0;
+        summary.retrievalTimeMax = raw.retrievalTimeMax * 4.0 / 1000.0;
+        summary.fed3VbatMin = raw.vbatMin / 4096.0;
+        summaries.push(summary);
+    }
+
+    return summaries;
 }
 
 function Decoder(bytes, port) {
@@ -246,7 +565,7 @@ function Decoder(bytes, port) {
         return null;
 
     var uFormat = bytes[0];
-    if (! (uFormat === 0x24))
+    if (! (uFormat === 0x24 || uFormat === 0x25 || uFormat === 0x26))
         return null;
 
     // an object to help us parse.
@@ -258,152 +577,28 @@ function Decoder(bytes, port) {
     // fetch the bitmap.
     var flags = bytes[Parse.i++];
 
-    if (flags & 0x1) {
-        decoded.Vbat = DecodeV(Parse);
-    }
-
-    if (flags & 0x2) {
-        decoded.Vsys = DecodeV(Parse);
-    }
+    DecodeMessageFields(Parse, flags, decoded);
 
-    if (flags & 0x4) {
-        decoded.Vbus = DecodeV(Parse);
-    }
-
-    if (flags & 0x8) {
-        var iBoot = bytes[Parse.i++];
-        decoded.boot = iBoot;
-    }
-
-    if (flags & 0x10) {
-        // we have temp, pressure, RH
-        decoded.tempC = DecodeI16(Parse) / 256;
-        decoded.p = DecodeU16(Parse) * 4 / 100.0;
-        decoded.rh = DecodeU16(Parse) * 100 / 65535.0;
+    if ("tempC" in decoded && "rh" in decoded) {
         decoded.tDewC = dewpoint(decoded.tempC, decoded.rh);
         var tHeat = CalculateHeatIndex(decoded.tempC * 1.8 + 32, decoded.rh);
         if (tHeat !== null)
             decoded.tHeatIndexC = tHeat;
     }
 
-    if (flags & 0x20) {
-        // we have light
-        decoded.irradiance = {};
-        decoded.irradiance.White = DecodeLight(Parse) * Math.pow(2.0, 24);
-    }
-
-    if (flags & 0x40) {
-        // fetch time; convert to database time (which is UTC-like ignoring leap seconds)
-        var fed3Time = new Date(DecodeU32(Parse));
-        decoded.fed3Time = fed3Time.getTime();
-
-        var vMajor = bytes[Parse.i++];
-        var vMinor = bytes[Parse.i++];
-        var vPatch = bytes[Parse.i++];
-        decoded.fed3Version = vMajor + "." + vMinor + "." + vPatch;
-
-        decoded.fed3DeviceNumber = DecodeU16(Parse);
-
-        var sessionType = bytes[Parse.i++];
-
-        if (sessionType === 1) {
-            decoded.fed3SessionType = "ClassicFED3";
-        }
-        else if (sessionType === 2) {
-            decoded.fed3SessionType = "ClosedEconomy_PR1";
-        }
-        else if (sessionType === 3) {
-            decoded.fed3SessionType = "Dispenser";
-        }
-        else if (sessionType === 4) {
-            decoded.fed3SessionType = "Extinction";
-        }
-        else if (sessionType === 5) {
-            decoded.fed3SessionType = "FixedRatio1";
-        }
-        else if (sessionType === 6) {
-            decoded.fed3SessionType = "FR_Customizable";
-        }
-        else if (sessionType === 7) {
-            decoded.fed3SessionType = "FreeFeeding";
-        }
-        else if (sessionType === 8) {
-            decoded.fed3SessionType = "MenuExample";
-        }
-        else if (sessionType === 9) {
-            decoded.fed3SessionType = "Optogenetic_Self_Stim";
-        }
-        else if (sessionType === 10) {
-            decoded.fed3SessionType = "Pavlovian";
-        }
-        else if (sessionType === 11) {
-            decoded.fed3SessionType = "ProbReversalTask";
-        }
-        else if (sessionType === 12) {
-            decoded.fed3SessionType = "ProgressiveRatio";
-        }
-        else if (sessionType === 13) {
-            decoded.fed3SessionType = "RandomRatio";
-        }
-        else {
-            decoded.fed3SessionType = "Custom_Application";
-        }
-
-        decoded.fed3Vbat = DecodeV(Parse);
-        decoded.fed3NumMotorTurns = DecodeU32(Parse);
-        decoded.fed3FixedRatio = DecodeI16(Parse);
-
-        var fed3EventActive = bytes[Parse.i++];
-        if (fed3EventActive === 1) {
-            decoded.fed3EventActive = "Left";
-        }
-        else if (fed3EventActive === 2) {
-            decoded.fed3EventActive = "LeftShort";
-        }
-        else if (fed3EventActive === 3) {
-            decoded.fed3EventActive = "LeftWithPellet";
+    if (flags & MessageFlagFED3) {
+        if (uFormat === 0x25) {
+            // a batch of FED3 events
+            decoded.fed3 = DecodeFED3Batch(Parse);
         }
-        else if (fed3EventActive === 4) {
-            decoded.fed3EventActive = "LeftinTimeout";
-        }
-        else if (fed3EventActive === 5) {
-            decoded.fed3EventActive = "LeftDuringDispense";
-        }
-        else if (fed3EventActive === 6) {
-            decoded.fed3EventActive = "Right";
-        }
-        else if (fed3EventActive === 7) {
-            decoded.fed3EventActive = "RightShort";
-        }
-        else if (fed3EventActive === 8) {
-            decoded.fed3EventActive = "RightWithPellet";
-        }
-        else if (fed3EventActive === 9) {
-            decoded.fed3EventActive = "RightinTimeout";
-        }
-        else if (fed3EventActive === 10) {
-            decoded.fed3EventActive = "RightDuringDispense";
-        }
-        else if (fed3EventActive === 11) {
-            decoded.fed3EventActive = "Pellet";
+        else if (uFormat === 0x26) {
+            // each FED3's totals for the window
+            decoded.fed3Summary = DecodeFED3Summaries(Parse);
         }
         else {
-            decoded.fed3EventActive = "Unknown";
-        }
-
-        var fed3EventTime = DecodeU16(Parse);
-        if (fed3EventActive === 11) {
-            decoded.fed3RetrievalTime = fed3EventTime * 4.0 / 1000.0;
-        }
-        else {
-            decoded.fed3PokeTime = fed3EventTime * 4.0 / 1000.0;
-        }
-
-        decoded.fed3LeftCount = DecodeU32(Parse);
-        decoded.fed3RightCount = DecodeU32(Parse);
-        decoded.fed3PelletCount = DecodeU32(Parse);
-        decoded.fed3BlockPelletCount = DecodeU16(Parse);
+            FED3RawToDecoded(DecodeFED3Raw(Parse), decoded);
         }
+    }
     return decoded;
 	}
 
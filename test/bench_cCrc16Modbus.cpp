@@ -0,0 +1,136 @@
+/*
+
+Module: bench_cCrc16Modbus.cpp
+
+Function:
+    Host benchmark of the three CRC-16/MODBUS methods.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cCrc16Modbus.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define BENCH_HAVE_TSC 1
+#else
+# define BENCH_HAVE_TSC 0
+#endif
+
+using namespace McciCatena4610;
+
+/*
+
+The methods are wrapped in functions that can't be inlined, so each
+gets its own code, and "make bench" can report its size with nm.
+The loop is the one cCrc16Modbus::compute() runs.
+
+*/
+
+#define CRC_LOOP(name, update)                                          \
+    extern "C" __attribute__((noinline))                                \
+    std::uint16_t name(const std::uint8_t *p, std::size_t n, std::uint16_t crc) \
+        {                                                               \
+        for (std::size_t i = 0; i < n; ++i)                             \
+            crc = cCrc16Modbus::update(crc, p[i]);                      \
+        return crc;                                                     \
+        }
+
+CRC_LOOP(crcBitwise, updateBitwise)
+CRC_LOOP(crcNibble, updateNibble)
+CRC_LOOP(crcTable, updateTable)
+
+namespace {
+
+using CrcFn = std::uint16_t (*)(const std::uint8_t *, std::size_t, std::uint16_t);
+
+struct Method
+    {
+    const char      *pName;
+    CrcFn           fn;
+    std::size_t     nTable;     // bytes of table in flash
+    };
+
+const Method kMethods[] =
+    {
+    { "bitwise",    crcBitwise,     0 },
+    { "nibble",     crcNibble,      16 * sizeof(std::uint16_t) },
+    { "table",      crcTable,       256 * sizeof(std::uint16_t) },
+    };
+
+// a FED3 frame's worth of bytes, as the receiver sees them.
+constexpr std::size_t kFrameSize = 41;
+constexpr unsigned kFrames = 200000;
+constexpr unsigned kRuns = 5;
+
+std::uint8_t gFrame[kFrameSize];
+volatile std::uint16_t gSink;
+
+std::uint64_t readCycles()
+    {
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+    }
+
+} // namespace
+
+int main()
+    {
+    for (std::size_t i = 0; i < kFrameSize; ++i)
+        gFrame[i] = std::uint8_t(i * 37 + 11);
+
+    std::printf("CRC-16/MODBUS over %u frames of %u bytes, best of %u runs\n",
+        kFrames, unsigned(kFrameSize), kRuns);
+    std::printf("%-8s %10s %12s %12s\n", "method", "ns/byte", "cycles/byte", "table bytes");
+
+    for (auto const &m : kMethods)
+        {
+        double nsBest = 0;
+        double cyclesBest = 0;
+
+        for (unsigned run = 0; run < kRuns; ++run)
+            {
+            auto const t0 = std::chrono::steady_clock::now();
+            std::uint64_t const c0 = readCycles();
+            std::uint16_t crc = 0;
+
+            for (unsigned i = 0; i < kFrames; ++i)
+                crc ^= m.fn(gFrame, kFrameSize, 0xFFFF);
+
+            std::uint64_t const c1 = readCycles();
+            auto const t1 = std::chrono::steady_clock::now();
+
+            gSink = crc;
+
+            double const nBytes = double(kFrames) * kFrameSize;
+            double const ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / nBytes;
+            double const cycles = double(c1 - c0) / nBytes;
+
+            if (run == 0 || ns < nsBest)
+                {
+                nsBest = ns;
+                cyclesBest = cycles;
+                }
+            }
+
+        if (BENCH_HAVE_TSC)
+            std::printf("%-8s %10.2f %12.2f %12u\n", m.pName, nsBest, cyclesBest, unsigned(m.nTable));
+        else
+            std::printf("%-8s %10.2f %12s %12u\n", m.pName, nsBest, "-", unsigned(m.nTable));
+        }
+
+    std::printf("(cycles are time-stamp counter ticks)\n");
+    return 0;
+    }
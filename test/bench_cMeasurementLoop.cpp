@@ -0,0 +1,226 @@
+/*
+
+Module: bench_cMeasurementLoop.cpp
+
+Function:
+    Host benchmark of the stages of handling a FED3 event, with a
+    saved baseline to compare against.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    Usage:
+
+        bench_cMeasurementLoop [-n count] [-s] [baseline]
+
+    The stages are timed by cMeasurementLoop::runBenchmark(), as the
+    "bench" command does on the board, over count events (default
+    100000). The host clock follows real time for this. The run is
+    repeated kRuns times, and the fastest time for each stage is
+    kept, which is the least disturbed by the rest of the machine.
+
+    If the baseline file can be read, each stage is compared with it,
+    and so is sizeof(cMeasurementLoop). With -s, the results are
+    saved in it instead. The file is text: a stage name, or
+    "loop-ram", and a number, on each line.
+
+    Host timings only say how the code changes, not how fast it is
+    on the board; the baseline is for comparing runs on one machine.
+
+*/
+
+#include "Catena4610_FED3.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+// as in Catena4610_FED3.ino.
+cMeasurementLoop gMeasurementLoop;
+
+namespace {
+
+constexpr std::size_t kStages = cMeasurementLoop::kBenchStages;
+constexpr unsigned kRuns = 5;
+
+// the results, in stage order, then the loop's size.
+struct Results
+    {
+    std::uint32_t   ns[kStages];
+    std::uint32_t   nLoopRam;
+    };
+
+const char *getName(std::size_t iStage)
+    {
+    return cMeasurementLoop::getBenchStageName(cMeasurementLoop::BenchStage(iStage));
+    }
+
+bool loadBaseline(const char *pName, Results &baseline)
+    {
+    std::FILE *const pFile = std::fopen(pName, "r");
+    char name[32];
+    unsigned long value;
+    unsigned nFound = 0;
+
+    if (pFile == nullptr)
+        return false;
+
+    while (std::fscanf(pFile, "%31s %lu", name, &value) == 2)
+        {
+        if (std::strcmp(name, "loop-ram") == 0)
+            {
+            baseline.nLoopRam = std::uint32_t(value);
+            ++nFound;
+            continue;
+            }
+
+        for (std::size_t i = 0; i < kStages; ++i)
+            {
+            if (std::strcmp(name, getName(i)) == 0)
+                {
+                baseline.ns[i] = std::uint32_t(value);
+                ++nFound;
+                }
+            }
+        }
+
+    std::fclose(pFile);
+
+    // a baseline from a different set of stages is no use.
+    if (nFound != kStages + 1)
+        {
+        std::fprintf(stderr, "%s: not a baseline for these stages; ignored\n", pName);
+        return false;
+        }
+    return true;
+    }
+
+bool saveBaseline(const char *pName, const Results &results)
+    {
+    std::FILE *const pFile = std::fopen(pName, "w");
+
+    if (pFile == nullptr)
+        {
+        std::perror(pName);
+        return false;
+        }
+
+    for (std::size_t i = 0; i < kStages; ++i)
+        std::fprintf(pFile, "%s %u\n", getName(i), unsigned(results.ns[i]));
+    std::fprintf(pFile, "loop-ram %u\n", unsigned(results.nLoopRam));
+
+    return std::fclose(pFile) == 0;
+    }
+
+// the change from the baseline, in percent.
+int getDelta(std::uint32_t value, std::uint32_t baseline)
+    {
+    return int((std::int64_t(value) - baseline) * 100 / std::int64_t(baseline));
+    }
+
+void printResults(const Results &results, const Results *pBaseline)
+    {
+    for (std::size_t i = 0; i < kStages; ++i)
+        {
+        if (pBaseline != nullptr && pBaseline->ns[i] != 0)
+            std::printf(
+                "%-13s %8u ns/event (baseline %8u, %+d%%)\n",
+                getName(i), unsigned(results.ns[i]),
+                unsigned(pBaseline->ns[i]), getDelta(results.ns[i], pBaseline->ns[i])
+                );
+        else
+            std::printf("%-13s %8u ns/event\n", getName(i), unsigned(results.ns[i]));
+        }
+
+    if (pBaseline != nullptr && pBaseline->nLoopRam != 0)
+        std::printf(
+            "%-13s %8u bytes    (baseline %8u, %+d%%)\n",
+            "loop-ram", unsigned(results.nLoopRam),
+            unsigned(pBaseline->nLoopRam), getDelta(results.nLoopRam, pBaseline->nLoopRam)
+            );
+    else
+        std::printf("%-13s %8u bytes\n", "loop-ram", unsigned(results.nLoopRam));
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+    {
+    std::uint32_t nIter = 100000;
+    bool fSave = false;
+    const char *pBaseline = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+        {
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            nIter = std::uint32_t(std::strtoul(argv[++i], nullptr, 0));
+        else if (std::strcmp(argv[i], "-s") == 0)
+            fSave = true;
+        else if (argv[i][0] != '-' && pBaseline == nullptr)
+            pBaseline = argv[i];
+        else
+            nIter = 0;
+        }
+
+    if (nIter == 0 || (fSave && pBaseline == nullptr))
+        {
+        std::fprintf(stderr, "usage: bench_cMeasurementLoop [-n count] [-s] [baseline]\n");
+        return 2;
+        }
+
+    // set up as setup() does; the event log isn't timed.
+    HostClock::setMicros64(1000000);
+    Serial1.begin(115200);
+    LMIC.datarate = 5;
+    gCatena.registerObject(&gLoRaWAN);
+    gMeasurementLoop.begin();
+
+    Results results;
+
+    HostClock::setRealTime(true);
+    for (unsigned iRun = 0; iRun < kRuns; ++iRun)
+        {
+        std::uint32_t ns[kStages];
+
+        if (! gMeasurementLoop.runBenchmark(nIter, ns))
+            {
+            std::fprintf(stderr, "runBenchmark() failed\n");
+            return 1;
+            }
+
+        for (std::size_t i = 0; i < kStages; ++i)
+            {
+            if (iRun == 0 || ns[i] < results.ns[i])
+                results.ns[i] = ns[i];
+            }
+        }
+    HostClock::setRealTime(false);
+    results.nLoopRam = sizeof(cMeasurementLoop);
+
+    std::printf(
+        "measurement loop, fastest of %u runs of %u events:\n",
+        kRuns, unsigned(nIter)
+        );
+
+    if (fSave)
+        {
+        printResults(results, nullptr);
+        if (! saveBaseline(pBaseline, results))
+            return 1;
+        std::printf("saved as the baseline in %s\n", pBaseline);
+        return 0;
+        }
+
+    Results baseline {};
+    bool const fBaseline = pBaseline != nullptr && loadBaseline(pBaseline, baseline);
+
+    printResults(results, fBaseline ? &baseline : nullptr);
+    return 0;
+    }
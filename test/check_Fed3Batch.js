@@ -0,0 +1,52 @@
+/*
+
+Module: check_Fed3Batch.js
+
+Function:
+    Decode the batches written by test_Fed3Batch with each port 3
+    decoder, and check they give back the events that were encoded.
+
+    node check_Fed3Batch.js {cases.json} {decoder.js}...
+
+    The first decoder must be a TTN decoder; its FED3RawToDecoded()
+    turns the expected raw values into the expected output.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+"use strict";
+
+var decoders = require("./decoders.js");
+
+var cases = decoders.readCases(process.argv[2]);
+var list = process.argv.slice(3).map(decoders.load);
+var nChecked = 0;
+var nFailed = 0;
+
+list.forEach(function (d) {
+    cases.forEach(function (c) {
+        // a format 0x25 message with nothing but the batch.
+        var bytes = [ 0x25, 0x40 ].concat(c.batch);
+        var decoded = d.decode(bytes, 3);
+        var expect = c.raw.map(function (raw) {
+            return list[0].fns.FED3RawToDecoded(raw, {});
+        });
+        var got = JSON.stringify(decoded && decoded.fed3);
+
+        ++nChecked;
+        if (got !== JSON.stringify(expect)) {
+            ++nFailed;
+            console.error(d.name + ": " + c.name + ": mismatch");
+            console.error("  expected: " + JSON.stringify(expect));
+            console.error("  got:      " + got);
+        }
+    });
+});
+
+console.log("check_Fed3Batch: " + nChecked + " checks, " + nFailed + " failed");
+process.exit(nFailed === 0 ? 0 : 1);
@@ -0,0 +1,123 @@
+/*
+
+Module: check_Uplinks.js
+
+Function:
+    Decode the uplinks written by test_Uplinks with each decoder, and
+    check they give back what the sensors and the FED3 reported.
+
+    node check_Uplinks.js {cases.json} {decoder.js}...
+
+    A decoder is used for the cases on its port (from its name); the
+    first must be a TTN decoder, whose FED3RawToDecoded() turns the
+    expected raw FED3 records into the expected output.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+"use strict";
+
+var decoders = require("./decoders.js");
+
+var cases = decoders.readCases(process.argv[2]);
+var list = process.argv.slice(3).map(decoders.load);
+var ttn = list[0].fns;
+var nChecked = 0;
+var nFailed = 0;
+
+function fail(d, c, what, expect, got) {
+    ++nFailed;
+    console.error(d.name + ": " + c.name + ": " + what + " mismatch");
+    console.error("  expected: " + JSON.stringify(expect));
+    console.error("  got:      " + JSON.stringify(got));
+}
+
+// get decoded[name], where "a.b" means decoded.a.b.
+function getField(decoded, name) {
+    return name.split(".").reduce(function (o, key) {
+        return (o !== undefined && o !== null) ? o[key] : undefined;
+    }, decoded);
+}
+
+// a summary record as the decoder presents it; see
+// catena-message-port3-format-26.md.
+function summaryRawToDecoded(raw) {
+    var types = ttn.FED3SessionTypes;
+
+    return {
+        fed3Time: raw.time,
+        fed3DeviceNumber: raw.deviceNumber,
+        fed3SessionType: types[raw.sessionType < types.length ? raw.sessionType : 0],
+        sessionChanges: raw.sessionChanges,
+        windowSec: raw.windowSec,
+        events: raw.events,
+        leftPokes: raw.leftPokes,
+        rightPokes: raw.rightPokes,
+        pellets: raw.pellets,
+        pokeTimeMean: raw.pokeTimeMean * 4.0 / 1000.0,
+        pokeTimeMax: raw.pokeTimeMax * 4.0 / 1000.0,
+        retrievalTimeMean: raw.retrievalTimeMean * 4.0 / 1000.0,
+        retrievalTimeMax: raw.retrievalTimeMax * 4.0 / 1000.0,
+        fed3VbatMin: raw.vbatMin / 4096.0
+    };
+}
+
+function check(d, port, c) {
+    var decoded = d.decode(c.bytes, port);
+    var format = c.bytes[0];
+
+    ++nChecked;
+    if (decoded === null || typeof decoded !== "object") {
+        fail(d, c, "decode", "an object", decoded);
+        return;
+    }
+
+    Object.keys(c.fields).forEach(function (name) {
+        var expect = c.fields[name][0];
+        var tolerance = c.fields[name][1];
+        var got = getField(decoded, name);
+
+        if (typeof got !== "number" || Math.abs(got - expect) > tolerance)
+            fail(d, c, name, expect + " +/- " + tolerance, got);
+    });
+
+    if (format === 0x24) {
+        // the record's fields go straight into the message.
+        var expect = ttn.FED3RawToDecoded(c.fed3[0], {});
+        var got = {};
+
+        Object.keys(expect).forEach(function (key) { got[key] = decoded[key]; });
+        if (JSON.stringify(got) !== JSON.stringify(expect))
+            fail(d, c, "fed3", expect, got);
+    }
+    else if (format === 0x25) {
+        var expectBatch = c.fed3.map(function (raw) { return ttn.FED3RawToDecoded(raw, {}); });
+
+        if (c.fed3.length === 0 ? "fed3" in decoded
+                : JSON.stringify(decoded.fed3) !== JSON.stringify(expectBatch))
+            fail(d, c, "fed3", expectBatch, decoded.fed3);
+    }
+    else if (format === 0x26) {
+        var expectSummary = c.summary.map(summaryRawToDecoded);
+
+        if (JSON.stringify(decoded.fed3Summary) !== JSON.stringify(expectSummary))
+            fail(d, c, "fed3Summary", expectSummary, decoded.fed3Summary);
+    }
+}
+
+list.forEach(function (d) {
+    var port = Number(/port(\d+)/.exec(d.name)[1]);
+
+    cases.forEach(function (c) {
+        if (c.ports.indexOf(port) >= 0)
+            check(d, port, c);
+    });
+});
+
+console.log("check_Uplinks: " + nChecked + " checks, " + nFailed + " failed");
+process.exit(nFailed === 0 && nChecked !== 0 ? 0 : 1);
@@ -0,0 +1,64 @@
+/*
+
+Module: decoders.js
+
+Function:
+    Load the uplink decoders in extra/ into node, for the host tests.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+"use strict";
+
+var fs = require("fs");
+var path = require("path");
+
+// load a decoder; returns { name, decode(bytes, port), fns }, where
+// fns has the TTN decoder's helper functions (for node-red, null).
+function load(file) {
+    var src = fs.readFileSync(file, "utf8");
+    var name = path.basename(file);
+
+    if (/node-red/.test(name)) {
+        // a Node-RED function body: call it with a message.
+        var body = new Function("msg", "node", "Buffer", src);
+        var node = { error: function (e) { throw new Error(e); } };
+
+        return {
+            name: name,
+            decode: function (bytes, port) {
+                var msg = body({ payload: bytes, port: port }, node, Buffer);
+                return msg ? msg.payload : null;
+            },
+            fns: null
+        };
+    }
+
+    var fns = new Function(
+        src + "\nreturn { Decoder: Decoder, FED3RawToDecoded: FED3RawToDecoded," +
+            " FED3SessionTypes: FED3SessionTypes };"
+        )();
+
+    return {
+        name: name,
+        decode: function (bytes, port) {
+            return fns.Decoder(bytes, port);
+        },
+        fns: fns
+    };
+}
+
+// read a file of JSON lines.
+function readCases(file) {
+    return fs.readFileSync(file, "utf8")
+        .split("\n")
+        .filter(function (line) { return line.length > 0; })
+        .map(function (line) { return JSON.parse(line); });
+}
+
+module.exports = { load: load, readCases: readCases };
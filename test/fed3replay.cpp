@@ -0,0 +1,255 @@
+/*
+
+Module: fed3replay.cpp
+
+Function:
+    Replay captured FED3 serial traffic through the measurement loop,
+    on the host, and report what it made of it.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    Usage:
+
+        fed3replay [-v] capture...
+
+    Each capture is a scenario. Its bytes are fed in through
+    cMeasurementLoop::startTrafficReplay(), with their recorded timing,
+    so they take the same path as bytes from Serial1. The loop is the
+    host build used by test_cMeasurementLoop, run on the virtual clock,
+    a millisecond at a time. After each capture, the receive counts
+    are printed: frames received, damaged and dropped, and bytes lost
+    to full buffers. The loop is then run until it has sent every
+    event, or for at most kDrainMs. -v shows the sketch's console output as well.
+
+    A capture is text. Each line is a delay in milliseconds, then one
+    or more bytes in hex. The first byte arrives that long after the
+    byte before it; the rest follow back to back. Anything after a #
+    is ignored.
+
+*/
+
+#include "Catena4610_FED3.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+// as in Catena4610_FED3.ino.
+cMeasurementLoop gMeasurementLoop;
+
+namespace {
+
+// how long to let the loop send what's queued, after a capture.
+constexpr std::uint32_t kDrainMs = 10 * 60 * 1000;
+
+struct Capture
+    {
+    std::vector<std::uint8_t>   data;
+    std::vector<std::uint16_t>  delayMs;
+    };
+
+// the counts before a scenario, to report the difference.
+struct Counts
+    {
+    std::uint32_t   nIn;
+    std::uint32_t   nErr;
+    std::uint32_t   nFrames;
+    std::uint32_t   nCrcErrors;
+    std::uint32_t   nRunts;
+    std::uint32_t   nOverflows;
+    std::uint32_t   nUnknown;
+    std::uint32_t   nRxOverrun;
+    std::uint32_t   nQueueDropped;
+    std::uint32_t   nLogDropped;
+    std::size_t     nUplinks;
+
+    static Counts get()
+        {
+        Counts c {};
+
+        c.nIn = gMeasurementLoop.u16InCnt;
+        c.nErr = gMeasurementLoop.u16errCnt;
+        for (std::uint8_t i = 0; i < cMeasurementLoop::kFed3Devices; ++i)
+            {
+            auto const &stats = gMeasurementLoop.getFed3DeviceStats(i);
+
+            c.nFrames += stats.nFrames;
+            c.nCrcErrors += stats.nCrcErrors;
+            c.nRunts += stats.nRunts;
+            c.nOverflows += stats.nOverflows;
+            }
+        c.nUnknown = gMeasurementLoop.getFed3UnknownAddressCount();
+        c.nRxOverrun = gMeasurementLoop.getRxOverrunCount();
+        c.nQueueDropped = gMeasurementLoop.getEventDropCount();
+        c.nLogDropped = gMeasurementLoop.getEventLog().getDropCount();
+        c.nUplinks = gLoRaWAN.getUplinks().size();
+        return c;
+        }
+    };
+
+void run(std::uint32_t ms)
+    {
+    for (std::uint32_t i = 0; i < ms; ++i)
+        {
+        HostClock::advanceMillis(1);
+        gCatena.poll();
+        }
+    }
+
+bool load(const char *pName, Capture &capture)
+    {
+    std::FILE *const pFile = std::fopen(pName, "r");
+    char line[1024];
+    unsigned iLine = 0;
+
+    if (pFile == nullptr)
+        {
+        std::fprintf(stderr, "%s: %s\n", pName, std::strerror(errno));
+        return false;
+        }
+
+    while (std::fgets(line, sizeof(line), pFile) != nullptr)
+        {
+        ++iLine;
+        if (char *const pComment = std::strchr(line, '#'))
+            *pComment = '\0';
+
+        char *p = line;
+        char *pEnd;
+        unsigned long const delayMs = std::strtoul(p, &pEnd, 10);
+
+        // blank lines are fine.
+        if (pEnd == p)
+            {
+            while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+                ++p;
+            if (*p == '\0')
+                continue;
+            }
+
+        bool fFirst = true;
+        bool fOk = pEnd != p && delayMs <= 0xFFFF;
+
+        for (p = pEnd; fOk; p = pEnd, fFirst = false)
+            {
+            unsigned long const b = std::strtoul(p, &pEnd, 16);
+
+            if (pEnd == p)
+                break;
+
+            fOk = b <= 0xFF;
+            capture.data.push_back(std::uint8_t(b));
+            capture.delayMs.push_back(fFirst ? std::uint16_t(delayMs) : 0);
+            }
+
+        while (fOk && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+            ++p;
+
+        if (! fOk || fFirst || *p != '\0')
+            {
+            std::fprintf(stderr, "%s:%u: expected a delay and some hex bytes\n", pName, iLine);
+            std::fclose(pFile);
+            return false;
+            }
+        }
+
+    std::fclose(pFile);
+    return true;
+    }
+
+void report(const char *pName, const Counts &before, std::uint32_t tStart, std::uint32_t tEnd)
+    {
+    Counts const after = Counts::get();
+    auto const &gen = gMeasurementLoop.getTrafficGen();
+
+    std::printf("%s: %u bytes in %u ms\n",
+        pName, unsigned(gen.getByteCount()), unsigned(tEnd - tStart));
+    std::printf("  frames: %u received, %u bad\n",
+        unsigned(std::uint16_t(after.nIn - before.nIn)),
+        unsigned(std::uint16_t(after.nErr - before.nErr)));
+    std::printf("  good %u, crc %u, runt %u, overflow %u, unknown address %u\n",
+        unsigned(after.nFrames - before.nFrames),
+        unsigned(after.nCrcErrors - before.nCrcErrors),
+        unsigned(after.nRunts - before.nRunts),
+        unsigned(after.nOverflows - before.nOverflows),
+        unsigned(after.nUnknown - before.nUnknown));
+    std::printf("  bytes lost: %u to a full UART buffer, %u to a full receive ring\n",
+        unsigned(gen.getOverrunCount()),
+        unsigned(after.nRxOverrun - before.nRxOverrun));
+    std::printf("  events lost: %u from queue, %u from log\n",
+        unsigned(after.nQueueDropped - before.nQueueDropped),
+        unsigned(after.nLogDropped - before.nLogDropped));
+    std::printf("  %u uplinks in %u ms after; %u events still queued\n",
+        unsigned(after.nUplinks - before.nUplinks),
+        unsigned(millis() - tStart),
+        unsigned(gMeasurementLoop.getQueuedEventCount()));
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+    {
+    int iArg = 1;
+
+    if (iArg < argc && std::strcmp(argv[iArg], "-v") == 0)
+        {
+        gCatena.setEcho(true);
+        ++iArg;
+        }
+
+    if (iArg >= argc)
+        {
+        std::fprintf(stderr, "usage: fed3replay [-v] capture...\n");
+        return 2;
+        }
+
+    // set up as setup() does, and get past the warmup.
+    HostClock::setMicros64(1000000);
+    Serial1.begin(115200);
+    gMeasurementLoop.registerSecondSpi(&gSPI2);
+    gMeasurementLoop.registerFlash(&gFlash);
+    gCatena.registerObject(&gLoRaWAN);
+    gMeasurementLoop.begin();
+    gMeasurementLoop.requestActive(true);
+    run(10 * 1000);
+
+    for (; iArg < argc; ++iArg)
+        {
+        Capture capture;
+
+        if (! load(argv[iArg], capture))
+            return 1;
+
+        Counts const before = Counts::get();
+        std::uint32_t const tStart = millis();
+
+        gMeasurementLoop.startTrafficReplay(
+            capture.data.data(), capture.delayMs.data(), capture.data.size()
+            );
+        while (gMeasurementLoop.getTrafficGen().isActive())
+            run(1);
+
+        // let the last frame end, and give the loop a while to send
+        // what it has.
+        std::uint32_t const tEnd = millis();
+
+        do  {
+            run(100);
+            } while (gMeasurementLoop.getQueuedEventCount() != 0 &&
+                     millis() - tEnd < kDrainMs);
+
+        report(argv[iArg], before, tStart, tEnd);
+        }
+
+    return 0;
+    }
@@ -0,0 +1,78 @@
+/*
+
+Module: Adafruit_BME280.h
+
+Function:
+    Host stand-in for the MCCI fork of Adafruit_BME280, with fixed readings.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Adafruit_BME280_h_
+# define _Adafruit_BME280_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#define BME280_ADDRESS  0x77
+
+class Adafruit_BME280
+    {
+public:
+    enum class OPERATING_MODE
+        {
+        Sleep,
+        Forced,
+        Normal,
+        };
+
+    struct Measurements
+        {
+        float   Temperature;    // degrees C
+        float   Pressure;       // Pa
+        float   Humidity;       // % RH
+        };
+
+    bool begin(int address, OPERATING_MODE mode)
+        {
+        (void) address;
+        (void) mode;
+        return state().fPresent;
+        }
+    Measurements readTemperaturePressureHumidity()
+        {
+        return state().value;
+        }
+
+    // what the test controls; shared by every instance, as the test
+    // can't reach the loop's own.
+    static void setPresent(bool fPresent)
+        {
+        state().fPresent = fPresent;
+        }
+    static void setValue(const Measurements &value)
+        {
+        state().value = value;
+        }
+
+private:
+    struct State
+        {
+        Measurements    value = { 21.5f, 101325.0f, 45.0f };
+        bool            fPresent = true;
+        };
+
+    static State &state()
+        {
+        static State s;
+        return s;
+        }
+    };
+
+#endif /* _Adafruit_BME280_h_ */
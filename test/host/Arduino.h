@@ -0,0 +1,118 @@
+/*
+
+Module: Arduino.h
+
+Function:
+    Host stand-in for the parts of the Arduino core the sketch uses.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    millis() and micros() read the virtual clock (HostClock.h), and
+    Serial and Serial1 are cHostSerial stand-ins. Pins, SPI and I2C do
+    nothing. USBCON isn't defined, so there's no Serial.dtr().
+
+*/
+
+#ifndef _Arduino_h_
+# define _Arduino_h_
+
+#pragma once
+
+#include "HostClock.h"
+#include "HostSerial.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::int16_t;
+using std::int32_t;
+using std::size_t;
+
+typedef bool boolean;
+typedef std::uint8_t byte;
+
+#define INPUT   0
+#define OUTPUT  1
+#define LOW     0
+#define HIGH    1
+
+#define D11     11
+
+inline std::uint32_t millis()
+    {
+    return HostClock::millis();
+    }
+inline std::uint32_t micros()
+    {
+    return HostClock::micros();
+    }
+inline void delay(std::uint32_t ms)
+    {
+    HostClock::advanceMillis(ms);
+    }
+
+inline void pinMode(int pin, int mode)
+    {
+    (void) pin;
+    (void) mode;
+    }
+inline void digitalWrite(int pin, int value)
+    {
+    (void) pin;
+    (void) value;
+    }
+
+inline void noInterrupts()
+    {
+    }
+inline void interrupts()
+    {
+    }
+
+extern cHostSerial Serial;
+extern cHostSerial Serial1;
+
+class SPIClass
+    {
+public:
+    SPIClass(int mosi = 0, int miso = 0, int sck = 0)
+        {
+        (void) mosi;
+        (void) miso;
+        (void) sck;
+        }
+    void begin()
+        {
+        }
+    void end()
+        {
+        }
+    };
+
+extern SPIClass SPI;
+
+class TwoWire
+    {
+public:
+    void begin()
+        {
+        }
+    void end()
+        {
+        }
+    };
+
+extern TwoWire Wire;
+
+#endif /* _Arduino_h_ */
@@ -0,0 +1,207 @@
+/*
+
+Module: Catena.h
+
+Function:
+    Host stand-in for McciCatena::Catena and its LoRaWAN object.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    Only what the measurement loop uses. The supply voltages, boot
+    count and operating flags are whatever the test sets. Sleep() just
+    moves the virtual clock on. The LoRaWAN object keeps each uplink it
+    is given, and completes it, as the test says, a while later.
+
+*/
+
+#ifndef _Catena_h_
+# define _Catena_h_
+
+#pragma once
+
+#include <Arduino.h>
+#include <Catena_Fram.h>
+#include <Catena_PollableInterface.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace McciCatena {
+
+class Catena
+    {
+public:
+    enum class OPERATING_FLAGS : std::uint32_t
+        {
+        fUnattended = 1 << 0,
+        fManufacturingTest = 1 << 1,
+        fConfirmedUplink = 1 << 16,
+        fDisableDeepSleep = 1 << 17,
+        fQuickLightSleep = 1 << 18,
+        fDeepSleepTest = 1 << 19,
+        };
+
+    // printf to stdout, if echo is on.
+    void SafePrintf(const char *pFmt, ...)
+        __attribute__((__format__(__printf__, 2, 3)));
+    void setEcho(bool fEcho)
+        {
+        this->m_fEcho = fEcho;
+        }
+
+    void registerObject(cPollableObject *pObject)
+        {
+        this->m_objects.push_back(pObject);
+        }
+    // poll everything registered, as the sketch's loop() does.
+    void poll()
+        {
+        for (auto pObject : this->m_objects)
+            pObject->poll();
+        }
+
+    std::uint32_t GetOperatingFlags()
+        {
+        return this->m_flags;
+        }
+    void SetOperatingFlags(std::uint32_t flags)
+        {
+        this->m_flags = flags;
+        }
+
+    float ReadVbat()
+        {
+        return this->m_Vbat;
+        }
+    float ReadVbus()
+        {
+        return this->m_Vbus;
+        }
+    void setSupply(float Vbat, float Vbus)
+        {
+        this->m_Vbat = Vbat;
+        this->m_Vbus = Vbus;
+        }
+
+    bool getBootCount(std::uint32_t &bootCount)
+        {
+        bootCount = this->m_bootCount;
+        return true;
+        }
+
+    void Sleep(std::uint32_t sec)
+        {
+        HostClock::advanceMillis(sec * 1000);
+        }
+
+    cFram *getFram()
+        {
+        return &this->m_fram;
+        }
+
+    class LoRaWAN : public cPollableObject
+        {
+    public:
+        typedef void SendBufferCbFn(void *pClientData, bool fSuccess);
+
+        // an uplink, as handed to SendBuffer().
+        struct Uplink
+            {
+            std::uint32_t               tSend;      // millis()
+            std::uint8_t                port;
+            bool                        fConfirmed;
+            bool                        fSuccess;
+            std::vector<std::uint8_t>   data;
+            };
+
+        bool IsProvisioned()
+            {
+            return this->m_fProvisioned;
+            }
+
+        bool SendBuffer(
+                const std::uint8_t *pBuffer,
+                std::size_t nBuffer,
+                SendBufferCbFn *pDoneFn,
+                void *pClientData,
+                bool fConfirmed,
+                std::uint8_t port
+                )
+            {
+            if (this->m_pDoneFn != nullptr)
+                return false;
+
+            this->m_uplinks.push_back(
+                Uplink { millis(), port, fConfirmed, this->m_fTxSuccess,
+                         std::vector<std::uint8_t>(pBuffer, pBuffer + nBuffer) }
+                );
+            this->m_pDoneFn = pDoneFn;
+            this->m_pClientData = pClientData;
+            this->m_tDone = millis() + this->m_txTimeMs;
+            return true;
+            }
+
+        // complete the uplink in progress, once its time is up.
+        virtual void poll() override
+            {
+            if (this->m_pDoneFn == nullptr ||
+                std::int32_t(millis() - this->m_tDone) < 0)
+                return;
+
+            auto const pDoneFn = this->m_pDoneFn;
+
+            this->m_pDoneFn = nullptr;
+            pDoneFn(this->m_pClientData, this->m_uplinks.back().fSuccess);
+            }
+
+        // what the test controls.
+        void setProvisioned(bool fProvisioned)
+            {
+            this->m_fProvisioned = fProvisioned;
+            }
+        void setTxResult(bool fSuccess)
+            {
+            this->m_fTxSuccess = fSuccess;
+            }
+        void setTxTime(std::uint32_t ms)
+            {
+            this->m_txTimeMs = ms;
+            }
+
+        const std::vector<Uplink> &getUplinks() const
+            {
+            return this->m_uplinks;
+            }
+        void clearUplinks()
+            {
+            this->m_uplinks.clear();
+            }
+
+    private:
+        std::vector<Uplink>     m_uplinks;
+        SendBufferCbFn          *m_pDoneFn = nullptr;
+        void                    *m_pClientData = nullptr;
+        std::uint32_t           m_tDone = 0;
+        std::uint32_t           m_txTimeMs = 1500;
+        bool                    m_fProvisioned = true;
+        bool                    m_fTxSuccess = true;
+        };
+
+private:
+    std::vector<cPollableObject *>  m_objects;
+    cFram                           m_fram;
+    std::uint32_t                   m_flags = 0;
+    std::uint32_t                   m_bootCount = 1;
+    float                           m_Vbat = 3.7f;
+    float                           m_Vbus = 0.0f;
+    bool                            m_fEcho = false;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_h_ */
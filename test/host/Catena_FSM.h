@@ -0,0 +1,93 @@
+/*
+
+Module: Catena_FSM.h
+
+Function:
+    Host stand-in for McciCatena::cFSM.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    Behaves as the Catena library's: init() enters TState::stInitial,
+    and eval() calls the dispatch function until it returns
+    TState::stNoChange, with fEntry true on the first call in each new
+    state. An eval() from within the dispatch function makes the
+    outer one go round again, rather than recursing.
+
+*/
+
+#ifndef _Catena_FSM_h_
+# define _Catena_FSM_h_
+
+#pragma once
+
+namespace McciCatena {
+
+template <class TParent, class TState>
+class cFSM
+    {
+public:
+    typedef TState (TParent::*Dispatch)(TState currentState, bool fEntry);
+
+    void init(TParent &parent, Dispatch dispatch)
+        {
+        this->m_pParent = &parent;
+        this->m_dispatch = dispatch;
+        this->m_state = TState::stInitial;
+        this->m_fEntry = true;
+        this->eval();
+        }
+
+    void eval()
+        {
+        if (this->m_pParent == nullptr)
+            return;
+
+        if (this->m_fBusy)
+            {
+            this->m_fAgain = true;
+            return;
+            }
+
+        this->m_fBusy = true;
+        do  {
+            this->m_fAgain = false;
+
+            for (;;)
+                {
+                bool const fEntry = this->m_fEntry;
+                this->m_fEntry = false;
+
+                TState const newState = (this->m_pParent->*this->m_dispatch)(this->m_state, fEntry);
+
+                if (newState == TState::stNoChange)
+                    break;
+
+                this->m_state = newState;
+                this->m_fEntry = true;
+                }
+            } while (this->m_fAgain);
+        this->m_fBusy = false;
+        }
+
+    TState getState() const
+        {
+        return this->m_state;
+        }
+
+private:
+    TParent     *m_pParent = nullptr;
+    Dispatch    m_dispatch = nullptr;
+    TState      m_state = TState::stInitial;
+    bool        m_fEntry = false;
+    bool        m_fBusy = false;
+    bool        m_fAgain = false;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_FSM_h_ */
@@ -0,0 +1,60 @@
+/*
+
+Module: Catena_Fram.h
+
+Function:
+    Host stand-in for McciCatena::cFram: 32 KiB of RAM.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_Fram_h_
+# define _Catena_Fram_h_
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena {
+
+class cFram
+    {
+public:
+    // the Catena 4610's MB85RC256V.
+    static constexpr std::size_t kSize = 32 * 1024;
+
+    bool read(std::uint32_t offset, std::uint8_t *pBuffer, std::size_t nBuffer)
+        {
+        if (offset > kSize || nBuffer > kSize - offset)
+            return false;
+
+        std::memcpy(pBuffer, this->m_data + offset, nBuffer);
+        return true;
+        }
+    bool write(std::uint32_t offset, const std::uint8_t *pBuffer, std::size_t nBuffer)
+        {
+        if (offset > kSize || nBuffer > kSize - offset)
+            return false;
+
+        std::memcpy(this->m_data + offset, pBuffer, nBuffer);
+        return true;
+        }
+    std::size_t getsize() const
+        {
+        return kSize;
+        }
+
+private:
+    std::uint8_t    m_data[kSize] = {};
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_Fram_h_ */
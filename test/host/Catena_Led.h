@@ -0,0 +1,55 @@
+/*
+
+Module: Catena_Led.h
+
+Function:
+    Host stand-in for McciCatena::StatusLed; it remembers the pattern.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_Led_h_
+# define _Catena_Led_h_
+
+#pragma once
+
+namespace McciCatena {
+
+enum class LedPattern
+    {
+    Off,
+    Sleeping,
+    Sending,
+    Measuring,
+    TwoShort,
+    };
+
+class StatusLed
+    {
+public:
+    StatusLed(int pin = 0)
+        {
+        (void) pin;
+        }
+
+    void Set(LedPattern pattern)
+        {
+        this->m_pattern = pattern;
+        }
+    LedPattern get() const
+        {
+        return this->m_pattern;
+        }
+
+private:
+    LedPattern  m_pattern = LedPattern::Off;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_Led_h_ */
@@ -0,0 +1,23 @@
+/*
+
+Module: Catena_Log.h
+
+Function:
+    Host stand-in: the sketch needs nothing from Catena_Log.h beyond Arduino.h.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_Log_h_
+# define _Catena_Log_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#endif /* _Catena_Log_h_ */
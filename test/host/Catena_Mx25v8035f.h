@@ -0,0 +1,101 @@
+/*
+
+Module: Catena_Mx25v8035f.h
+
+Function:
+    Host stand-in for the MX25V8035F: 1 MiB of RAM that behaves as NOR flash.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_Mx25v8035f_h_
+# define _Catena_Mx25v8035f_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace McciCatena {
+
+class Catena_Mx25v8035f
+    {
+public:
+    enum : std::uint32_t
+        {
+        SECTOR_SIZE = 4096,
+        PAGE_SIZE = 256,
+        CHIP_SIZE = 1024 * 1024,
+        };
+
+    // starts erased.
+    Catena_Mx25v8035f()
+        : m_data(CHIP_SIZE, 0xFF)
+        {
+        }
+
+    bool begin(SPIClass *pSpi, std::uint8_t chipSelectPin)
+        {
+        (void) pSpi;
+        (void) chipSelectPin;
+        return true;
+        }
+    void end()
+        {
+        }
+    void powerDown()
+        {
+        }
+    void powerUp()
+        {
+        }
+
+    void read(std::uint32_t addr, std::uint8_t *pBuffer, std::size_t nBuffer)
+        {
+        for (std::size_t i = 0; i < nBuffer; ++i)
+            pBuffer[i] = this->m_data[(addr + i) % CHIP_SIZE];
+        }
+    // programming can only clear bits, and wraps within the page.
+    void programPage(std::uint32_t addr, const std::uint8_t *pBuffer, std::size_t nBuffer)
+        {
+        std::uint32_t const page = addr - addr % PAGE_SIZE;
+
+        if (this->m_fFailing)
+            return;
+
+        for (std::size_t i = 0; i < nBuffer; ++i)
+            this->m_data[(page + (addr + i) % PAGE_SIZE) % CHIP_SIZE] &= pBuffer[i];
+        }
+    bool eraseSector(std::uint32_t addr)
+        {
+        addr -= addr % SECTOR_SIZE;
+        if (this->m_fFailing || addr >= CHIP_SIZE)
+            return false;
+
+        std::memset(&this->m_data[addr], 0xFF, SECTOR_SIZE);
+        return true;
+        }
+
+    // for tests: a worn-out part, whose programs and erases change
+    // nothing. Only the erase says so.
+    void setFailing(bool fFailing)
+        {
+        this->m_fFailing = fFailing;
+        }
+
+private:
+    std::vector<std::uint8_t>   m_data;
+    bool                        m_fFailing = false;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_Mx25v8035f_h_ */
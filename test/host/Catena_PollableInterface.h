@@ -0,0 +1,32 @@
+/*
+
+Module: Catena_PollableInterface.h
+
+Function:
+    Host stand-in for McciCatena::cPollableObject.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_PollableInterface_h_
+# define _Catena_PollableInterface_h_
+
+#pragma once
+
+namespace McciCatena {
+
+class cPollableObject
+    {
+public:
+    virtual ~cPollableObject() = default;
+    virtual void poll() = 0;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_PollableInterface_h_ */
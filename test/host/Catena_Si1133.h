@@ -0,0 +1,113 @@
+/*
+
+Module: Catena_Si1133.h
+
+Function:
+    Host stand-in for McciCatena::Catena_Si1133: a light sensor that always reads the same.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_Si1133_h_
+# define _Catena_Si1133_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstdint>
+
+namespace McciCatena {
+
+class Catena_Si1133
+    {
+public:
+    enum class InputLed_t : std::uint8_t
+        {
+        SmallIR,
+        MediumIR,
+        LargeIR,
+        SmallWhite,
+        MediumWhite,
+        LargeWhite,
+        };
+
+    class ChannelConfiguration_t
+        {
+    public:
+        ChannelConfiguration_t &setAdcMux(InputLed_t v)         { (void) v; return *this; }
+        ChannelConfiguration_t &setSwGainCode(std::uint8_t v)   { (void) v; return *this; }
+        ChannelConfiguration_t &setHwGainCode(std::uint8_t v)   { (void) v; return *this; }
+        ChannelConfiguration_t &setPostShift(std::uint8_t v)    { (void) v; return *this; }
+        ChannelConfiguration_t &set24bit(bool v)                { (void) v; return *this; }
+        };
+
+    bool begin()
+        {
+        return state().fPresent;
+        }
+    bool configure(std::uint8_t channel, ChannelConfiguration_t config, std::uint8_t measCount)
+        {
+        (void) channel;
+        (void) config;
+        (void) measCount;
+        return state().fPresent;
+        }
+    bool start(bool fOneTime)
+        {
+        (void) fOneTime;
+        this->m_fRunning = state().fPresent;
+        return this->m_fRunning;
+        }
+    bool stop()
+        {
+        this->m_fRunning = false;
+        return true;
+        }
+    // the conversion is done by the time anyone asks.
+    bool isOneTimeReady()
+        {
+        return this->m_fRunning;
+        }
+    bool readMultiChannelData(std::uint32_t *pData, std::uint32_t nData)
+        {
+        for (std::uint32_t i = 0; i < nData; ++i)
+            pData[i] = state().value;
+        return this->m_fRunning;
+        }
+
+    // what the test controls; shared by every instance, as the test
+    // can't reach the loop's own.
+    static void setPresent(bool fPresent)
+        {
+        state().fPresent = fPresent;
+        }
+    static void setValue(std::uint32_t value)
+        {
+        state().value = value;
+        }
+
+private:
+    struct State
+        {
+        std::uint32_t   value = 1000;
+        bool            fPresent = true;
+        };
+
+    static State &state()
+        {
+        static State s;
+        return s;
+        }
+
+    bool            m_fRunning = false;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_Si1133_h_ */
@@ -0,0 +1,107 @@
+/*
+
+Module: Catena_Timer.h
+
+Function:
+    Host stand-in for McciCatena::cTimer, on the virtual clock.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    As in the Catena library, the timer ticks once per interval, and
+    the ticks are counted until they're taken by isready(). The library
+    counts them when the timer is polled; this one counts them when
+    it's asked.
+
+*/
+
+#ifndef _Catena_Timer_h_
+# define _Catena_Timer_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstdint>
+
+namespace McciCatena {
+
+class cTimer
+    {
+public:
+    bool begin(std::uint32_t nMillis)
+        {
+        this->m_interval = nMillis;
+        this->m_time = millis();
+        this->m_events = 0;
+        return true;
+        }
+
+    void setInterval(std::uint32_t nMillis)
+        {
+        this->m_interval = nMillis;
+        }
+    std::uint32_t getInterval() const
+        {
+        return this->m_interval;
+        }
+
+    // number of ticks not yet taken.
+    std::uint32_t peekTicks()
+        {
+        this->update();
+        return this->m_events;
+        }
+    // take a tick, if there is one.
+    bool isready()
+        {
+        this->update();
+        if (this->m_events == 0)
+            return false;
+
+        --this->m_events;
+        return true;
+        }
+
+    // milliseconds until the next tick.
+    std::uint32_t getRemaining()
+        {
+        this->update();
+        if (this->m_events != 0)
+            return 0;
+
+        return this->m_interval - (millis() - this->m_time);
+        }
+
+    // start the interval over, dropping any ticks.
+    void retrigger()
+        {
+        this->m_time = millis();
+        this->m_events = 0;
+        }
+
+private:
+    void update()
+        {
+        if (this->m_interval == 0)
+            return;
+
+        while (millis() - this->m_time >= this->m_interval)
+            {
+            this->m_time += this->m_interval;
+            ++this->m_events;
+            }
+        }
+
+    std::uint32_t   m_time = 0;
+    std::uint32_t   m_interval = 0;
+    std::uint32_t   m_events = 0;
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_Timer_h_ */
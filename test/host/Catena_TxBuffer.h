@@ -0,0 +1,37 @@
+/*
+
+Module: Catena_TxBuffer.h
+
+Function:
+    Host stand-in for Catena_TxBuffer.h: just TxBuffer_t::f2uflt16().
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Catena_TxBuffer_h_
+# define _Catena_TxBuffer_h_
+
+#pragma once
+
+#include <arduino_lmic.h>
+
+#include <cstdint>
+
+namespace McciCatena {
+
+struct TxBuffer_t
+    {
+    static std::uint16_t f2uflt16(float f)
+        {
+        return LMIC_f2uflt16(f);
+        }
+    };
+
+} // namespace McciCatena
+
+#endif /* _Catena_TxBuffer_h_ */
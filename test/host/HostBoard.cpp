@@ -0,0 +1,110 @@
+/*
+
+Module: HostBoard.cpp
+
+Function:
+    The Catena 4610 as the host tests see it: the core's and the
+    platform's global objects, made of the stand-ins in this directory.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    The sketch's own globals are defined as in Catena4610_FED3.ino,
+    except gMeasurementLoop, which each test defines for itself.
+
+*/
+
+#include <Arduino.h>
+#include <arduino_lmic.h>
+#include <Catena.h>
+#include <Catena_Led.h>
+#include <Catena_Mx25v8035f.h>
+#include <Catena_Timer.h>
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+using namespace McciCatena;
+
+/****************************************************************************\
+|
+|   The core
+|
+\****************************************************************************/
+
+cHostSerial Serial;
+cHostSerial Serial1;
+SPIClass SPI;
+TwoWire Wire;
+
+/****************************************************************************\
+|
+|   The LMIC
+|
+\****************************************************************************/
+
+lmic_t LMIC;
+
+// 4 bits of exponent and 12 of significand, for values in [0, 1).
+std::uint16_t LMIC_f2uflt16(float f)
+    {
+    if (f < 0.0f)
+        return 0;
+    else if (f >= 1.0f)
+        return 0xFFFF;
+
+    int iExp;
+    float const normalValue = std::frexp(f, &iExp);
+
+    iExp += 15;
+    if (iExp < 0)
+        iExp = 0;
+
+    std::uint32_t outputFraction = std::uint32_t(std::ldexp(normalValue, 12) + 0.5f);
+    if (outputFraction >= (1u << 12))
+        {
+        outputFraction = 1u << 11;
+        ++iExp;
+        }
+
+    if (iExp > 15)
+        return 0xFFFF;
+
+    return std::uint16_t((iExp << 12) | outputFraction);
+    }
+
+/****************************************************************************\
+|
+|   The platform
+|
+\****************************************************************************/
+
+void Catena::SafePrintf(const char *pFmt, ...)
+    {
+    if (! this->m_fEcho)
+        return;
+
+    std::va_list ap;
+
+    va_start(ap, pFmt);
+    std::vprintf(pFmt, ap);
+    va_end(ap);
+    }
+
+/****************************************************************************\
+|
+|   The sketch's globals
+|
+\****************************************************************************/
+
+Catena gCatena;
+Catena::LoRaWAN gLoRaWAN;
+StatusLed gLed;
+cTimer ledTimer;
+SPIClass gSPI2;
+Catena_Mx25v8035f gFlash;
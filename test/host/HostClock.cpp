@@ -0,0 +1,47 @@
+/*
+
+Module: HostClock.cpp
+
+Function:
+    The virtual clock for the host tests.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "HostClock.h"
+
+#include <chrono>
+
+using Clock_t = std::chrono::steady_clock;
+
+// in real time, the time is sMicros plus the real time since sStart.
+static std::uint64_t sMicros;
+static bool sfRealTime;
+static Clock_t::time_point sStart;
+
+std::uint64_t HostClock::getMicros64()
+    {
+    if (! sfRealTime)
+        return sMicros;
+
+    return sMicros + std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock_t::now() - sStart
+                        ).count();
+    }
+
+void HostClock::setMicros64(std::uint64_t t)
+    {
+    sMicros = t;
+    sStart = Clock_t::now();
+    }
+
+void HostClock::setRealTime(bool fRealTime)
+    {
+    setMicros64(getMicros64());
+    sfRealTime = fRealTime;
+    }
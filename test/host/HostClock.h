@@ -0,0 +1,53 @@
+/*
+
+Module: HostClock.h
+
+Function:
+    A virtual clock for the host tests, standing in for millis()
+    and micros().
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _HostClock_h_
+# define _HostClock_h_
+
+#pragma once
+
+#include <cstdint>
+
+namespace HostClock {
+
+// the time, in microseconds since the test started. It only moves
+// when the test moves it, unless it's set to follow real time, as
+// benchmarks need.
+std::uint64_t getMicros64();
+void setMicros64(std::uint64_t t);
+void setRealTime(bool fRealTime);
+
+inline std::uint32_t micros()
+    {
+    return std::uint32_t(getMicros64());
+    }
+inline std::uint32_t millis()
+    {
+    return std::uint32_t(getMicros64() / 1000);
+    }
+
+inline void advanceMicros(std::uint32_t dt)
+    {
+    setMicros64(getMicros64() + dt);
+    }
+inline void advanceMillis(std::uint32_t dt)
+    {
+    setMicros64(getMicros64() + std::uint64_t(dt) * 1000);
+    }
+
+} // namespace HostClock
+
+#endif /* _HostClock_h_ */
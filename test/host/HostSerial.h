@@ -0,0 +1,144 @@
+/*
+
+Module: HostSerial.h
+
+Function:
+    cHostSerial: a stand-in for Serial1, fed from a schedule of
+    byte arrival times on the virtual clock.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _HostSerial_h_
+# define _HostSerial_h_
+
+#pragma once
+
+#include "HostClock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/*
+
+Class:  cHostSerial
+
+Description:
+    Models the receive side of a UART and the Arduino core's receive
+    buffer. Bytes are put on the line with send(), each arriving
+    kByteTimeUs after the one before; a byte only becomes available()
+    once the virtual clock has passed its arrival time. As in the core,
+    a byte that arrives while the receive buffer is full is lost.
+
+*/
+
+class cHostSerial
+    {
+public:
+    // one byte at 115200 baud, 8N1, in microseconds.
+    static constexpr std::uint32_t kByteTimeUs = 87;
+    // the STM32 cores' SERIAL_RX_BUFFER_SIZE.
+    static constexpr std::size_t kRxBufferSize = 64;
+
+    void begin(unsigned long baud = 0)
+        {
+        (void) baud;
+        }
+    void end()
+        {
+        }
+
+    // put n bytes on the line, back to back, the first starting at
+    // tStartUs (default: when the line is next free). Returns the time
+    // the last byte has arrived.
+    std::uint64_t send(const std::uint8_t *pData, std::size_t n, std::uint64_t tStartUs = 0)
+        {
+        std::uint64_t t = tStartUs > this->m_tLineFree ? tStartUs : this->m_tLineFree;
+
+        for (std::size_t i = 0; i < n; ++i)
+            {
+            t += kByteTimeUs;
+            this->m_line.push_back(Byte { t, pData[i] });
+            }
+
+        this->m_tLineFree = t;
+        return t;
+        }
+
+    int available()
+        {
+        this->receive();
+        return int(this->m_rx.size());
+        }
+    int peek()
+        {
+        this->receive();
+        return this->m_rx.empty() ? -1 : this->m_rx.front();
+        }
+    int read()
+        {
+        this->receive();
+        if (this->m_rx.empty())
+            return -1;
+
+        int const c = this->m_rx.front();
+        this->m_rx.pop_front();
+        return c;
+        }
+    std::size_t write(std::uint8_t b)
+        {
+        (void) b;
+        return 1;
+        }
+    void flush()
+        {
+        }
+
+    // true if nothing is on the line or waiting to be read.
+    bool isIdle()
+        {
+        this->receive();
+        return this->m_line.empty() && this->m_rx.empty();
+        }
+
+    // bytes lost to a full receive buffer.
+    std::uint32_t getOverrunCount() const
+        {
+        return this->m_nOverrun;
+        }
+
+private:
+    struct Byte
+        {
+        std::uint64_t   tArrive;
+        std::uint8_t    b;
+        };
+
+    // move bytes that have arrived into the receive buffer.
+    void receive()
+        {
+        std::uint64_t const tNow = HostClock::getMicros64();
+
+        while (! this->m_line.empty() && this->m_line.front().tArrive <= tNow)
+            {
+            if (this->m_rx.size() < kRxBufferSize)
+                this->m_rx.push_back(this->m_line.front().b);
+            else
+                ++this->m_nOverrun;
+            this->m_line.pop_front();
+            }
+        }
+
+    std::deque<Byte>            m_line;
+    std::deque<std::uint8_t>    m_rx;
+    std::uint64_t               m_tLineFree = 0;
+    std::uint32_t               m_nOverrun = 0;
+    };
+
+#endif /* _HostSerial_h_ */
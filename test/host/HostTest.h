@@ -0,0 +1,64 @@
+/*
+
+Module: HostTest.h
+
+Function:
+    Minimal check macros for the host tests.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _HostTest_h_
+# define _HostTest_h_
+
+#pragma once
+
+#include <cstdio>
+
+namespace HostTest {
+
+// number of checks that failed so far.
+extern unsigned gnFailed;
+// number of checks made so far.
+extern unsigned gnChecked;
+
+inline bool check(bool fOk, const char *pExpr, const char *pFile, int line)
+    {
+    ++gnChecked;
+    if (! fOk)
+        {
+        ++gnFailed;
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", pFile, line, pExpr);
+        }
+    return fOk;
+    }
+
+// print the totals; the result is the test's exit status.
+inline int report(const char *pName)
+    {
+    std::printf(
+        "%s: %u checks, %u failed\n",
+        pName, gnChecked, gnFailed
+        );
+    return gnFailed == 0 ? 0 : 1;
+    }
+
+} // namespace HostTest
+
+// define the counters; use once per test program.
+#define HOST_TEST_MAIN                                                  \
+    unsigned HostTest::gnFailed = 0;                                    \
+    unsigned HostTest::gnChecked = 0
+
+#define CHECK(e)                                                        \
+    HostTest::check(bool(e), #e, __FILE__, __LINE__)
+
+#define CHECK_EQ(a, b)                                                  \
+    HostTest::check((a) == (b), #a " == " #b, __FILE__, __LINE__)
+
+#endif /* _HostTest_h_ */
@@ -0,0 +1,23 @@
+/*
+
+Module: SD.h
+
+Function:
+    Host stand-in: the sketch needs nothing from SD.h beyond Arduino.h.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _SD_h_
+# define _SD_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#endif /* _SD_h_ */
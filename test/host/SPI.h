@@ -0,0 +1,23 @@
+/*
+
+Module: SPI.h
+
+Function:
+    Host stand-in: the sketch needs nothing from SPI.h beyond Arduino.h.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _SPI_h_
+# define _SPI_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#endif /* _SPI_h_ */
@@ -0,0 +1,23 @@
+/*
+
+Module: Wire.h
+
+Function:
+    Host stand-in: the sketch needs nothing from Wire.h beyond Arduino.h.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _Wire_h_
+# define _Wire_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#endif /* _Wire_h_ */
@@ -0,0 +1,35 @@
+/*
+
+Module: arduino_lmic.h
+
+Function:
+    Host stand-in for the parts of arduino-lmic the sketch uses.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _arduino_lmic_h_
+# define _arduino_lmic_h_
+
+#pragma once
+
+#include <cstdint>
+
+// no CFG_ region is defined, so the sketch takes the EU868 limits.
+
+struct lmic_t
+    {
+    std::uint8_t    datarate;
+    };
+
+extern lmic_t LMIC;
+
+// as LMIC_f2uflt16() in lmic_util.c.
+std::uint16_t LMIC_f2uflt16(float f);
+
+#endif /* _arduino_lmic_h_ */
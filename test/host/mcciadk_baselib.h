@@ -0,0 +1,23 @@
+/*
+
+Module: mcciadk_baselib.h
+
+Function:
+    Host stand-in: the sketch needs nothing from mcciadk_baselib.h beyond Arduino.h.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#ifndef _mcciadk_baselib_h_
+# define _mcciadk_baselib_h_
+
+#pragma once
+
+#include <Arduino.h>
+
+#endif /* _mcciadk_baselib_h_ */
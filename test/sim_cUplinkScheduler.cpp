@@ -0,0 +1,211 @@
+/*
+
+Module: sim_cUplinkScheduler.cpp
+
+Function:
+    Off-target simulation of FED3 uplink latency and air time, with the
+    old fixed uplink cycle and with cUplinkScheduler.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    A day of FED3 activity: a 10-minute bout once an hour, starting
+    5 minutes into the hour. Within a bout, the gaps between events are
+    exponential, with a mean of kMeanGapMs. The random numbers come
+    from a fixed seed, so every run gives the same events.
+
+    Each policy sends the oldest pending events, as many as fit in an
+    uplink; an uplink takes its air time, and nothing else is sent
+    meanwhile. The fixed cycle sends every 3 minutes, as the sketch did
+    before the scheduler, and ignores the duty cycle. The scheduler is
+    asked every millisecond, with its default Config. Heartbeats are
+    left out of both: only uplinks that carry events are counted.
+
+    Latency is from the event's arrival to the start of the uplink
+    that carries it.
+
+*/
+
+#include "Catena4610_cUplinkScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace McciCatena4610;
+
+namespace {
+
+constexpr std::uint32_t kDayMs = 24 * 60 * 60 * 1000;
+constexpr std::uint32_t kHourMs = 60 * 60 * 1000;
+constexpr std::uint32_t kBoutStartMs = 5 * 60 * 1000;
+constexpr std::uint32_t kBoutMs = 10 * 60 * 1000;
+constexpr std::uint32_t kMeanGapMs = 20 * 1000;
+constexpr std::uint32_t kFixedCycleMs = 3 * 60 * 1000;
+
+// an uplink size: events per uplink, and the air time it takes.
+struct Link
+    {
+    const char      *pName;
+    std::uint32_t   nPerUplink;
+    std::uint32_t   airtimeMs;
+    };
+
+struct Result
+    {
+    std::vector<std::uint32_t>  latencyMs;
+    std::uint32_t               nUplinks = 0;
+    std::uint32_t               airtimeMs = 0;
+    };
+
+// the arrival times of a day's events, in ms.
+std::vector<std::uint32_t> makeEvents()
+    {
+    std::mt19937 rng(4610);
+    std::vector<std::uint32_t> events;
+
+    for (std::uint32_t tHour = 0; tHour < kDayMs; tHour += kHourMs)
+        {
+        std::uint32_t const tStart = tHour + kBoutStartMs;
+        double t = tStart;
+
+        for (;;)
+            {
+            // mt19937's output is the same everywhere; the standard
+            // distributions' isn't, so draw the exponential here.
+            double const u = (rng() + 0.5) / 4294967296.0;
+
+            t += -std::log(u) * kMeanGapMs;
+            if (t >= tStart + kBoutMs)
+                break;
+            events.push_back(std::uint32_t(t));
+            }
+        }
+
+    return events;
+    }
+
+// send the oldest pending events, as many as fit.
+void send(
+    std::uint32_t tNow,
+    const Link &link,
+    std::deque<std::uint32_t> &pending,
+    Result &result
+    )
+    {
+    for (std::uint32_t i = 0; i < link.nPerUplink && ! pending.empty(); ++i)
+        {
+        result.latencyMs.push_back(tNow - pending.front());
+        pending.pop_front();
+        }
+
+    ++result.nUplinks;
+    result.airtimeMs += link.airtimeMs;
+    }
+
+Result runFixed(const std::vector<std::uint32_t> &events, const Link &link)
+    {
+    Result result;
+    std::deque<std::uint32_t> pending;
+    auto iEvent = events.begin();
+
+    // run on until everything's gone.
+    for (std::uint32_t t = 0; t < kDayMs || ! pending.empty(); t += kFixedCycleMs)
+        {
+        for (; iEvent != events.end() && *iEvent <= t; ++iEvent)
+            pending.push_back(*iEvent);
+
+        if (! pending.empty())
+            send(t, link, pending, result);
+        }
+
+    return result;
+    }
+
+Result runScheduler(const std::vector<std::uint32_t> &events, const Link &link)
+    {
+    cUplinkScheduler scheduler;
+    Result result;
+    std::deque<std::uint32_t> pending;
+    std::uint32_t tBusy = 0;
+    auto iEvent = events.begin();
+
+    scheduler.begin(0);
+    for (std::uint32_t t = 0; t < kDayMs || ! pending.empty(); ++t)
+        {
+        for (; iEvent != events.end() && *iEvent <= t; ++iEvent)
+            {
+            pending.push_back(*iEvent);
+            scheduler.noteEvent(t);
+            }
+
+        if (t < tBusy || pending.empty())
+            continue;
+
+        if (scheduler.getDelayMs(t, pending.size(), link.nPerUplink, link.airtimeMs) == 0)
+            {
+            send(t, link, pending, result);
+            scheduler.noteUplink(t, link.airtimeMs, pending.size());
+            tBusy = t + link.airtimeMs;
+            }
+        }
+
+    return result;
+    }
+
+std::uint32_t percentile(std::vector<std::uint32_t> latencyMs, unsigned p)
+    {
+    std::sort(latencyMs.begin(), latencyMs.end());
+    return latencyMs[(latencyMs.size() - 1) * p / 100];
+    }
+
+void report(const char *pName, const Result &result)
+    {
+    std::printf(
+        "  %-11s latency p50 %5.1f s, p90 %5.1f s, p99 %5.1f s; "
+        "%u uplinks, %.1f s of air (%.2f%%)\n",
+        pName,
+        percentile(result.latencyMs, 50) / 1000.0,
+        percentile(result.latencyMs, 90) / 1000.0,
+        percentile(result.latencyMs, 99) / 1000.0,
+        unsigned(result.nUplinks),
+        result.airtimeMs / 1000.0,
+        result.airtimeMs * 100.0 / kDayMs
+        );
+    }
+
+} // namespace
+
+int main()
+    {
+    static const Link kLinks[] =
+        {
+        { "fast data rate", 9, 72 },
+        { "slow data rate", 3, 370 },
+        };
+    auto const events = makeEvents();
+
+    std::printf(
+        "a day of 10-minute bouts, one an hour, %u events; mean gap %u s\n",
+        unsigned(events.size()), unsigned(kMeanGapMs / 1000)
+        );
+
+    for (auto const &link : kLinks)
+        {
+        std::printf(
+            "%s: %u events per uplink, %u ms each\n",
+            link.pName, unsigned(link.nPerUplink), unsigned(link.airtimeMs)
+            );
+        report("fixed 3 min", runFixed(events, link));
+        report("scheduler", runScheduler(events, link));
+        }
+
+    return 0;
+    }
@@ -0,0 +1,311 @@
+/*
+
+Module: test_Fed3Batch.cpp
+
+Function:
+    Host test of the format 0x25 record encoders: full, delta and
+    varint delta records, including fields that wrap.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_Fed3Event.h"
+#include "Catena4610_cFed3TrafficGen.h"
+
+#include "HostTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+/*
+
+The decoders are JavaScript, so the round trip is finished by
+check_Fed3Batch.js. This program checks what it can in C++, then
+writes one JSON line per batch to the file named on the command line:
+
+    { "name": ..., "batch": [ bytes ], "raw": [ { field: value, ... } ] }
+
+batch is the FED3 field of a format 0x25 message (the record count,
+then the tagged records); raw is what each record must decode to.
+
+*/
+
+namespace {
+
+enum class Mode
+    {
+    Full,       // tag 0 only
+    Delta,      // tag 1 where it fits, else tag 0
+    Varint,     // tag 2
+    Mixed,      // a full keyframe every third record, delta and varint between
+    };
+
+const char * const kModeNames[] = { "full", "delta", "varint", "mixed" };
+
+using Events = std::vector<Fed3Event>;
+using Bytes = std::vector<std::uint8_t>;
+
+// a FED3 event, from frame i of a synthetic run.
+Fed3Event makeEvent(std::uint32_t i)
+    {
+    std::uint8_t frame[cFed3TrafficGen::kFrameSize];
+    Fed3Event event;
+
+    cFed3TrafficGen::buildFrame(i, frame);
+    event.decode(frame + cFed3Receiver::kHeaderSize, Fed3Event::kWireSize);
+    return event;
+    }
+
+// build the batch field, the way fillTxBuffer() lays it out.
+Bytes encodeBatch(const Events &events, Mode mode)
+    {
+    Bytes batch;
+
+    batch.push_back(std::uint8_t(events.size()));
+
+    for (std::size_t i = 0; i < events.size(); ++i)
+        {
+        std::uint8_t buf[1 + Fed3Event::kMaxVarintSize];
+        std::size_t n = 0;
+        bool const fKey = i == 0 || mode == Mode::Full || (mode == Mode::Mixed && i % 3 == 0);
+        bool const fVarint = mode == Mode::Varint || (mode == Mode::Mixed && i % 3 == 2);
+
+        if (! fKey && fVarint)
+            {
+            buf[0] = 2;
+            n = 1 + events[i].encodeVarintDelta(events[i - 1], buf + 1);
+            CHECK(n - 1 <= Fed3Event::kMaxVarintSize);
+            }
+        else if (! fKey && events[i].encodeDelta(events[i - 1], buf + 1))
+            {
+            buf[0] = 1;
+            n = 1 + Fed3Event::kDeltaSize;
+            }
+        else
+            {
+            buf[0] = 0;
+            events[i].encode(buf + 1);
+            n = 1 + Fed3Event::kWireSize;
+            }
+
+        batch.insert(batch.end(), buf, buf + n);
+        }
+
+    return batch;
+    }
+
+void writeCase(std::FILE *pFile, const char *pName, Mode mode, const Events &events)
+    {
+    if (pFile == nullptr)
+        return;
+
+    Bytes const batch = encodeBatch(events, mode);
+
+    std::fprintf(pFile, "{\"name\":\"%s/%s\",\"batch\":[", pName, kModeNames[unsigned(mode)]);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        std::fprintf(pFile, "%s%u", i == 0 ? "" : ",", batch[i]);
+    std::fprintf(pFile, "],\"raw\":[");
+
+    for (std::size_t i = 0; i < events.size(); ++i)
+        {
+        std::fprintf(pFile, "%s{", i == 0 ? "" : ",");
+        for (auto const &l : Fed3Layout::kLayout)
+            {
+            auto const &f = MessageSchema::kFed3Fields[unsigned(l.field)];
+            std::uint32_t const v = events[i].getField(l.field);
+
+            std::fprintf(pFile, "%s\"%s\":", l.field == Fed3Field::TimeStamp ? "" : ",", f.pName);
+            if (f.type == MessageSchema::Type::Int16)
+                std::fprintf(pFile, "%d", int(std::int16_t(v)));
+            else
+                std::fprintf(pFile, "%lu", (unsigned long) v);
+            }
+        std::fprintf(pFile, "}");
+        }
+
+    std::fprintf(pFile, "]}\n");
+    }
+
+void writeCases(std::FILE *pFile, const char *pName, const Events &events)
+    {
+    for (auto mode : { Mode::Full, Mode::Delta, Mode::Varint, Mode::Mixed })
+        writeCase(pFile, pName, mode, events);
+    }
+
+// a full record encodes and decodes to itself.
+void testFullRecord()
+    {
+    Fed3Event event = makeEvent(7);
+    Fed3Event decoded;
+    std::uint8_t buf[Fed3Event::kWireSize];
+
+    event.Vbat = -2;
+    event.BlockPelletCount = -32768;
+    event.encode(buf);
+    std::memset(&decoded, 0xA5, sizeof(decoded));
+    CHECK(decoded.decode(buf, sizeof(buf)));
+
+    for (auto const &l : Fed3Layout::kLayout)
+        CHECK_EQ(decoded.getField(l.field), event.getField(l.field));
+    }
+
+// steady traffic: every record fits a delta.
+Events makePokes()
+    {
+    Events events;
+
+    for (std::uint32_t i = 0; i < 12; ++i)
+        events.push_back(makeEvent(i));
+
+    for (std::size_t i = 1; i < events.size(); ++i)
+        {
+        std::uint8_t buf[Fed3Event::kDeltaSize];
+        CHECK(events[i].encodeDelta(events[i - 1], buf));
+        }
+
+    return events;
+    }
+
+// unsigned counters and the timestamp wrap through zero.
+Events makeCounterWrap()
+    {
+    Events events;
+    Fed3Event event = makeEvent(0);
+
+    event.TimeStamp = 0xFFFFFFF0;
+    event.LeftCount = 0xFFFFFFFE;
+    event.RightCount = 0xFFFFFFFF;
+    event.PelletCount = 0xFFFFFF80;
+    event.NumMotorTurns = 0xFFFFFFFF;
+    event.EventTime = 0xFFFF;
+
+    for (unsigned i = 0; i < 5; ++i)
+        {
+        events.push_back(event);
+        event.TimeStamp += 7;
+        event.LeftCount += 1;
+        event.RightCount += 2;
+        event.PelletCount += 0x40;
+        event.NumMotorTurns += 3;
+        event.EventTime = std::uint16_t(event.EventTime + 0x8000);
+        }
+
+    return events;
+    }
+
+// signed fields wrap modulo their width: the varint delta is the
+// short way round, and must decode to the value, not past it.
+Events makeSignedWrap()
+    {
+    Events events;
+    Fed3Event event = makeEvent(0);
+    static const std::int16_t kValues[][3] =
+        {
+        // Vbat, FixedRatio, BlockPelletCount
+        {  32767,      -1,  -32768 },
+        { -32768,       0,   32767 },
+        {  32767,  -32768,  -32768 },
+        {     -1,   32767,      -1 },
+        {      0,      -1,       0 },
+        { -32768,       1,   32767 },
+        };
+
+    for (auto const &v : kValues)
+        {
+        event.Vbat = v[0];
+        event.FixedRatio = v[1];
+        event.BlockPelletCount = v[2];
+        event.TimeStamp += 1;
+        events.push_back(event);
+        }
+
+    // from 32767 to -32768 is a step of +1 modulo 2^16: one byte, as
+    // are the other three changes; the map takes three.
+    std::uint8_t buf[Fed3Event::kMaxVarintSize];
+    CHECK_EQ(events[1].encodeVarintDelta(events[0], buf), 3u + 4u);
+
+    // and too far for a delta record's int8.
+    CHECK(! events[1].encodeDelta(events[0], buf));
+    return events;
+    }
+
+// changes a delta record can't carry: backwards steps, big jumps,
+// and a different device, session, version or ratio.
+Events makeIrregular()
+    {
+    Events events;
+    Fed3Event event = makeEvent(3);
+    std::uint8_t buf[Fed3Event::kMaxVarintSize];
+
+    events.push_back(event);
+
+    event.TimeStamp -= 100;         // clock set back
+    events.push_back(event);
+
+    event.LeftCount = 0;            // FED3 reset
+    event.RightCount = 0;
+    event.PelletCount = 0;
+    event.NumMotorTurns = 0;
+    events.push_back(event);
+
+    event.DeviceNumber = 0xFFFF;
+    event.SessionType = 13;
+    event.VersionMajor = 255;
+    event.VersionMinor = 0;
+    event.VersionLocal = 128;
+    event.FixedRatio = 5;
+    events.push_back(event);
+
+    event.TimeStamp += 70000;       // too far for a delta's uint16
+    event.Vbat += 200;
+    events.push_back(event);
+
+    // every field different, each by a lot.
+    for (auto const &l : Fed3Layout::kLayout)
+        event.setField(l.field, event.getField(l.field) ^ 0x5AA5A55A);
+    events.push_back(event);
+
+    for (std::size_t i = 1; i < events.size(); ++i)
+        CHECK(! events[i].encodeDelta(events[i - 1], buf));
+
+    CHECK(events[5].encodeVarintDelta(events[4], buf) <= Fed3Event::kMaxVarintSize);
+    return events;
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+    {
+    std::FILE *pFile = nullptr;
+
+    if (argc > 1)
+        {
+        pFile = std::fopen(argv[1], "w");
+        if (pFile == nullptr)
+            {
+            std::perror(argv[1]);
+            return 1;
+            }
+        }
+
+    testFullRecord();
+    writeCases(pFile, "pokes", makePokes());
+    writeCases(pFile, "counter-wrap", makeCounterWrap());
+    writeCases(pFile, "signed-wrap", makeSignedWrap());
+    writeCases(pFile, "irregular", makeIrregular());
+
+    if (pFile != nullptr)
+        std::fclose(pFile);
+
+    return HostTest::report("test_Fed3Batch");
+    }
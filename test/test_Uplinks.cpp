@@ -0,0 +1,407 @@
+/*
+
+Module: test_Uplinks.cpp
+
+Function:
+    Host conformance test of the uplink encoder against the generated
+    decoders: the loop's own uplinks, and what they must decode to.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_FED3.h"
+#include "Catena4610_cFed3TrafficGen.h"
+
+#include "HostTest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+HOST_TEST_MAIN;
+
+// as in Catena4610_FED3.ino.
+cMeasurementLoop gMeasurementLoop;
+
+/*
+
+The decoders are JavaScript, so the comparison is finished by
+check_Uplinks.js. The loop is run on the host, as in
+test_cMeasurementLoop, with the sensor stand-ins set to known values,
+in each of its uplink formats. This program writes one JSON line per
+uplink to the file named on the command line:
+
+    { "name": ..., "ports": [ ... ], "bytes": [ ... ],
+      "fields": { name: [ value, tolerance ], ... },
+      "fed3": [ { field: value, ... } ],
+      "summary": [ { field: value, ... } ] }
+
+ports are the ports whose decoders must take it. fields holds the
+values the sensors were set to, for each field the flags select,
+named as in MessageSchema::kMessageFields; the tolerance allows for
+the scaling. fed3 and summary are the raw records the FED3 data must
+decode to, named as in kFed3Fields and kFed3SummaryFields. Nothing
+here is taken from the uplink itself.
+
+*/
+
+namespace {
+
+using Flags = cMeasurementLoop::Flags;
+using MessageSchema::Field;
+using MessageSchema::Type;
+
+constexpr std::size_t kFrameSize = cFed3TrafficGen::kFrameSize;
+
+// what the sensors read.
+struct Env
+    {
+    float           Vbat;
+    float           Vbus;
+    float           Temperature;    // degrees C
+    float           Pressure;       // Pa
+    float           Humidity;       // %RH
+    std::uint32_t   White;
+    };
+
+const Env kEnvs[] =
+    {
+    { 3.7f,  0.0f,  21.5f,   101325.0f, 45.0f,  1000 },
+    { 4.2f,  5.1f,  -12.25f, 87000.0f,  0.0f,   0 },
+    { 2.9f,  4.95f, 38.0f,   108000.0f, 100.0f, 123456 },
+    };
+
+std::FILE *gpFile;
+std::uint32_t gNextFrame;
+std::size_t gNextUplink;
+
+void run(std::uint32_t ms)
+    {
+    for (std::uint32_t i = 0; i < ms; ++i)
+        {
+        HostClock::advanceMillis(1);
+        gCatena.poll();
+        }
+    }
+
+void setEnv(const Env &env)
+    {
+    gCatena.setSupply(env.Vbat, env.Vbus);
+    // no smoothing from the old values.
+    gMeasurementLoop.getSupplySampler().invalidate();
+    Adafruit_BME280::setValue({ env.Temperature, env.Pressure, env.Humidity });
+    Catena_Si1133::setValue(env.White);
+    }
+
+Fed3Event makeEvent(std::uint32_t i)
+    {
+    std::uint8_t frame[kFrameSize];
+    Fed3Event event;
+
+    cFed3TrafficGen::buildFrame(i, frame);
+    event.decode(frame + cFed3Receiver::kHeaderSize, Fed3Event::kWireSize);
+    return event;
+    }
+
+// put the next n frames on Serial1, back to back; return their events.
+std::vector<Fed3Event> sendFrames(std::uint32_t n)
+    {
+    std::vector<Fed3Event> events;
+
+    for (; n != 0; --n, ++gNextFrame)
+        {
+        std::uint8_t frame[kFrameSize];
+
+        cFed3TrafficGen::buildFrame(gNextFrame, frame);
+        Serial1.send(frame, kFrameSize, HostClock::getMicros64());
+        events.push_back(makeEvent(gNextFrame));
+        }
+
+    return events;
+    }
+
+// run until the uplink after the last one taken has completed, or for
+// at most msMax; false if there isn't one. Uplinks can follow each
+// other closely, so the next may already have started.
+bool nextUplink(std::uint32_t msMax, Catena::LoRaWAN::Uplink &uplink)
+    {
+    for (std::uint32_t i = 0; gLoRaWAN.getUplinks().size() <= gNextUplink; ++i)
+        {
+        if (i == msMax)
+            return false;
+        run(1);
+        }
+
+    uplink = gLoRaWAN.getUplinks()[gNextUplink++];
+
+    // let it complete.
+    std::int32_t const msLeft = std::int32_t(uplink.tSend + 2000 - millis());
+    if (msLeft > 0)
+        run(std::uint32_t(msLeft));
+
+    return true;
+    }
+
+// only uplinks from now on.
+void skipUplinks()
+    {
+    gNextUplink = gLoRaWAN.getUplinks().size();
+    }
+
+// the value a field was set to, in the schema's units.
+double fieldValue(Field f, const Env &env)
+    {
+    switch (f)
+        {
+    case Field::Vbat:           return env.Vbat;
+    case Field::Vbus:           return env.Vbus;
+    // gCatena says this is the first boot.
+    case Field::BootCount:      return 1;
+    case Field::Temperature:    return env.Temperature;
+    case Field::Pressure:       return env.Pressure / 100.0;
+    case Field::Humidity:       return env.Humidity;
+    case Field::Light:          return env.White;
+    default:                    return 0;
+        }
+    }
+
+// how far the decoded value may be from it.
+double fieldTolerance(const MessageSchema::MessageField &f, double v)
+    {
+    double const scale = double(f.scaleNum) / double(f.scaleDen);
+
+    // a 12-bit mantissa.
+    if (f.type == Type::Uflt16)
+        return v / 2048.0 + 1.0 / scale;
+    else
+        return 1.0 / scale;
+    }
+
+void putRecord(const char *pSep, const MessageSchema::RecordField &f, std::uint32_t v)
+    {
+    if (f.type == Type::Int16)
+        std::fprintf(gpFile, "%s\"%s\":%d", pSep, f.pName, int(std::int16_t(v)));
+    else
+        std::fprintf(gpFile, "%s\"%s\":%lu", pSep, f.pName, (unsigned long) v);
+    }
+
+// write an uplink, and what it must decode to.
+void writeCase(
+    const char *pName,
+    std::initializer_list<unsigned> ports,
+    const Catena::LoRaWAN::Uplink &u,
+    const Env &env,
+    const std::vector<Fed3Event> &events,
+    const Fed3Summary *pSummary
+    )
+    {
+    std::uint8_t const flags = u.data.size() >= 2 ? u.data[1] : 0;
+    const char *pSep = "";
+
+    if (gpFile == nullptr)
+        return;
+
+    std::fprintf(gpFile, "{\"name\":\"%s\",\"ports\":[", pName);
+    for (auto port : ports)
+        {
+        std::fprintf(gpFile, "%s%u", pSep, port);
+        pSep = ",";
+        }
+
+    std::fprintf(gpFile, "],\"bytes\":[");
+    for (std::size_t i = 0; i < u.data.size(); ++i)
+        std::fprintf(gpFile, "%s%u", i == 0 ? "" : ",", u.data[i]);
+
+    std::fprintf(gpFile, "],\"fields\":{");
+    pSep = "";
+    for (auto const &f : MessageSchema::kMessageFields)
+        {
+        if (f.type == Type::Fed3 || (flags & f.flag) == 0)
+            continue;
+
+        double const v = fieldValue(f.field, env);
+
+        std::fprintf(gpFile, "%s\"%s\":[%.9g,%.9g]", pSep, f.pName, v, fieldTolerance(f, v));
+        pSep = ",";
+        }
+
+    std::fprintf(gpFile, "},\"fed3\":[");
+    for (std::size_t i = 0; i < events.size(); ++i)
+        {
+        std::fprintf(gpFile, "%s{", i == 0 ? "" : ",");
+        for (auto const &l : Fed3Layout::kLayout)
+            putRecord(
+                l.field == Fed3Field::TimeStamp ? "" : ",",
+                MessageSchema::kFed3Fields[unsigned(l.field)],
+                events[i].getField(l.field)
+                );
+        std::fprintf(gpFile, "}");
+        }
+
+    std::fprintf(gpFile, "],\"summary\":[");
+    if (pSummary != nullptr)
+        {
+        std::fprintf(gpFile, "{");
+        for (unsigned i = 0; i < MessageSchema::kFed3SummaryFieldCount; ++i)
+            putRecord(
+                i == 0 ? "" : ",",
+                MessageSchema::kFed3SummaryFields[i],
+                pSummary->getField(Fed3SummaryField(i), u.tSend)
+                );
+        std::fprintf(gpFile, "}");
+        }
+
+    std::fprintf(gpFile, "]}\n");
+    }
+
+// every environmental field the sketch measures went.
+void checkEnvFlags(std::uint8_t flags)
+    {
+    constexpr std::uint8_t kFlagsEnv =
+        std::uint8_t(Flags::Vbat) | std::uint8_t(Flags::Vbus) |
+        std::uint8_t(Flags::TPH) | std::uint8_t(Flags::Light);
+
+    CHECK_EQ(flags & kFlagsEnv, kFlagsEnv);
+    }
+
+void setUp()
+    {
+    HostClock::setMicros64(1000000);
+    Serial1.begin(115200);
+    // the fastest EU868 data rate, so everything fits.
+    LMIC.datarate = 5;
+    gCatena.registerObject(&gLoRaWAN);
+    setEnv(kEnvs[0]);
+    gMeasurementLoop.begin();
+    // measure for every uplink, so each has the values just set.
+    gMeasurementLoop.setEnvFreshness(0);
+    gMeasurementLoop.requestActive(true);
+    }
+
+// the first uplink: no FED3 data.
+void testWarmup()
+    {
+    Catena::LoRaWAN::Uplink uplink;
+
+    if (! CHECK(nextUplink(10 * 1000, uplink)))
+        return;
+
+    CHECK_EQ(uplink.data[0], cMeasurementLoop::kMessageFormatBatch);
+    checkEnvFlags(uplink.data[1]);
+    writeCase("warmup", { 3 }, uplink, kEnvs[0], {}, nullptr);
+    }
+
+// format 0x25, compact and not; a pellet, so it goes at once.
+void testBatch(const Env &env, unsigned iEnv)
+    {
+    char name[40];
+
+    setEnv(env);
+    for (bool fCompact : { true, false })
+        {
+        gMeasurementLoop.setCompactEncoding(fCompact, fCompact ? cMeasurementLoop::kKeyframeIntervalDefault : 1);
+
+        // left, right, pellet.
+        skipUplinks();
+        auto const events = sendFrames(3);
+        Catena::LoRaWAN::Uplink uplink;
+
+        if (! CHECK(nextUplink(60 * 1000, uplink)))
+            return;
+
+        CHECK_EQ(uplink.data[0], cMeasurementLoop::kMessageFormatBatch);
+        checkEnvFlags(uplink.data[1]);
+        std::snprintf(name, sizeof(name), "batch-%s/%u", fCompact ? "compact" : "full", iEnv);
+        writeCase(name, { 3 }, uplink, env, events, nullptr);
+        }
+    }
+
+// format 0x24: one event per uplink, which both ports' decoders take.
+void testSingle(const Env &env, unsigned iEnv)
+    {
+    char name[40];
+
+    setEnv(env);
+    gMeasurementLoop.setBatchUplinks(false);
+
+    skipUplinks();
+    auto const events = sendFrames(3);
+
+    for (std::size_t i = 0; i < events.size(); ++i)
+        {
+        Catena::LoRaWAN::Uplink uplink;
+
+        if (! CHECK(nextUplink(10 * 60 * 1000, uplink)))
+            break;
+
+        CHECK_EQ(uplink.data[0], cMeasurementLoop::kMessageFormat);
+        checkEnvFlags(uplink.data[1]);
+        std::snprintf(name, sizeof(name), "single-%u/%u", unsigned(i), iEnv);
+        writeCase(name, { 2, 3 }, uplink, env, { events[i] }, nullptr);
+        }
+
+    gMeasurementLoop.setBatchUplinks(true);
+    }
+
+// format 0x26: the totals of the events sent during the window.
+void testSummary(const Env &env)
+    {
+    auto settings = gMeasurementLoop.getSettings();
+    Fed3Summary summary;
+
+    setEnv(env);
+    settings.fSummaryMode = true;
+    settings.summaryWindowSec = cMeasurementLoop::kSummaryWindowSecMin;
+    CHECK(gMeasurementLoop.applySettings(settings));
+    summary.begin(millis());
+    skipUplinks();
+
+    for (unsigned i = 0; i < 4; ++i)
+        {
+        for (auto const &event : sendFrames(3))
+            summary.add(event);
+        run(5 * 1000);
+        }
+
+    Catena::LoRaWAN::Uplink uplink;
+
+    if (CHECK(nextUplink(2 * 60 * 1000, uplink)))
+        {
+        CHECK_EQ(uplink.data[0], cMeasurementLoop::kMessageFormatSummary);
+        checkEnvFlags(uplink.data[1]);
+        CHECK(uplink.data[1] & std::uint8_t(Flags::FED3));
+        writeCase("summary", { 3 }, uplink, env, {}, &summary);
+        }
+
+    settings.fSummaryMode = false;
+    CHECK(gMeasurementLoop.applySettings(settings));
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+    {
+    gpFile = argc > 1 ? std::fopen(argv[1], "w") : nullptr;
+
+    setUp();
+    testWarmup();
+    for (unsigned i = 0; i < sizeof(kEnvs) / sizeof(kEnvs[0]); ++i)
+        {
+        testBatch(kEnvs[i], i);
+        testSingle(kEnvs[i], i);
+        }
+    testSummary(kEnvs[2]);
+
+    if (gpFile != nullptr)
+        std::fclose(gpFile);
+
+    return HostTest::report("test_Uplinks");
+    }
@@ -0,0 +1,78 @@
+/*
+
+Module: test_cCrc16Modbus.cpp
+
+Function:
+    Host test: the three CRC-16/MODBUS methods agree.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cCrc16Modbus.h"
+
+#include "HostTest.h"
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+namespace {
+
+// every method, from every CRC state, for every byte.
+void testAllStates()
+    {
+    unsigned nDiffer = 0;
+
+    for (std::uint32_t crc = 0; crc <= 0xFFFF; ++crc)
+        {
+        for (unsigned b = 0; b <= 0xFF; ++b)
+            {
+            std::uint16_t const bitwise = cCrc16Modbus::updateBitwise(std::uint16_t(crc), std::uint8_t(b));
+
+            if (cCrc16Modbus::updateNibble(std::uint16_t(crc), std::uint8_t(b)) != bitwise ||
+                cCrc16Modbus::updateTable(std::uint16_t(crc), std::uint8_t(b)) != bitwise)
+                ++nDiffer;
+            }
+        }
+
+    CHECK_EQ(nDiffer, 0u);
+    }
+
+// the standard check value, and the zero residue of a frame followed
+// by its CRC.
+void testCheckValue()
+    {
+    static const std::uint8_t kCheck[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    std::uint8_t frame[sizeof(kCheck) + 2];
+
+    CHECK_EQ(cCrc16Modbus::compute(kCheck, sizeof(kCheck)), 0x4B37);
+
+    for (unsigned i = 0; i < sizeof(kCheck); ++i)
+        frame[i] = kCheck[i];
+    frame[sizeof(kCheck)] = 0x37;
+    frame[sizeof(kCheck) + 1] = 0x4B;
+
+    cCrc16Modbus crc;
+    for (auto b : frame)
+        crc.update(b);
+    CHECK(crc.isResidueGood());
+
+    crc.begin();
+    frame[3] ^= 1;
+    crc.update(frame, sizeof(frame));
+    CHECK(! crc.isResidueGood());
+    }
+
+} // namespace
+
+int main()
+    {
+    testAllStates();
+    testCheckValue();
+    return HostTest::report("test_cCrc16Modbus");
+    }
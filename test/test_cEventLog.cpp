@@ -0,0 +1,352 @@
+/*
+
+Module: test_cEventLog.cpp
+
+Function:
+    Host test of cEventLog against the RAM stand-ins for the flash
+    and FRAM: wrap, recovery after a reset, and flash failures.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cEventLog.h"
+
+#include "HostTest.h"
+
+#include <cstring>
+#include <memory>
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+namespace {
+
+// two sectors: the smallest log, so it wraps quickly.
+using Flash = cEventLogFlashRam<2 * cEventLogFlash::kSectorSize>;
+
+constexpr std::uint32_t kSlots = 2 * cEventLog::kRecordsPerSector;
+
+// the event stored as seq, so reads can be checked.
+Fed3Event makeEvent(std::uint32_t seq)
+    {
+    Fed3Event event;
+
+    std::memset(&event, 0, sizeof(event));
+    event.TimeStamp = 1000000 + seq;
+    event.DeviceNumber = 1;
+    event.LeftCount = seq * 3;
+    event.PelletCount = seq;
+    event.EventActive = std::uint8_t(1 + seq % 11);
+    return event;
+    }
+
+bool isEvent(const Fed3Event &event, std::uint32_t seq)
+    {
+    Fed3Event const expect = makeEvent(seq);
+
+    return std::memcmp(&event, &expect, sizeof(event)) == 0;
+    }
+
+// an index that can forget its last save, as if power was lost just
+// before it.
+class cLossyIndex : public cEventLogIndex
+    {
+public:
+    virtual bool load(std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        return this->m_current.load(pBuffer, nBuffer);
+        }
+    virtual bool save(const std::uint8_t *pBuffer, std::size_t nBuffer) override
+        {
+        this->m_previous = this->m_current;
+        return this->m_current.save(pBuffer, nBuffer);
+        }
+
+    void loseLastSave()
+        {
+        this->m_current = this->m_previous;
+        }
+
+private:
+    cEventLogIndexRam   m_current;
+    cEventLogIndexRam   m_previous;
+    };
+
+// the flash and FRAM outlive the log, as they do a reset.
+struct Rig
+    {
+    std::unique_ptr<Flash>      pFlash { new Flash };
+    cLossyIndex                 index;
+    std::unique_ptr<cEventLog>  pLog;
+
+    Rig()
+        {
+        this->boot();
+        }
+
+    // a reset: whatever was only in RAM is lost.
+    bool boot()
+        {
+        this->pLog.reset(new cEventLog);
+        return this->pLog->begin(this->pFlash.get(), &this->index);
+        }
+
+    cEventLog &log()
+        {
+        return *this->pLog;
+        }
+
+    void append(std::uint32_t n)
+        {
+        for (std::uint32_t i = 0; i < n; ++i)
+            CHECK(this->log().append(makeEvent(this->log().getEnd())));
+        }
+
+    // append n events and consume them, except for keep.
+    void appendConsume(std::uint32_t n, std::uint32_t keep = ~0u)
+        {
+        for (std::uint32_t i = 0; i < n; ++i)
+            {
+            std::uint32_t const seq = this->log().getEnd();
+
+            CHECK(this->log().append(makeEvent(seq)));
+            if (seq != keep)
+                CHECK(this->log().consume(seq));
+            }
+        }
+
+    // every event still in the log reads back as itself.
+    bool checkContents()
+        {
+        bool fOk = true;
+
+        for (std::uint32_t seq = this->log().getFirst(); seq != this->log().getEnd(); ++seq)
+            {
+            Fed3Event event;
+            auto const status = this->log().read(seq, event);
+
+            if (status == cEventLog::ReadStatus::Ok)
+                fOk = CHECK(isEvent(event, seq)) && fOk;
+            else
+                fOk = CHECK(status == cEventLog::ReadStatus::Consumed) && fOk;
+            }
+
+        return fOk;
+        }
+    };
+
+// after a lap and a half, with one event of the old lap kept, a reset
+// must not walk the head over the stale records past it.
+void testRebootWithOldUnconsumed()
+    {
+    Rig rig;
+
+    rig.appendConsume(288, 150);
+    CHECK(rig.log().flush());
+    CHECK_EQ(rig.log().getEnd(), 288u);
+    CHECK_EQ(rig.log().size(), 1u);
+
+    CHECK(rig.boot());
+    CHECK_EQ(rig.log().getEnd(), 288u);
+    CHECK_EQ(rig.log().size(), 1u);
+
+    Fed3Event event;
+    CHECK(rig.log().read(150, event) == cEventLog::ReadStatus::Ok);
+    CHECK(isEvent(event, 150));
+
+    // the next sector is erased for these, which drops event 150.
+    rig.append(10);
+    CHECK(rig.log().flush());
+    for (std::uint32_t seq = 288; seq < 298; ++seq)
+        {
+        CHECK(rig.log().read(seq, event) == cEventLog::ReadStatus::Ok);
+        CHECK(isEvent(event, seq));
+        }
+    CHECK_EQ(rig.log().getDropCount(), 1u);
+    CHECK_EQ(rig.log().getCorruptCount(), 0u);
+    CHECK_EQ(rig.log().size(), 10u);
+    }
+
+// the same, with everything consumed.
+void testRebootAllConsumed()
+    {
+    Rig rig;
+
+    rig.appendConsume(288);
+    CHECK(rig.log().flush());
+
+    CHECK(rig.boot());
+    CHECK_EQ(rig.log().getEnd(), 288u);
+    CHECK(rig.log().empty());
+
+    rig.append(10);
+    CHECK(rig.log().flush());
+    CHECK_EQ(rig.log().size(), 10u);
+    CHECK(rig.checkContents());
+    CHECK_EQ(rig.log().getCorruptCount(), 0u);
+    }
+
+// reset with the head on each sector boundary, over several laps.
+void testRebootAtSectorBoundary()
+    {
+    Rig rig;
+
+    for (unsigned i = 0; i < 8; ++i)
+        {
+        rig.appendConsume(cEventLog::kRecordsPerSector - 3);
+        rig.append(3);
+        CHECK(rig.log().flush());
+        CHECK_EQ(rig.log().getEnd() % cEventLog::kRecordsPerSector, 0u);
+
+        std::uint32_t const end = rig.log().getEnd();
+        std::uint32_t const first = rig.log().getFirst();
+        std::uint32_t const size = rig.log().size();
+
+        CHECK(rig.boot());
+        CHECK_EQ(rig.log().getEnd(), end);
+        CHECK_EQ(rig.log().getFirst(), first);
+        CHECK_EQ(rig.log().size(), size);
+        CHECK(rig.checkContents());
+        }
+
+    CHECK_EQ(rig.log().getCorruptCount(), 0u);
+    }
+
+// power lost after a page was programmed but before the index was
+// saved: the head is recovered from the flash, on any lap.
+void testRecoverUnsavedHead()
+    {
+    Rig rig;
+
+    for (unsigned i = 0; i < 3 * kSlots / cEventLog::kRecordsPerPage; ++i)
+        {
+        // the page is programmed when its last record is appended.
+        rig.appendConsume(cEventLog::kRecordsPerPage - 1);
+        rig.append(1);
+        CHECK_EQ(rig.log().getPending(), 0u);
+
+        std::uint32_t const end = rig.log().getEnd();
+        std::uint32_t const size = rig.log().size();
+
+        rig.index.loseLastSave();
+        CHECK(rig.boot());
+        CHECK_EQ(rig.log().getEnd(), end);
+        CHECK_EQ(rig.log().size(), size);
+        CHECK(rig.checkContents());
+        }
+    }
+
+// a long run, with resets at odd places; events are consumed out of
+// order, and some are never consumed.
+void testWrapWithResets()
+    {
+    Rig rig;
+    std::uint32_t nReset = 0;
+
+    for (std::uint32_t i = 0; i < 40 * kSlots; ++i)
+        {
+        std::uint32_t const seq = rig.log().getEnd();
+
+        CHECK(rig.log().append(makeEvent(seq)));
+
+        // consume the one before this, most of the time.
+        if (seq > 0 && seq % 7 != 0 && rig.log().contains(seq - 1))
+            CHECK(rig.log().consume(seq - 1));
+
+        if (i % 61 == 60)
+            {
+            CHECK(rig.log().flush());
+
+            std::uint32_t const end = rig.log().getEnd();
+            std::uint32_t const size = rig.log().size();
+
+            CHECK(rig.boot());
+            CHECK_EQ(rig.log().getEnd(), end);
+            CHECK_EQ(rig.log().size(), size);
+            CHECK(rig.checkContents());
+            ++nReset;
+            }
+        }
+
+    CHECK(nReset > 100);
+    CHECK_EQ(rig.log().getCorruptCount(), 0u);
+    CHECK(rig.log().size() <= kSlots);
+    }
+
+// the flash fails as a page is completed: the event that completed
+// it isn't taken, nor is anything after it, until the flash recovers.
+void checkFlashFailure(Rig &rig, void (Flash::*pSetFails)(bool))
+    {
+    std::uint32_t const end = rig.log().getEnd() + cEventLog::kRecordsPerPage - 1;
+
+    rig.append(cEventLog::kRecordsPerPage - 1);
+    (rig.pFlash.get()->*pSetFails)(true);
+
+    for (unsigned i = 0; i < 3; ++i)
+        {
+        CHECK(! rig.log().append(makeEvent(end)));
+        CHECK_EQ(rig.log().getEnd(), end);
+        CHECK_EQ(rig.log().getPending(), cEventLog::kRecordsPerPage - 1);
+        }
+    CHECK(! rig.log().flush());
+    CHECK(rig.checkContents());
+
+    // the page is programmed once the flash works again.
+    (rig.pFlash.get()->*pSetFails)(false);
+    CHECK(rig.log().append(makeEvent(end)));
+    CHECK_EQ(rig.log().getPending(), 0u);
+    rig.append(2);
+    CHECK(rig.log().flush());
+
+    std::uint32_t const size = rig.log().size();
+
+    CHECK(rig.boot());
+    CHECK_EQ(rig.log().getEnd(), end + 3);
+    CHECK_EQ(rig.log().size(), size);
+    CHECK(rig.checkContents());
+    CHECK_EQ(rig.log().getCorruptCount(), 0u);
+    }
+
+void testProgramFailure()
+    {
+    Rig rig;
+
+    rig.appendConsume(2 * cEventLog::kRecordsPerPage);
+    checkFlashFailure(rig, &Flash::setProgramFails);
+    }
+
+// the erase is done as the first page of a sector is programmed; on
+// the second lap, it drops the oldest sector.
+void testEraseFailure()
+    {
+    Rig rig;
+
+    checkFlashFailure(rig, &Flash::setEraseFails);
+
+    rig.append(kSlots - rig.log().getEnd());
+    CHECK(rig.log().flush());
+    checkFlashFailure(rig, &Flash::setEraseFails);
+    // the first sector's events were dropped, once, for the second lap.
+    CHECK_EQ(rig.log().getFirst(), cEventLog::kRecordsPerSector);
+    CHECK_EQ(rig.log().size(), kSlots - cEventLog::kRecordsPerSector + 8);
+    }
+
+} // namespace
+
+int main()
+    {
+    testRebootWithOldUnconsumed();
+    testRebootAllConsumed();
+    testRebootAtSectorBoundary();
+    testRecoverUnsavedHead();
+    testWrapWithResets();
+    testProgramFailure();
+    testEraseFailure();
+    return HostTest::report("test_cEventLog");
+    }
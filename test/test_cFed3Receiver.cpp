@@ -0,0 +1,341 @@
+/*
+
+Module: test_cFed3Receiver.cpp
+
+Function:
+    Host test of cFed3Receiver framing, fed from the Serial1 stand-in.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cFed3Receiver.h"
+#include "Catena4610_cFed3TrafficGen.h"
+
+#include "HostClock.h"
+#include "HostSerial.h"
+#include "HostTest.h"
+
+#include <cstring>
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+namespace {
+
+constexpr std::size_t kFrameSize = cFed3TrafficGen::kFrameSize;
+
+struct Frame
+    {
+    std::uint8_t    data[cFed3Receiver::kMaxFrame];
+    std::uint8_t    n;
+    bool            fCrcGood;
+    };
+
+// the test rig: a receiver, the Serial1 stand-in, the traffic
+// generator, and a count of the times the clock was read.
+struct Rig
+    {
+    cFed3Receiver   rx;
+    cHostSerial     serial;
+    cFed3TrafficGen gen;
+    unsigned        nClock = 0;
+
+    Rig()
+        {
+        HostClock::setMicros64(1000000);
+        this->rx.begin();
+        }
+
+    // drain the UART, and the generator, into the receiver.
+    void pump()
+        {
+        auto const clock =
+            [this]()
+                {
+                ++this->nClock;
+                return HostClock::millis();
+                };
+
+        this->rx.pump(this->serial, clock);
+        this->rx.pump(this->gen, clock);
+        }
+
+    // what the loop does each time round: drain the UART, then take
+    // any frames.
+    unsigned poll(Frame *pFrames, unsigned nFrames)
+        {
+        unsigned n = 0;
+
+        this->pump();
+
+        while (this->rx.isFrameReady(HostClock::millis()))
+            {
+            Frame f;
+            bool fOverflow;
+
+            this->rx.readFrame(f.data, sizeof(f.data), f.n, fOverflow);
+            f.fCrcGood = this->rx.isLastFrameCrcGood();
+            if (n < nFrames)
+                pFrames[n] = f;
+            ++n;
+            }
+
+        return n;
+        }
+
+    // run the loop every stepUs until tEndUs; collect the frames.
+    unsigned run(std::uint64_t tEndUs, std::uint32_t stepUs, Frame *pFrames, unsigned nFrames)
+        {
+        unsigned n = 0;
+
+        while (HostClock::getMicros64() < tEndUs)
+            {
+            HostClock::advanceMicros(stepUs);
+            n += this->poll(pFrames + (n < nFrames ? n : nFrames), n < nFrames ? nFrames - n : 0);
+            }
+
+        return n;
+        }
+    };
+
+bool isFrame(const Frame &f, std::uint32_t i)
+    {
+    std::uint8_t expect[kFrameSize];
+
+    cFed3TrafficGen::buildFrame(i, expect);
+    return f.n == kFrameSize && f.fCrcGood && std::memcmp(f.data, expect, kFrameSize) == 0;
+    }
+
+// frames sent back to back are split by the byte count, however late
+// the loop gets round to framing them.
+void testBackToBackLateFraming()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[4];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    rig.serial.send(buf, kFrameSize, HostClock::getMicros64());
+    cFed3TrafficGen::buildFrame(1, buf);
+    std::uint64_t const tEnd = rig.serial.send(buf, kFrameSize);
+
+    // the UART is drained as the bytes arrive, but nothing is framed
+    // until long after both.
+    while (HostClock::getMicros64() < tEnd)
+        {
+        HostClock::advanceMicros(1000);
+        rig.pump();
+        }
+
+    HostClock::advanceMicros(20000);
+    CHECK_EQ(rig.poll(frames, 4), 2u);
+    CHECK(isFrame(frames[0], 0));
+    CHECK(isFrame(frames[1], 1));
+    }
+
+// pump() reads the clock for every byte it takes.
+void testStampedAtReadTime()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[2];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    std::uint64_t const tEnd = rig.serial.send(buf, kFrameSize, HostClock::getMicros64());
+
+    CHECK_EQ(rig.run(tEnd + 1000, 100, frames, 2), 1u);
+    CHECK(isFrame(frames[0], 0));
+    CHECK_EQ(rig.nClock, unsigned(kFrameSize));
+    }
+
+// a frame cut short is ended by the silence after it, as long as the
+// loop runs during the silence; the next frame is unharmed.
+void testRuntThenFrame()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[4];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    rig.serial.send(buf, 10, HostClock::getMicros64());
+    cFed3TrafficGen::buildFrame(1, buf);
+    std::uint64_t const tEnd = rig.serial.send(buf, kFrameSize, HostClock::getMicros64() + 20000);
+
+    CHECK_EQ(rig.run(tEnd + 10000, 1000, frames, 4), 2u);
+    CHECK_EQ(frames[0].n, 10u);
+    CHECK(! frames[0].fCrcGood);
+    CHECK(isFrame(frames[1], 1));
+    }
+
+// a gap in the middle of a frame ends it there; what follows is taken
+// as the start of more frames, all of them bad.
+void testGapInFrame()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[8];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    rig.serial.send(buf, 20, HostClock::getMicros64());
+    std::uint64_t const tEnd = rig.serial.send(
+        buf + 20, kFrameSize - 20, HostClock::getMicros64() + 2000 + cFed3Receiver::kT35 * 1000
+        );
+
+    unsigned const n = rig.run(tEnd + 10000, 500, frames, 8);
+    unsigned nBytes = 0;
+
+    CHECK(n >= 2u && n <= 8u);
+    CHECK_EQ(frames[0].n, 20u);
+    for (unsigned i = 0; i < n && i < 8; ++i)
+        {
+        CHECK(! frames[i].fCrcGood);
+        nBytes += frames[i].n;
+        }
+    CHECK_EQ(nBytes, unsigned(kFrameSize));
+    }
+
+// if the loop misses the silence after a frame cut short, the gap
+// can't be seen: the short frame runs into the next one. The damage
+// must show up as a bad CRC, never as a good frame.
+void testRuntMissedByLatePoll()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[4];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    rig.serial.send(buf, 10, HostClock::getMicros64());
+    cFed3TrafficGen::buildFrame(1, buf);
+    std::uint64_t const tEnd = rig.serial.send(buf, kFrameSize, HostClock::getMicros64() + 20000);
+
+    HostClock::setMicros64(tEnd + 1000);
+    unsigned const n = rig.poll(frames, 4);
+    HostClock::advanceMicros(20000);
+    unsigned const nAll = n + rig.poll(frames + n, 4 - n);
+
+    CHECK(nAll >= 1u && nAll <= 4u);
+    for (unsigned i = 0; i < nAll && i < 4; ++i)
+        CHECK(! frames[i].fCrcGood);
+    }
+
+// the core's receive buffer overflows if the loop stalls for longer
+// than it takes to fill it; the stand-in loses bytes as the core does.
+void testCoreBufferOverrun()
+    {
+    Rig rig;
+    std::uint8_t buf[kFrameSize];
+    Frame frames[4];
+
+    cFed3TrafficGen::buildFrame(0, buf);
+    rig.serial.send(buf, kFrameSize, HostClock::getMicros64());
+    cFed3TrafficGen::buildFrame(1, buf);
+    std::uint64_t const tEnd = rig.serial.send(buf, kFrameSize);
+
+    HostClock::setMicros64(tEnd + 20000);
+    unsigned const n = rig.poll(frames, 4);
+
+    CHECK_EQ(rig.serial.getOverrunCount(), std::uint32_t(2 * kFrameSize - cHostSerial::kRxBufferSize));
+    CHECK(n >= 1u);
+    CHECK(isFrame(frames[0], 0));
+    }
+
+std::uint32_t genClock()
+    {
+    return HostClock::micros();
+    }
+
+// generated bursts go through pump() like any other bytes, and are
+// framed by the byte count.
+void testTrafficGenBursts()
+    {
+    Rig rig;
+    Frame frames[8];
+    cFed3TrafficGen::Config config;
+
+    config.nFrames = 6;
+    config.intervalMs = 100;
+    config.nBurst = 3;
+    config.corruptPercent = 0;
+    config.seed = 1;
+    rig.gen.begin(config, genClock);
+
+    CHECK_EQ(rig.run(HostClock::getMicros64() + 300000, 1000, frames, 8), 6u);
+    for (unsigned i = 0; i < 6; ++i)
+        CHECK(isFrame(frames[i], i));
+    CHECK_EQ(rig.gen.getBackToBackCount(), 4u);
+    CHECK_EQ(rig.gen.getOverrunCount(), 0u);
+    CHECK(! rig.gen.isActive());
+    }
+
+// a loop that's late reading the generator loses bytes, as it would
+// from the UART.
+void testTrafficGenLateReader()
+    {
+    Rig rig;
+    Frame frames[4];
+    cFed3TrafficGen::Config config;
+
+    config.nFrames = 3;
+    config.intervalMs = 1000;
+    config.nBurst = 3;
+    config.corruptPercent = 0;
+    config.seed = 1;
+    rig.gen.begin(config, genClock);
+
+    HostClock::advanceMicros(20000);
+    unsigned const n = rig.poll(frames, 4);
+
+    CHECK_EQ(rig.gen.getOverrunCount(), std::uint32_t(3 * kFrameSize - cFed3TrafficGen::kRxBufferSize));
+    CHECK(n >= 1u);
+    CHECK(isFrame(frames[0], 0));
+    }
+
+// a replay keeps the recorded timing: a gap after a frame cut short
+// ends it, and the frames either side are unharmed.
+void testReplay()
+    {
+    Rig rig;
+    Frame frames[4];
+    std::uint8_t data[3 * kFrameSize];
+    std::uint16_t delayMs[3 * kFrameSize] = {};
+    std::size_t n = 0;
+
+    n += cFed3TrafficGen::buildFrame(0, data + n);
+    // a runt, 20 ms later.
+    delayMs[n] = 20;
+    cFed3TrafficGen::buildFrame(1, data + n);
+    n += 10;
+    delayMs[n] = 20;
+    n += cFed3TrafficGen::buildFrame(2, data + n);
+
+    rig.gen.beginReplay(data, delayMs, n, genClock);
+
+    CHECK_EQ(rig.run(HostClock::getMicros64() + 100000, 1000, frames, 4), 3u);
+    CHECK(isFrame(frames[0], 0));
+    CHECK_EQ(frames[1].n, 10u);
+    CHECK(! frames[1].fCrcGood);
+    CHECK(isFrame(frames[2], 2));
+    CHECK_EQ(rig.gen.getByteCount(), std::uint32_t(n));
+    }
+
+} // namespace
+
+int main()
+    {
+    testBackToBackLateFraming();
+    testStampedAtReadTime();
+    testRuntThenFrame();
+    testGapInFrame();
+    testRuntMissedByLatePoll();
+    testCoreBufferOverrun();
+    testTrafficGenBursts();
+    testTrafficGenLateReader();
+    testReplay();
+    return HostTest::report("test_cFed3Receiver");
+    }
@@ -0,0 +1,377 @@
+/*
+
+Module: test_cMeasurementLoop.cpp
+
+Function:
+    Host test of the whole measurement loop: FED3 frames in on Serial1,
+    uplinks out through gLoRaWAN, on the virtual clock.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+Description:
+    The loop is built from the sketch's own sources, against the
+    stand-ins in host/, and set up as setup() does. The clock is then
+    stepped a millisecond at a time, with gCatena.poll() each step, so
+    fsmDispatch() runs just as it would on the board; nothing in the
+    loop is called directly.
+
+    With TEST_EVENT_LOG set to 0, the flash isn't registered, and
+    events are kept in RAM.
+
+    Run with -v to see the sketch's console output.
+
+*/
+
+#include "Catena4610_FED3.h"
+#include "Catena4610_cFed3TrafficGen.h"
+
+#include "HostTest.h"
+
+#include <cstring>
+#include <vector>
+
+#ifndef TEST_EVENT_LOG
+# define TEST_EVENT_LOG 1
+#endif
+
+using namespace McciCatena4610;
+using namespace McciCatena;
+
+HOST_TEST_MAIN;
+
+// as in Catena4610_FED3.ino.
+cMeasurementLoop gMeasurementLoop;
+
+namespace {
+
+using Flags = cMeasurementLoop::Flags;
+using BatchRecord = cMeasurementLoop::BatchRecord;
+
+constexpr std::size_t kFrameSize = cFed3TrafficGen::kFrameSize;
+constexpr std::uint8_t kFlagsEnv =
+    std::uint8_t(Flags::Vbat) | std::uint8_t(Flags::Vbus) | std::uint8_t(Flags::Boot) |
+    std::uint8_t(Flags::TPH) | std::uint8_t(Flags::Light);
+
+// an uplink, taken apart.
+struct Uplink
+    {
+    std::uint32_t               tSend;
+    bool                        fSuccess;
+    std::uint8_t                port;
+    std::uint8_t                format;
+    std::uint8_t                flags;
+    // the FED3 timestamps of the events it carried
+    std::vector<std::uint32_t>  events;
+    };
+
+// the events of successful uplinks, in the order sent.
+std::vector<std::uint32_t> gDelivered;
+
+// step the clock by 1 ms at a time, polling everything, for ms.
+void run(std::uint32_t ms)
+    {
+    for (std::uint32_t i = 0; i < ms; ++i)
+        {
+        HostClock::advanceMillis(1);
+        gCatena.poll();
+        }
+    }
+
+// put FED3 frames i..j-1 on Serial1, back to back. Returns the millis()
+// when the last byte has arrived.
+std::uint32_t sendFrames(std::uint32_t i, std::uint32_t j)
+    {
+    std::uint64_t t = 0;
+
+    for (; i < j; ++i)
+        {
+        std::uint8_t frame[kFrameSize];
+
+        cFed3TrafficGen::buildFrame(i, frame);
+        t = Serial1.send(frame, kFrameSize, HostClock::getMicros64());
+        }
+
+    return std::uint32_t(t / 1000);
+    }
+
+// check that a format 0x25 record is frame i's event, as it came in.
+bool isEvent(const std::uint8_t *pRecord, std::uint32_t i)
+    {
+    std::uint8_t frame[kFrameSize];
+
+    cFed3TrafficGen::buildFrame(i, frame);
+    return std::memcmp(pRecord, frame + cFed3Receiver::kHeaderSize, Fed3Event::kWireSize) == 0;
+    }
+
+Uplink parse(const Catena::LoRaWAN::Uplink &u)
+    {
+    Uplink result { u.tSend, u.fSuccess, u.port, 0, 0, {} };
+
+    if (! CHECK(u.data.size() >= 2))
+        return result;
+
+    result.format = u.data[0];
+    result.flags = u.data[1];
+
+    if (result.format != cMeasurementLoop::kMessageFormatBatch ||
+        (result.flags & std::uint8_t(Flags::FED3)) == 0)
+        return result;
+
+    // the loop is set to send every record in full.
+    std::size_t n = MessageSchema::messageSize(result.flags & ~std::uint8_t(Flags::FED3));
+    std::uint8_t const nRecords = u.data[n++];
+
+    for (std::uint8_t i = 0; i < nRecords; ++i)
+        {
+        if (! CHECK(n + 1 + Fed3Event::kWireSize <= u.data.size()) ||
+            ! CHECK_EQ(u.data[n], std::uint8_t(BatchRecord::Full)))
+            break;
+
+        Fed3Event event;
+
+        event.decode(&u.data[n + 1], Fed3Event::kWireSize);
+        CHECK(isEvent(&u.data[n + 1], event.TimeStamp));
+        result.events.push_back(event.TimeStamp);
+        n += 1 + Fed3Event::kWireSize;
+        }
+
+    CHECK_EQ(n, u.data.size());
+    return result;
+    }
+
+// the index of the first uplink not yet taken by nextUplink().
+std::size_t gNextUplink;
+
+// run until the next uplink completes, or for at most msMax; take it
+// apart. false if there wasn't one. Uplinks can follow each other
+// closely, so the next may already have started.
+bool nextUplink(std::uint32_t msMax, Uplink &uplink)
+    {
+    for (std::uint32_t i = 0; gLoRaWAN.getUplinks().size() <= gNextUplink; ++i)
+        {
+        if (i == msMax)
+            return false;
+        run(1);
+        }
+
+    std::size_t const iUplink = gNextUplink++;
+
+    // let it complete.
+    std::int32_t const msLeft = std::int32_t(gLoRaWAN.getUplinks()[iUplink].tSend + 2000 - millis());
+    if (msLeft > 0)
+        run(std::uint32_t(msLeft));
+
+    uplink = parse(gLoRaWAN.getUplinks()[iUplink]);
+    if (uplink.fSuccess)
+        gDelivered.insert(gDelivered.end(), uplink.events.begin(), uplink.events.end());
+    return true;
+    }
+
+// set up as setup() does, and go active.
+void testBoot()
+    {
+    Uplink uplink;
+
+    HostClock::setMicros64(1000000);
+    Serial1.begin(115200);
+
+    // the fastest EU868 data rate, so the air time budget isn't what's
+    // being tested.
+    LMIC.datarate = 5;
+
+#if TEST_EVENT_LOG
+    gMeasurementLoop.registerSecondSpi(&gSPI2);
+    gMeasurementLoop.registerFlash(&gFlash);
+#endif
+    gCatena.registerObject(&gLoRaWAN);
+    gMeasurementLoop.begin();
+    CHECK_EQ(gMeasurementLoop.getEventLog().isEnabled(), bool(TEST_EVENT_LOG));
+
+    // every record in full, so they can be checked here.
+    gMeasurementLoop.setCompactEncoding(false, 1);
+
+    std::uint32_t const tActive = millis();
+    gMeasurementLoop.requestActive(true);
+
+    // the first uplink follows the warmup, with no FED3 data.
+    CHECK(nextUplink(10 * 1000, uplink));
+    CHECK(uplink.tSend - tActive >= 5 * 1000);
+    CHECK(uplink.tSend - tActive < 6 * 1000);
+    CHECK(uplink.fSuccess);
+    CHECK_EQ(uplink.port, cMeasurementLoop::kUplinkPort);
+    CHECK_EQ(uplink.format, cMeasurementLoop::kMessageFormatBatch);
+    CHECK_EQ(uplink.flags, kFlagsEnv);
+    }
+
+// a pellet is high priority: it goes at once, with the pokes before it.
+void testPelletGoesAtOnce()
+    {
+    Uplink uplink;
+
+    // left, right, pellet.
+    std::uint32_t const tArrive = sendFrames(0, 3);
+
+    CHECK(nextUplink(60 * 1000, uplink));
+    CHECK(uplink.tSend - tArrive < 100);
+    CHECK(uplink.fSuccess);
+    CHECK_EQ(uplink.flags, kFlagsEnv | std::uint8_t(Flags::FED3));
+    CHECK((uplink.events == std::vector<std::uint32_t> { 0, 1, 2 }));
+    }
+
+// pokes are held for a while, to go together; a damaged frame is
+// counted, and not sent.
+void testPokesAreBatched()
+    {
+    Uplink uplink;
+    std::uint8_t frame[kFrameSize];
+
+    sendFrames(3, 4);
+    run(500);
+
+    cFed3TrafficGen::buildFrame(99, frame);
+    frame[kFrameSize / 2] ^= 0x40;
+    Serial1.send(frame, kFrameSize, HostClock::getMicros64());
+    run(500);
+
+    std::uint32_t const tArrive = sendFrames(4, 5);
+
+    CHECK(nextUplink(2 * 60 * 1000, uplink));
+    CHECK(uplink.tSend - tArrive >= 1000);
+    CHECK(uplink.tSend - tArrive <= cUplinkScheduler::Config().maxLatencyMs);
+    CHECK((uplink.events == std::vector<std::uint32_t> { 3, 4 }));
+    CHECK_EQ(gMeasurementLoop.getFed3DeviceStats(0).nCrcErrors, 1u);
+    }
+
+// an event whose uplink fails is backlogged, and backfilled once an
+// uplink gets through.
+void testFailedUplinkIsBackfilled()
+    {
+    Uplink uplink;
+
+    gLoRaWAN.setTxResult(false);
+    sendFrames(5, 6);
+
+    CHECK(nextUplink(60 * 1000, uplink));
+    CHECK(! uplink.fSuccess);
+    CHECK((uplink.events == std::vector<std::uint32_t> { 5 }));
+    CHECK_EQ(gMeasurementLoop.getUplinkFailures(), 1u);
+    CHECK(! gMeasurementLoop.isLinkUp());
+    CHECK_EQ(gMeasurementLoop.getBacklogDepth(), 1u);
+
+    // the next uplink is the heartbeat; then the backlog follows.
+    gLoRaWAN.setTxResult(true);
+    for (int i = 0; i < 4 && gMeasurementLoop.getBacklogDepth() != 0; ++i)
+        CHECK(nextUplink(10 * 60 * 1000, uplink));
+
+    CHECK(gMeasurementLoop.isLinkUp());
+    CHECK_EQ(gMeasurementLoop.getBacklogDepth(), 0u);
+    CHECK_EQ(gMeasurementLoop.getBackfillCount(), 1u);
+    }
+
+// at the slowest data rates, the optional environmental fields make
+// room for the first record.
+void testSlowDataRate()
+    {
+    Uplink uplink;
+    constexpr std::uint8_t kFlagsAlways =
+        std::uint8_t(Flags::Vbat) | std::uint8_t(Flags::Vbus);
+
+    LMIC.datarate = 0;
+    sendFrames(6, 7);
+
+    CHECK(nextUplink(10 * 60 * 1000, uplink));
+    CHECK(uplink.fSuccess);
+    CHECK_EQ(uplink.flags, kFlagsAlways | std::uint8_t(Flags::FED3));
+    CHECK((uplink.events == std::vector<std::uint32_t> { 6 }));
+    CHECK(gLoRaWAN.getUplinks().back().data.size() <= 51u);
+
+    LMIC.datarate = 5;
+    }
+
+// every event got through once, in order.
+void testAllDelivered()
+    {
+    std::vector<std::uint32_t> expect;
+
+    for (std::uint32_t i = 0; i < 7; ++i)
+        expect.push_back(i);
+
+    CHECK(gDelivered == expect);
+    CHECK_EQ(gMeasurementLoop.getFed3DeviceStats(0).nFrames, 7u);
+    CHECK_EQ(gMeasurementLoop.getQueuedEventCount(), 0u);
+    CHECK_EQ(gMeasurementLoop.getLiveDepth(), 0u);
+    CHECK_EQ(Serial1.getOverrunCount(), 0u);
+    }
+
+#if TEST_EVENT_LOG
+// run until frames i..j-1 have all been delivered.
+void deliverAll(std::uint32_t i, std::uint32_t j)
+    {
+    Uplink uplink;
+    std::vector<std::uint32_t> expect;
+
+    for (int n = 0; n < 8 && gDelivered.size() < j - i; ++n)
+        nextUplink(10 * 60 * 1000, uplink);
+
+    for (; i < j; ++i)
+        expect.push_back(i);
+    CHECK(gDelivered == expect);
+    }
+
+// while the flash is failing, the events the log can't take are kept
+// in RAM, and sent after those it took; none are lost. Once the flash
+// works again, they go back into the log.
+void testLogWriteFails()
+    {
+    auto const &log = gMeasurementLoop.getEventLog();
+
+    gDelivered.clear();
+    gFlash.setFailing(true);
+
+    // the page fills part way through, and can't be programmed.
+    std::uint32_t const tArrive = sendFrames(7, 17);
+
+    run(tArrive + 1 - millis());
+    CHECK_EQ(gMeasurementLoop.getLiveDepth(), 10u);
+    CHECK(log.size() < 10u);
+
+    deliverAll(7, 17);
+    CHECK_EQ(gMeasurementLoop.getLiveDepth(), 0u);
+    CHECK_EQ(gMeasurementLoop.getQueuedEventCount(), 0u);
+
+    gFlash.setFailing(false);
+    sendFrames(17, 20);
+    deliverAll(7, 20);
+
+    CHECK_EQ(gMeasurementLoop.getEventDropCount(), 0u);
+    CHECK_EQ(log.getDropCount(), 0u);
+    CHECK_EQ(log.getPending(), 0u);
+    CHECK(log.empty());
+    CHECK_EQ(gMeasurementLoop.getLiveDepth(), 0u);
+    CHECK_EQ(Serial1.getOverrunCount(), 0u);
+    }
+#endif
+
+} // namespace
+
+int main(int argc, char **argv)
+    {
+    gCatena.setEcho(argc > 1 && std::strcmp(argv[1], "-v") == 0);
+
+    testBoot();
+    testPelletGoesAtOnce();
+    testPokesAreBatched();
+    testFailedUplinkIsBackfilled();
+    testSlowDataRate();
+    testAllDelivered();
+#if TEST_EVENT_LOG
+    testLogWriteFails();
+    return HostTest::report("test_cMeasurementLoop");
+#else
+    return HostTest::report("test_cMeasurementLoop (no event log)");
+#endif
+    }
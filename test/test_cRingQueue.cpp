@@ -0,0 +1,142 @@
+/*
+
+Module: test_cRingQueue.cpp
+
+Function:
+    Host test of cRingQueue: what each overflow policy keeps when the
+    queue is pushed past its capacity, and how the losses are counted.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cRingQueue.h"
+
+#include "HostTest.h"
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+namespace {
+
+constexpr std::size_t kCapacity = 4;
+using Queue_t = cRingQueue<std::uint32_t, kCapacity>;
+
+// push 0 .. n-1; returns how many pushes said nothing was lost.
+unsigned pushCount(Queue_t &queue, std::uint32_t n)
+    {
+    unsigned nKept = 0;
+
+    for (std::uint32_t i = 0; i < n; ++i)
+        {
+        if (queue.push(i))
+            ++nKept;
+        }
+    return nKept;
+    }
+
+// check the queue holds exactly the n values in expected, head first.
+void checkContents(const Queue_t &queue, const std::uint32_t *expected, std::size_t n)
+    {
+    CHECK_EQ(queue.size(), n);
+    for (std::size_t i = 0; i < n; ++i)
+        {
+        std::uint32_t const *const pEntry = queue.peek(i);
+
+        CHECK(pEntry != nullptr);
+        if (pEntry != nullptr)
+            CHECK_EQ(*pEntry, expected[i]);
+        }
+    CHECK(queue.peek(n) == nullptr);
+    }
+
+// the oldest entries make room for the new ones.
+void testDropOldest()
+    {
+    Queue_t queue;
+    static const std::uint32_t kExpected[] = { 3, 4, 5, 6 };
+
+    CHECK(queue.getPolicy() == QueueOverflowPolicy::DropOldest);
+    CHECK_EQ(pushCount(queue, 7), unsigned(kCapacity));
+    CHECK(queue.full());
+    CHECK_EQ(queue.getDropCount(), 3u);
+    checkContents(queue, kExpected, kCapacity);
+
+    // popping after a wrap still goes oldest first.
+    std::uint32_t v = 0;
+
+    CHECK(queue.pop(v));
+    CHECK_EQ(v, 3u);
+    CHECK(queue.push(7));
+    CHECK_EQ(queue.getDropCount(), 3u);
+    }
+
+// the new entries are thrown away; the queue keeps what it had.
+void testDropNewest()
+    {
+    Queue_t queue(QueueOverflowPolicy::DropNewest);
+    static const std::uint32_t kExpected[] = { 0, 1, 2, 3 };
+
+    CHECK_EQ(pushCount(queue, 7), unsigned(kCapacity));
+    CHECK_EQ(queue.getDropCount(), 3u);
+    checkContents(queue, kExpected, kCapacity);
+    }
+
+// each new entry overwrites the newest one, so the tail is the latest.
+void testCoalesce()
+    {
+    Queue_t queue(QueueOverflowPolicy::Coalesce);
+    static const std::uint32_t kExpected[] = { 0, 1, 2, 6 };
+
+    CHECK_EQ(pushCount(queue, 7), unsigned(kCapacity));
+    CHECK_EQ(queue.getDropCount(), 3u);
+    checkContents(queue, kExpected, kCapacity);
+    }
+
+// clear() empties the queue and restarts the drop count, under any policy.
+void testClear()
+    {
+    static const QueueOverflowPolicy kPolicies[] =
+        {
+        QueueOverflowPolicy::DropOldest,
+        QueueOverflowPolicy::DropNewest,
+        QueueOverflowPolicy::Coalesce,
+        };
+
+    for (auto policy : kPolicies)
+        {
+        Queue_t queue(policy);
+
+        (void) pushCount(queue, 2 * kCapacity);
+        CHECK_EQ(queue.getDropCount(), std::uint32_t(kCapacity));
+
+        queue.clear();
+        CHECK(queue.empty());
+        CHECK(queue.peek() == nullptr);
+        CHECK_EQ(queue.getDropCount(), 0u);
+        CHECK(queue.getPolicy() == policy);
+
+        // and it fills from scratch again.
+        static const std::uint32_t kExpected[] = { 0, 1 };
+
+        CHECK_EQ(pushCount(queue, 2), 2u);
+        CHECK_EQ(queue.getDropCount(), 0u);
+        checkContents(queue, kExpected, 2);
+        }
+    }
+
+} // namespace
+
+int main()
+    {
+    testDropOldest();
+    testDropNewest();
+    testCoalesce();
+    testClear();
+    return HostTest::report("test_cRingQueue");
+    }
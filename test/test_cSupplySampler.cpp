@@ -0,0 +1,193 @@
+/*
+
+Module: test_cSupplySampler.cpp
+
+Function:
+    Host test of cSupplySampler: how often it reads the ADC, and what
+    its filters make of the readings.
+
+Copyright:
+    See accompanying LICENSE file for copyright and license information.
+
+Author:
+    Dhinesh Kumar Pitchai, MCCI Corporation   October 2026
+
+*/
+
+#include "Catena4610_cSupplySampler.h"
+
+#include "HostTest.h"
+
+#include <cmath>
+
+using namespace McciCatena4610;
+
+HOST_TEST_MAIN;
+
+namespace {
+
+using Channel = cSupplySampler::Channel;
+using Filter = cSupplySampler::Filter;
+
+// what each channel's ADC reads, and how often it's been read.
+float gVolts[cSupplySampler::kChannels];
+unsigned gnReads[cSupplySampler::kChannels];
+
+float readVbat()
+    {
+    ++gnReads[unsigned(Channel::Vbat)];
+    return gVolts[unsigned(Channel::Vbat)];
+    }
+
+float readVbus()
+    {
+    ++gnReads[unsigned(Channel::Vbus)];
+    return gVolts[unsigned(Channel::Vbus)];
+    }
+
+void setup(cSupplySampler &sampler)
+    {
+    for (unsigned i = 0; i < cSupplySampler::kChannels; ++i)
+        {
+        gVolts[i] = 0.0f;
+        gnReads[i] = 0;
+        }
+
+    sampler.setReader(Channel::Vbat, readVbat);
+    sampler.setReader(Channel::Vbus, readVbus);
+    }
+
+bool isNear(float a, float b)
+    {
+    return std::fabs(a - b) < 1e-4f;
+    }
+
+// polling every millisecond reads each channel once per period.
+void testPeriodLimitsReads()
+    {
+    cSupplySampler sampler;
+
+    setup(sampler);
+    sampler.setPeriod(100);
+
+    for (std::uint32_t t = 0; t < 1000; ++t)
+        sampler.poll(t);
+
+    CHECK_EQ(gnReads[unsigned(Channel::Vbat)], 10u);
+    CHECK_EQ(gnReads[unsigned(Channel::Vbus)], 10u);
+    CHECK_EQ(sampler.getReadCount(), 20u);
+    }
+
+// with every channel stale, each poll() reads just one of them.
+void testPollReadsOneChannel()
+    {
+    cSupplySampler sampler;
+
+    setup(sampler);
+    sampler.setPeriod(100);
+
+    sampler.poll(0);
+    CHECK_EQ(sampler.getReadCount(), 1u);
+    sampler.poll(0);
+    CHECK_EQ(sampler.getReadCount(), 2u);
+    CHECK_EQ(gnReads[unsigned(Channel::Vbat)], 1u);
+    CHECK_EQ(gnReads[unsigned(Channel::Vbus)], 1u);
+
+    // nothing's due.
+    sampler.poll(50);
+    CHECK_EQ(sampler.getReadCount(), 2u);
+
+    // both are due again; the stalest goes first.
+    sampler.refresh(Channel::Vbat, 60);
+    sampler.poll(200);
+    CHECK_EQ(gnReads[unsigned(Channel::Vbus)], 2u);
+    CHECK_EQ(sampler.getReadCount(), 4u);
+    sampler.poll(200);
+    CHECK_EQ(gnReads[unsigned(Channel::Vbat)], 3u);
+    CHECK_EQ(sampler.getReadCount(), 5u);
+    }
+
+// get() reads only when the cached value is stale; peek() never does.
+void testGetReadsWhenStale()
+    {
+    cSupplySampler sampler;
+
+    setup(sampler);
+    sampler.setPeriod(100);
+    gVolts[unsigned(Channel::Vbat)] = 3.7f;
+
+    CHECK(isNear(sampler.get(Channel::Vbat, 0), 3.7f));
+    CHECK_EQ(sampler.getReadCount(), 1u);
+
+    gVolts[unsigned(Channel::Vbat)] = 3.5f;
+    CHECK(isNear(sampler.get(Channel::Vbat, 99), 3.7f));
+    CHECK(isNear(sampler.peek(Channel::Vbat), 3.7f));
+    CHECK_EQ(sampler.getReadCount(), 1u);
+
+    CHECK(isNear(sampler.get(Channel::Vbat, 100), 3.5f));
+    CHECK_EQ(sampler.getReadCount(), 2u);
+
+    // invalidate() makes the next get() read, however soon.
+    gVolts[unsigned(Channel::Vbat)] = 3.3f;
+    sampler.invalidate();
+    CHECK(isNear(sampler.get(Channel::Vbat, 101), 3.3f));
+    CHECK_EQ(sampler.getReadCount(), 3u);
+
+    CHECK(isNear(sampler.peek(Channel::Vbus), 0.0f));
+    CHECK_EQ(gnReads[unsigned(Channel::Vbus)], 0u);
+    }
+
+// the EMA starts at the first sample, then moves 1 / 2^shift of the
+// way towards each one.
+void testEma()
+    {
+    cSupplySampler sampler;
+    static const float kIn[] = { 4.0f, 0.0f, 0.0f, 8.0f };
+    static const float kOut[] = { 4.0f, 3.0f, 2.25f, 3.6875f };
+
+    setup(sampler);
+    sampler.setFilter(Filter::Ema, 2);
+
+    for (unsigned i = 0; i < sizeof(kIn) / sizeof(kIn[0]); ++i)
+        {
+        gVolts[unsigned(Channel::Vbat)] = kIn[i];
+        CHECK(isNear(sampler.refresh(Channel::Vbat, i), kOut[i]));
+        }
+
+    // changing the filter restarts it.
+    sampler.setFilter(Filter::Ema, 1);
+    gVolts[unsigned(Channel::Vbat)] = 1.0f;
+    CHECK(isNear(sampler.refresh(Channel::Vbat, 10), 1.0f));
+    gVolts[unsigned(Channel::Vbat)] = 2.0f;
+    CHECK(isNear(sampler.refresh(Channel::Vbat, 11), 1.5f));
+    }
+
+// the median of the last three throws out a single spike; until there
+// are three, it's the latest sample.
+void testMedian3()
+    {
+    cSupplySampler sampler;
+    static const float kIn[] = { 3.0f, 3.2f, 9.0f, 3.1f, 0.0f, 3.3f, 3.4f };
+    static const float kOut[] = { 3.0f, 3.2f, 3.2f, 3.2f, 3.1f, 3.1f, 3.3f };
+
+    setup(sampler);
+    sampler.setFilter(Filter::Median3);
+
+    for (unsigned i = 0; i < sizeof(kIn) / sizeof(kIn[0]); ++i)
+        {
+        gVolts[unsigned(Channel::Vbus)] = kIn[i];
+        CHECK(isNear(sampler.refresh(Channel::Vbus, i), kOut[i]));
+        }
+    }
+
+} // namespace
+
+int main()
+    {
+    testPeriodLimitsReads();
+    testPollReadsOneChannel();
+    testGetReadsWhenStale();
+    testEma();
+    testMedian3();
+    return HostTest::report("test_cSupplySampler");
+    }